@@ -0,0 +1,96 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/codec/SkCodec.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/utils/SkAnimCodecPlayer.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/Resources.h"
+
+#include <memory>
+#include <vector>
+
+// Steps an SkAnimCodecPlayer through an animation one frame per loop, so the reported time is
+// the time per frame (frames/sec is its inverse). The cache is kept smaller than the animation,
+// so frames keep being decoded rather than served from the cache after the first pass.
+//
+//   nanobench --match AnimCodecPlayer_
+class AnimCodecPlayerBench : public Benchmark {
+public:
+    static constexpr int kMaxCachedFrames = 8;
+
+    AnimCodecPlayerBench(const char* file, bool parallel)
+        : fFile(file)
+        , fParallel(parallel) {
+        fName.printf("AnimCodecPlayer_%s_%s", SkOSPath::Basename(file).c_str(),
+                     parallel ? "parallel" : "serial");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        sk_sp<SkData> data = GetResourceAsData(fFile);
+        if (!data) {
+            return;
+        }
+
+        uint32_t time = 0;
+        for (const auto& info : SkCodec::MakeFromData(data)->getFrameInfo()) {
+            fStartTimes.push_back(time);
+            time += info.fDuration;
+        }
+
+        SkAnimCodecPlayer::DecodeOptions options;
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+            options.fExecutor = fExecutor.get();
+            options.fLookahead = kMaxCachedFrames - 1;
+        }
+        options.fMaxCachedFrames = kMaxCachedFrames;
+        fPlayer = std::make_unique<SkAnimCodecPlayer>(std::move(data), options);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fPlayer || fStartTimes.empty()) {
+            return;
+        }
+        for (int i = 0; i < loops; ++i) {
+            fPlayer->seek(fStartTimes[fNextFrame]);
+            fNextFrame = (fNextFrame + 1) % fStartTimes.size();
+            SkAssertResult(fPlayer->getFrame());
+        }
+    }
+
+private:
+    const char*                        fFile;
+    const bool                         fParallel;
+    SkString                           fName;
+    std::vector<uint32_t>              fStartTimes;
+    size_t                             fNextFrame = 0;
+    std::unique_ptr<SkExecutor>        fExecutor;
+    std::unique_ptr<SkAnimCodecPlayer> fPlayer;
+
+    using INHERITED = Benchmark;
+};
+
+#define DEF_ANIM_BENCH(file)                                             \
+    DEF_BENCH( return new AnimCodecPlayerBench("images/" file, false); ) \
+    DEF_BENCH( return new AnimCodecPlayerBench("images/" file, true); )
+
+DEF_ANIM_BENCH("alphabetAnim.gif")
+DEF_ANIM_BENCH("flightAnim.gif")
+DEF_ANIM_BENCH("randPixelsAnim.gif")
+DEF_ANIM_BENCH("required.gif")
+DEF_ANIM_BENCH("test640x479.gif")
+DEF_ANIM_BENCH("required.webp")
+DEF_ANIM_BENCH("stoplight.webp")
@@ -6,6 +6,7 @@
  */
 
 #include "bench/Benchmark.h"
+#include "bench/HSWBench.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkPaint.h"
@@ -142,3 +143,14 @@ BENCH(SkBlendMode::kHue)
 BENCH(SkBlendMode::kSaturation)
 BENCH(SkBlendMode::kColor)
 BENCH(SkBlendMode::kLuminosity)
+
+// Lowp modes (and one highp mode, for contrast) with the hsw stages, next to skx.
+#define HSW_BENCH(mode)                                                  \
+    DEF_BENCH( return new HSWBench(new XfermodeBench(mode, kRect)); )    \
+    DEF_BENCH( return new HSWBench(new XfermodeBench(mode, kSprite)); )
+
+HSW_BENCH(SkBlendMode::kSrcOver)
+HSW_BENCH(SkBlendMode::kSrcIn)
+HSW_BENCH(SkBlendMode::kScreen)
+HSW_BENCH(SkBlendMode::kMultiply)
+HSW_BENCH(SkBlendMode::kHue)
@@ -12,6 +12,7 @@
 #include "include/core/SkString.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkBlurMask.h"
+#include "src/core/SkMaskBlurFilter.h"
 
 #define SMALL   SkIntToScalar(2)
 #define REAL    1.5f
@@ -182,6 +183,50 @@ private:
     using INHERITED = BlurRectSeparableBench;
 };
 
+// Blurs a screen sized mask, the size of a large shadow, directly with SkMaskBlurFilter. Run with
+// --threads to measure the parallel row bands.
+class MaskBlurFilterBench : public Benchmark {
+public:
+    MaskBlurFilterBench(double sigma) : fSigma(sigma) {
+        fName.printf("mask_blur_filter_%g", sigma);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        fSrc.fBounds   = SkIRect::MakeWH(1920, 1080);
+        fSrc.fFormat   = SkMask::kA8_Format;
+        fSrc.fRowBytes = fSrc.fBounds.width();
+        fSrc.fImage    = SkMask::AllocImage(fSrc.computeImageSize());
+
+        SkRandom rand;
+        for (size_t i = 0; i < fSrc.computeImageSize(); ++i) {
+            fSrc.fImage[i] = rand.nextU() & 0xff;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkMaskBlurFilter filter(fSigma, fSigma);
+        for (int i = 0; i < loops; ++i) {
+            SkMask dst;
+            filter.blur(fSrc, &dst);
+            SkMask::FreeImage(dst.fImage);
+        }
+    }
+
+    ~MaskBlurFilterBench() override { SkMask::FreeImage(fSrc.fImage); }
+
+private:
+    double   fSigma;
+    SkString fName;
+    SkMask   fSrc;
+
+    using INHERITED = Benchmark;
+};
+
 DEF_BENCH(return new BlurRectBoxFilterBench(SMALL);)
 DEF_BENCH(return new BlurRectBoxFilterBench(BIG);)
 DEF_BENCH(return new BlurRectBoxFilterBench(REALBIG);)
@@ -201,6 +246,11 @@ DEF_BENCH(return new BlurRectDirectBench(kMedBig);)
 DEF_BENCH(return new BlurRectBoxFilterBench(kMedium);)
 DEF_BENCH(return new BlurRectBoxFilterBench(kMedBig);)
 
+DEF_BENCH(return new MaskBlurFilterBench(2.5);)
+DEF_BENCH(return new MaskBlurFilterBench(10);)
+DEF_BENCH(return new MaskBlurFilterBench(40);)
+DEF_BENCH(return new MaskBlurFilterBench(100);)
+
 #if 0
 // disable Gaussian benchmarks; the algorithm works well enough
 // and serves as a baseline for ground truth, but it's too slow
@@ -9,6 +9,12 @@
 #include "bench/CodecBenchPriv.h"
 #include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkColorPriv.h"
+#include "include/core/SkStream.h"
+#include "include/encode/SkJpegEncoder.h"
+#include "include/encode/SkPngEncoder.h"
+#include "include/encode/SkWebpEncoder.h"
+#include "include/utils/SkRandom.h"
 #include "src/core/SkOSFile.h"
 #include "tools/flags/CommandLineFlags.h"
 
@@ -64,3 +70,95 @@ void CodecBench::onDraw(int n, SkCanvas* canvas) {
                  || result == SkCodec::kIncompleteInput);
     }
 }
+
+// Decode a large synthetic image either all at once or as a series of 16-row strips from
+// SkCodec::decodeStrips(). For PNG and JPEG the strip decode keeps only one strip of pixels
+// alive, which shows up in each bench's peak_rss_mb metric. WebP decodes the whole image either
+// way.
+class CodecStripBench : public Benchmark {
+public:
+    static constexpr int kSize = 2048;
+    static constexpr int kStripHeight = 16;
+
+    CodecStripBench(SkEncodedImageFormat format, bool strips)
+        : fFormat(format)
+        , fStrips(strips) {
+        const char* formatName = format == SkEncodedImageFormat::kPNG  ? "png"  :
+                                 format == SkEncodedImageFormat::kJPEG ? "jpeg" : "webp";
+        fName.printf("Codec_strips_%s_%s", formatName, strips ? "strips" : "full");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        // Smooth gradients with a little noise, so the image compresses like a photo.
+        SkBitmap bm;
+        bm.allocN32Pixels(kSize, kSize, true);
+        SkRandom rand;
+        for (int y = 0; y < kSize; ++y) {
+            uint32_t* row = bm.getAddr32(0, y);
+            for (int x = 0; x < kSize; ++x) {
+                U8CPU noise = rand.nextU() & 0xF;
+                row[x] = SkPackARGB32(0xFF, (x >> 4) + noise, (y >> 4) + noise,
+                                      ((x + y) >> 5) + noise);
+            }
+        }
+
+        SkDynamicMemoryWStream stream;
+        switch (fFormat) {
+            case SkEncodedImageFormat::kPNG:
+                SkAssertResult(SkPngEncoder::Encode(&stream, bm.pixmap(), {}));
+                break;
+            case SkEncodedImageFormat::kJPEG:
+                SkAssertResult(SkJpegEncoder::Encode(&stream, bm.pixmap(), {}));
+                break;
+            default:
+                SkAssertResult(SkWebpEncoder::Encode(&stream, bm.pixmap(), {}));
+                break;
+        }
+        fData = stream.detachAsData();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+
+            // Touch every row, as a tiler or re-encoder would.
+            uint32_t sum = 0;
+            if (fStrips) {
+                codec->decodeStrips(info, kStripHeight, [&sum](const SkPixmap& strip, int) {
+                    for (int y = 0; y < strip.height(); ++y) {
+                        sum += *strip.addr32(strip.width() / 2, y);
+                    }
+                    return true;
+                });
+            } else {
+                SkBitmap bm;
+                bm.allocPixels(info);
+                codec->getPixels(bm.pixmap());
+                for (int y = 0; y < bm.height(); ++y) {
+                    sum += *bm.getAddr32(bm.width() / 2, y);
+                }
+            }
+            fChecksum += sum;
+        }
+    }
+
+private:
+    const SkEncodedImageFormat fFormat;
+    const bool                 fStrips;
+    SkString                   fName;
+    sk_sp<SkData>              fData;
+    uint32_t                   fChecksum = 0;
+};
+
+DEF_BENCH( return new CodecStripBench(SkEncodedImageFormat::kPNG,  false); )
+DEF_BENCH( return new CodecStripBench(SkEncodedImageFormat::kPNG,  true); )
+DEF_BENCH( return new CodecStripBench(SkEncodedImageFormat::kJPEG, false); )
+DEF_BENCH( return new CodecStripBench(SkEncodedImageFormat::kJPEG, true); )
+DEF_BENCH( return new CodecStripBench(SkEncodedImageFormat::kWEBP, false); )
+DEF_BENCH( return new CodecStripBench(SkEncodedImageFormat::kWEBP, true); )
@@ -7,6 +7,9 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
@@ -123,3 +126,56 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
 #undef PNG
+
+// Encodes a 2048x2048 RGBA surface (16 MB of pixels) serially or in parallel bands.  Divide 16 MB
+// by the time per encode for MB/s.
+class EncodePngParallelBench : public Benchmark {
+public:
+    EncodePngParallelBench(bool parallel, int zlibLevel)
+        : fParallel(parallel)
+        , fZLibLevel(zlibLevel)
+        , fName(SkStringPrintf("Encode_PNG_2048_%d_%s", zlibLevel,
+                               parallel ? "parallel" : "serial")) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        sk_sp<SkImage> tile = GetResourceAsImage(srcs[0]);
+        SkASSERT(tile);
+        fBitmap.allocPixels(SkImageInfo::MakeN32Premul(2048, 2048));
+        SkCanvas canvas(fBitmap);
+        for (int y = 0; y < 2048; y += tile->height()) {
+            for (int x = 0; x < 2048; x += tile->width()) {
+                canvas.drawImage(tile, x, y);
+            }
+        }
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPngEncoder::Options opts;
+        opts.fZLibLevel = fZLibLevel;
+        opts.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkNullWStream dst;
+            SkAssertResult(SkPngEncoder::Encode(&dst, fBitmap.pixmap(), opts));
+            SkASSERT(dst.bytesWritten() > 0);
+        }
+    }
+
+private:
+    bool                        fParallel;
+    int                         fZLibLevel;
+    SkString                    fName;
+    SkBitmap                    fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new EncodePngParallelBench(false, 6));
+DEF_BENCH(return new EncodePngParallelBench(true,  6));
+DEF_BENCH(return new EncodePngParallelBench(false, 1));
+DEF_BENCH(return new EncodePngParallelBench(true,  1));
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <atomic>
+
+// Measures how quickly each SkExecutor thread pool can hand out many tiny tasks.
+// Flat benches add every task from the bench thread.  Nested benches add a few tasks that each
+// add more tasks from inside the pool, like SkTaskGroups nested on one executor do.
+class ExecutorBench : public Benchmark {
+public:
+    enum class Pool { kFIFO, kLIFO, kWorkStealing };
+
+    ExecutorBench(Pool pool, int threads, bool nested)
+        : fPool(pool), fThreads(threads), fNested(nested) {
+        static const char* kPoolNames[] = { "fifo", "lifo", "workstealing" };
+        fName.printf("executor_%s_%d_%s", kPoolNames[(int)pool], threads,
+                     nested ? "nested" : "flat");
+        this->setUnits(kTasks);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        switch (fPool) {
+            case Pool::kFIFO: fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);   break;
+            case Pool::kLIFO: fExecutor = SkExecutor::MakeLIFOThreadPool(fThreads);   break;
+            case Pool::kWorkStealing:
+                fExecutor = SkExecutor::MakeWorkStealingPool(fThreads);
+                break;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        std::atomic<int> count{0};
+        auto tick = [&count](int) { count.fetch_add(1, std::memory_order_relaxed); };
+
+        for (int i = 0; i < loops; i++) {
+            SkTaskGroup group(*fExecutor);
+            if (fNested) {
+                group.batch(kTasks / kInnerTasks, [this, &tick](int) {
+                    SkTaskGroup inner(*fExecutor);
+                    inner.batch(kInnerTasks, tick);
+                });
+            } else {
+                group.batch(kTasks, tick);
+            }
+            group.wait();
+        }
+        SkASSERT(count.load() == loops * kTasks);
+    }
+
+private:
+    static constexpr int kTasks      = 10000;
+    static constexpr int kInnerTasks = 100;
+
+    Pool                        fPool;
+    int                         fThreads;
+    bool                        fNested;
+    SkString                    fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    using INHERITED = Benchmark;
+};
+
+#define EXECUTOR_BENCHES(threads)                                                            \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kFIFO,         threads, false);) \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kLIFO,         threads, false);) \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kWorkStealing, threads, false);) \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kFIFO,         threads, true);)  \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kLIFO,         threads, true);)  \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kWorkStealing, threads, true);)
+
+EXECUTOR_BENCHES(4)
+EXECUTOR_BENCHES(16)
+EXECUTOR_BENCHES(64)
@@ -6,6 +6,7 @@
  */
 
 #include "bench/Benchmark.h"
+#include "bench/HSWBench.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkShader.h"
@@ -61,3 +62,9 @@ DEF_BENCH( return new FilteringBench(SkFilterMode::kLinear,  SkMipmapMode::kNone
 DEF_BENCH( return new FilteringBench(SkFilterMode::kNearest, SkMipmapMode::kLinear); )
 DEF_BENCH( return new FilteringBench(SkFilterMode::kNearest, SkMipmapMode::kNearest); )
 DEF_BENCH( return new FilteringBench(SkFilterMode::kNearest, SkMipmapMode::kNone); )
+
+// The hsw stages, next to skx.
+#define HSW_BENCH(fm, mm) DEF_BENCH( return new HSWBench(new FilteringBench(fm, mm)); )
+HSW_BENCH(SkFilterMode::kLinear,  SkMipmapMode::kLinear)
+HSW_BENCH(SkFilterMode::kLinear,  SkMipmapMode::kNone)
+HSW_BENCH(SkFilterMode::kNearest, SkMipmapMode::kNone)
@@ -14,6 +14,9 @@
 #include "include/private/SkChecksum.h"
 #include "include/private/SkTemplates.h"
 
+#include <thread>
+#include <vector>
+
 #include "bench/gUniqueGlyphIDs.h"
 
 #define gUniqueGlyphIDs_Sentinel    0xFFFF
@@ -197,3 +200,59 @@ private:
 };
 DEF_BENCH( return new FontPathBench(true); )
 DEF_BENCH( return new FontPathBench(false); )
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Measure text from several threads at once, each cycling through a few font sizes so the
+// threads keep looking up (mostly different) strikes in the shared strike cache.
+class FontCacheThreadsBench : public Benchmark {
+    const int fThreads;
+    SkString fName;
+
+public:
+    FontCacheThreadsBench(int threads) : fThreads(threads) {
+        fName.printf("fontcache_threads_%d", threads);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        auto work = [loops](int thread) {
+            SkFont font;
+            font.setEdging(SkFont::Edging::kAntiAlias);
+            for (int i = 0; i < loops; ++i) {
+                const uint16_t* array = gUniqueGlyphIDs;
+                for (int size = 0; *array != gUniqueGlyphIDs_Sentinel; ++size) {
+                    int count = count_glyphs(array);
+                    font.setSize(SkIntToScalar(12 + (thread * 4 + size) % 16));
+                    (void)font.measureText(array, count * sizeof(uint16_t),
+                                           SkTextEncoding::kGlyphID);
+                    array += count + 1;    // skip the sentinel
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < fThreads; ++t) {
+            threads.emplace_back(work, t);
+        }
+        work(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new FontCacheThreadsBench(1); )
+DEF_BENCH( return new FontCacheThreadsBench(2); )
+DEF_BENCH( return new FontCacheThreadsBench(4); )
+DEF_BENCH( return new FontCacheThreadsBench(8); )
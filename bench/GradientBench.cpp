@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 #include "bench/Benchmark.h"
+#include "bench/HSWBench.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorPriv.h"
@@ -306,6 +307,12 @@ DEF_BENCH( return new GradientBench(kSweep_GradType, gGradData[3], false); )
 DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[3], true); )
 DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[3], false); )
 
+// The hsw stages, next to skx.
+DEF_BENCH( return new HSWBench(new GradientBench(kLinear_GradType, gGradData[0])); )
+DEF_BENCH( return new HSWBench(new GradientBench(kLinear_GradType, gGradData[1])); )
+DEF_BENCH( return new HSWBench(new GradientBench(kRadial_GradType, gGradData[0])); )
+DEF_BENCH( return new HSWBench(new GradientBench(kSweep_GradType)); )
+
 ///////////////////////////////////////////////////////////////////////////////
 
 class Gradient2Bench : public Benchmark {
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef HSWBench_DEFINED
+#define HSWBench_DEFINED
+
+#include "bench/Benchmark.h"
+#include "src/core/SkCpu.h"
+#include "src/core/SkOpts.h"
+
+// Runs another bench with the hsw specializations installed, so on machines that support skx
+// (32-wide lowp raster pipeline) the two show up side by side.  Named "<bench>_hsw".
+class HSWBench : public Benchmark {
+public:
+    explicit HSWBench(Benchmark* bench) : fBench(bench) {
+        fName.printf("%s_hsw", fBench->getName());
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        // Only CPU drawing runs the specializations, and there's nothing to compare without skx.
+        if (backend != kRaster_Backend || !SkCpu::Supports(SkCpu::SKX)) {
+            return false;
+        }
+        return fBench->isSuitableFor(backend);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    SkIPoint onGetSize() override { return fBench->getSize(); }
+
+    void onDelayedSetup() override { fBench->delayedSetup(); }
+    void onPerCanvasPreDraw(SkCanvas* canvas) override { fBench->perCanvasPreDraw(canvas); }
+    void onPerCanvasPostDraw(SkCanvas* canvas) override {
+        fBench->perCanvasPostDraw(canvas);
+        SkOpts::SetHSWForTesting(false);
+    }
+    void onPreDraw(SkCanvas* canvas) override { fBench->preDraw(canvas); }
+    void onPostDraw(SkCanvas* canvas) override { fBench->postDraw(canvas); }
+
+    // The hsw specializations stay installed until onPerCanvasPostDraw() puts skx back.
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkOpts::SetHSWForTesting(true);
+        fBench->draw(loops, canvas);
+    }
+
+private:
+    sk_sp<Benchmark> fBench;
+    SkString         fName;
+
+    using INHERITED = Benchmark;
+};
+
+#endif
@@ -8,7 +8,12 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkData.h"
 #include "include/core/SkStream.h"
+#include "include/private/SkTo.h"
+#include "include/utils/SkRandom.h"
 #include "src/utils/SkJSON.h"
+#include "tools/Resources.h"
+
+#include <vector>
 
 #if defined(SK_BUILD_FOR_ANDROID)
 static constexpr const char* kBenchFile = "/data/local/tmp/bench.json";
@@ -18,17 +23,24 @@ static constexpr const char* kBenchFile = "/tmp/bench.json";
 
 class JsonBench : public Benchmark {
 public:
+    // Parses |kBenchFile| by default, or the given resource.
+    explicit JsonBench(const char* name = "skjson", const char* resource = nullptr)
+        : fName(SkStringPrintf("json_%s", name))
+        , fResource(resource) {}
 
 protected:
-    const char* onGetName() override { return "json_skjson"; }
+    const char* onGetName() override { return fName.c_str(); }
 
     bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
 
     void onPerCanvasPreDraw(SkCanvas*) override {
-        fData = SkData::MakeFromFileName(kBenchFile);
+        fData = fResource ? GetResourceAsData(fResource) : SkData::MakeFromFileName(kBenchFile);
         if (!fData) {
-            SkDebugf("!! Could not open bench file: %s\n", kBenchFile);
+            SkDebugf("!! Could not open bench file: %s\n", fResource ? fResource : kBenchFile);
+            return;
         }
+        // Report time per input byte: 1000 / (ns per byte) is the parse speed in MB/s.
+        this->setUnits(SkToInt(fData->size()));
     }
 
     void onPerCanvasPostDraw(SkCanvas*) override {
@@ -48,12 +60,99 @@ protected:
     }
 
 private:
-    sk_sp<SkData> fData;
+    const SkString fName;
+    const char*    fResource;
+
+    sk_sp<SkData>  fData;
 
     using INHERITED = Benchmark;
 };
 
 DEF_BENCH( return new JsonBench; )
+DEF_BENCH( return new JsonBench("skottie_large", "skottie/skottie-text-scale-to-fit-minmax.json"); )
+DEF_BENCH( return new JsonBench("skottie_medium", "skottie/skottie-phonehub-onboard.json"); )
+
+// A large Lottie dominated by embedded base64 images, parsed either into a DOM which copies its
+// strings, or in place.  In-place parsing clobbers the input, so every loop parses a fresh copy.
+// The interesting metric is the per-bench peak_rss_mb.
+class JsonImagesBench : public Benchmark {
+public:
+    explicit JsonImagesBench(bool in_place)
+        : fName(SkStringPrintf("json_skottie_images%s", in_place ? "_inplace" : ""))
+        , fInPlace(in_place) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        static constexpr int    kImageCount = 8;
+        static constexpr size_t kImageChars = 1 << 20;
+        static constexpr char   kBase64[]   =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        SkRandom rand;
+        std::vector<char> image(kImageChars);
+        SkDynamicMemoryWStream json;
+        json.writeText(R"({"v":"5.7.4","fr":30,"ip":0,"op":60,"w":512,"h":512,"assets":[)");
+        for (int i = 0; i < kImageCount; ++i) {
+            for (auto& c : image) {
+                c = kBase64[rand.nextULessThan(64)];
+            }
+            json.writeText(SkStringPrintf(R"(%s{"id":"image_%d","w":512,"h":512,"e":1,"u":"",)"
+                                          R"("p":"data:image/png;base64,)", i ? "," : "", i)
+                                   .c_str());
+            json.write(image.data(), image.size());
+            json.writeText(R"("})");
+        }
+        json.writeText(R"(],"layers":[)");
+        for (int i = 0; i < kImageCount; ++i) {
+            json.writeText(SkStringPrintf(R"(%s{"ty":2,"ind":%d,"refId":"image_%d",)"
+                                          R"("ip":0,"op":60,"ks":{"o":{"a":0,"k":100}}})",
+                                          i ? "," : "", i, i)
+                                   .c_str());
+        }
+        json.writeText("]}");
+
+        fData = json.detachAsData();
+        this->setUnits(SkToInt(fData->size()));
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        fData = nullptr;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            auto input = SkData::MakeWithCopy(fData->data(), fData->size());
+            const auto parsed = [](const skjson::DOM& dom) {
+                if (dom.root().is<skjson::NullValue>()) {
+                    SkDebugf("!! Parsing failed.\n");
+                    return false;
+                }
+                return true;
+            };
+
+            if (fInPlace ? !parsed(skjson::DOM(std::move(input)))
+                         : !parsed(skjson::DOM(static_cast<const char*>(input->data()),
+                                               input->size()))) {
+                return;
+            }
+        }
+    }
+
+private:
+    const SkString fName;
+    const bool     fInPlace;
+
+    sk_sp<SkData>  fData;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new JsonImagesBench(false); )
+DEF_BENCH( return new JsonImagesBench(true); )
 
 #if (0)
 
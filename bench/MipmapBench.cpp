@@ -14,15 +14,18 @@ class MipmapBench: public Benchmark {
     SkBitmap fBitmap;
     SkString fName;
     const int fW, fH;
-    bool fHalfFoat;
+    const SkColorType fColorType;
 
 public:
-    MipmapBench(int w, int h, bool halfFloat = false)
-        : fW(w), fH(h), fHalfFoat(halfFloat)
+    MipmapBench(int w, int h, SkColorType ct = kN32_SkColorType)
+        : fW(w), fH(h), fColorType(ct)
     {
         fName.printf("mipmap_build_%dx%d", w, h);
-        if (halfFloat) {
-            fName.append("_f16");
+        switch (ct) {
+            case kRGBA_F16_SkColorType:     fName.append("_f16");     break;
+            case kAlpha_8_SkColorType:      fName.append("_a8");      break;
+            case kRGBA_1010102_SkColorType: fName.append("_1010102"); break;
+            default:                                                  break;
         }
     }
 
@@ -34,8 +37,7 @@ protected:
     const char* onGetName() override { return fName.c_str(); }
 
     void onDelayedSetup() override {
-        SkColorType ct = fHalfFoat ? kRGBA_F16_SkColorType : kN32_SkColorType;
-        SkImageInfo info = SkImageInfo::Make(fW, fH, ct, kPremul_SkAlphaType,
+        SkImageInfo info = SkImageInfo::Make(fW, fH, fColorType, kPremul_SkAlphaType,
                                              SkColorSpace::MakeSRGB());
         fBitmap.allocPixels(info);
         fBitmap.eraseColor(SK_ColorWHITE);  // so we don't read uninitialized memory
@@ -59,8 +61,14 @@ DEF_BENCH( return new MipmapBench(512, 511); )
 DEF_BENCH( return new MipmapBench(511, 512); )
 DEF_BENCH( return new MipmapBench(512, 512); )
 
-DEF_BENCH( return new MipmapBench(512, 512, true); )
-DEF_BENCH( return new MipmapBench(511, 511, true); )
+DEF_BENCH( return new MipmapBench(512, 512, kRGBA_F16_SkColorType); )
+DEF_BENCH( return new MipmapBench(511, 511, kRGBA_F16_SkColorType); )
+
+DEF_BENCH( return new MipmapBench(512, 512, kAlpha_8_SkColorType); )
+DEF_BENCH( return new MipmapBench(511, 511, kAlpha_8_SkColorType); )
+
+DEF_BENCH( return new MipmapBench(512, 512, kRGBA_1010102_SkColorType); )
+DEF_BENCH( return new MipmapBench(511, 511, kRGBA_1010102_SkColorType); )
 
 DEF_BENCH( return new MipmapBench(2048, 2048); )
 DEF_BENCH( return new MipmapBench(2047, 2047); )
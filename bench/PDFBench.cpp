@@ -10,6 +10,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
 #include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkStream.h"
@@ -76,6 +77,7 @@ DEF_BENCH(return new PDFScalarBench("PDFScalar_random", next_any);)
 
 #ifdef SK_SUPPORT_PDF
 
+#include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkPDFBitmap.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 #include "src/pdf/SkPDFShader.h"
@@ -184,6 +186,47 @@ private:
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
+/** Test calling DEFLATE on a multi-megabyte PDF command stream, serially and
+    in 128 KB blocks on a thread pool, at a given compression level. */
+class PDFBigStreamCompressionBench : public Benchmark {
+public:
+    PDFBigStreamCompressionBench(bool parallel, SkPDF::Metadata::CompressionLevel level)
+        : fParallel(parallel), fLevel(level) {
+        fName.printf("PDFCompression_4MB_%s_%d", parallel ? "parallel" : "serial", (int)level);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        sk_sp<SkData> commands = GetResourceAsData("pdf_command_stream.txt");
+        SkDynamicMemoryWStream content;
+        while (commands && content.bytesWritten() < 4 * 1024 * 1024) {
+            content.write(commands->data(), commands->size());
+        }
+        fContent = content.detachAsData();
+        fExecutor = fParallel ? SkExecutor::MakeFIFOThreadPool() : nullptr;
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkASSERT(fContent->size() > 0);
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            SkDeflateWStream deflateWStream(&wStream, (int)fLevel, false, fExecutor.get());
+            deflateWStream.write(fContent->data(), fContent->size());
+            deflateWStream.finalize();
+        }
+    }
+
+private:
+    bool fParallel;
+    SkPDF::Metadata::CompressionLevel fLevel;
+    SkString fName;
+    sk_sp<SkData> fContent;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 struct PDFColorComponentBench : public Benchmark {
     bool isSuitableFor(Backend b) override {
         return b == kNonRendering_Backend;
@@ -302,14 +345,89 @@ struct PDFClipPathBenchmark : public Benchmark {
     }
 };
 
+// Draws a page of a report: a gradient heading, a small translucent chart image, and text.
+void draw_report_page(SkCanvas* canvas, int page) {
+    SkRandom random(page);
+    const SkPoint pts[2] = {{36, 36}, {576, 96}};
+    const SkColor colors[] = {random.nextU() | 0xFF000000, random.nextU() | 0xFF000000};
+    SkPaint heading;
+    heading.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, std::size(colors),
+                                                   SkTileMode::kClamp));
+    canvas->drawRect({36, 36, 576, 96}, heading);
+
+    SkBitmap chart;
+    chart.allocN32Pixels(64, 64);
+    chart.eraseColor(SK_ColorTRANSPARENT);
+    for (int x = 0; x < 64; x += 8) {
+        chart.erase(random.nextU() | 0x80000000, SkIRect{x, (int)random.nextRangeU(0, 56), x + 6, 64});
+    }
+    canvas->drawImage(chart.asImage(), 36, 108);
+
+    SkFont font;
+    SkPaint text;
+    SkString line;
+    for (int y = 200; y < 756; y += 14) {
+        line.printf("Page %d, line %d: %08x %08x %08x", page, y, random.nextU(), random.nextU(),
+                    random.nextU());
+        canvas->drawString(line, 36, (float)y, font, text);
+    }
+}
+
+// Measures how quickly pages of a multi-page document are finished and written, serially or on
+// an executor.  Divide the page count by the time per loop for pages/sec.
+class PDFReportBench : public Benchmark {
+public:
+    PDFReportBench(int pages, bool parallel) : fPages(pages), fParallel(parallel) {
+        fName.printf("PDFReport_%dpages_%s", pages, parallel ? "parallel" : "serial");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        fExecutor = fParallel ? SkExecutor::MakeFIFOThreadPool() : nullptr;
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            SkPDF::Metadata metadata;
+            metadata.fExecutor = fExecutor.get();
+            auto doc = SkPDF::MakeDocument(&wStream, metadata);
+            for (int page = 0; page < fPages; ++page) {
+                draw_report_page(doc->beginPage(612, 792), page);
+                doc->endPage();
+            }
+            doc->close();
+        }
+    }
+
+private:
+    int fPages;
+    bool fParallel;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
 DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFBigStreamCompressionBench(false,
+                                                  SkPDF::Metadata::CompressionLevel::Default);)
+DEF_BENCH(return new PDFBigStreamCompressionBench(true,
+                                                  SkPDF::Metadata::CompressionLevel::Default);)
+DEF_BENCH(return new PDFBigStreamCompressionBench(false,
+                                                  SkPDF::Metadata::CompressionLevel::LowButFast);)
+DEF_BENCH(return new PDFBigStreamCompressionBench(true,
+                                                  SkPDF::Metadata::CompressionLevel::LowButFast);)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
 DEF_BENCH(return new PDFClipPathBenchmark;)
+DEF_BENCH(return new PDFReportBench(100, false);)
+DEF_BENCH(return new PDFReportBench(100, true);)
 
 #ifdef SK_PDF_ENABLE_SLOW_TESTS
 #include "include/core/SkExecutor.h"
@@ -383,7 +501,7 @@ void big_pdf_test(SkDocument* doc, const SkBitmap& background) {
                 y = 36 + font.getSpacing();
                 canvas = doc->beginPage(612, 792);
                 background.notifyPixelsChanged();
-                canvas->drawBitmap(background, 0, 0);
+                canvas->drawImage(background.asImage(), 0, 0);
             }
             canvas->drawString(kText[line], x, y, font, paint);
         }
@@ -401,9 +519,8 @@ SkBitmap make_background() {
     tmp.drawRect({0,0,16,16}, gray);
     tmp.drawRect({16,16,32,32}, gray);
     SkPaint shader;
-    shader.setShader(
-            SkShader::MakeBitmapShader(
-                bitmap, SkShader::kRepeat_TileMode, SkShader::kRepeat_TileMode));
+    shader.setShader(bitmap.makeShader(SkTileMode::kRepeat, SkTileMode::kRepeat,
+                                       SkSamplingOptions()));
     background.allocN32Pixels(612, 792);
     SkCanvas tmp2(background);
     tmp2.drawPaint(shader);
@@ -439,9 +556,44 @@ struct PDFBigDocBench : public Benchmark {
         }
     }
 };
+
+// Writes a long document with its pages held until close, or streamed as they end.  Peak memory
+// is what this is for: run each alone with --loops 1, and nanobench reports the process's peak RSS.
+class PDFStreamPagesBench : public Benchmark {
+public:
+    PDFStreamPagesBench(int pages, bool stream) : fPages(pages), fStream(stream) {
+        fName.printf("PDFStreamPages_%dpages_%s", pages, stream ? "streamed" : "held");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            SkPDF::Metadata metadata;
+            metadata.fStreamPages = fStream;
+            auto doc = SkPDF::MakeDocument(&wStream, metadata);
+            for (int page = 0; page < fPages; ++page) {
+                draw_report_page(doc->beginPage(612, 792), page);
+                doc->endPage();
+            }
+            doc->close();
+        }
+    }
+
+private:
+    int fPages;
+    bool fStream;
+    SkString fName;
+};
 }  // namespace
 DEF_BENCH(return new PDFBigDocBench(false);)
 DEF_BENCH(return new PDFBigDocBench(true);)
+DEF_BENCH(return new PDFStreamPagesBench(10000, false);)
+DEF_BENCH(return new PDFStreamPagesBench(10000, true);)
 #endif
 
 #endif // SK_SUPPORT_PDF
@@ -6,6 +6,7 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
@@ -94,6 +95,139 @@ static SkPath makerects() {
 }
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
 
+// Scatters many small, overlapping polygons, like the features of a map.
+static SkPath make_random_polygons(int count) {
+    SkRandom rand;
+    SkPath path;
+    for (int i = 0; i < count; ++i) {
+        SkScalar x = rand.nextUScalar1() * 1000;
+        SkScalar y = rand.nextUScalar1() * 1000;
+        path.moveTo(x, y);
+        for (int j = 0; j < 8; ++j) {
+            path.lineTo(x + rand.nextRangeScalar(-20, 20), y + rand.nextRangeScalar(-20, 20));
+        }
+        path.close();
+    }
+    return path;
+}
+
+// Lays out rows of glyph-like outlines, each touching its neighbors.
+static SkPath make_glyph_row(SkScalar x, SkScalar y) {
+    SkPath path;
+    for (int i = 0; i < 50; ++i, x += 10) {
+        path.moveTo(x, y + 3);
+        path.cubicTo(x, y, x + 10, y, x + 10, y + 3);
+        path.lineTo(x + 10, y + 12);
+        path.quadTo(x + 5, y + 14, x, y + 12);
+        path.close();
+        path.addCircle(x + 5, y + 6, 2, SkPathDirection::kCCW);
+    }
+    return path;
+}
+
+static SkPath make_glyphs() {
+    SkPath path;
+    for (int row = 0; row < 40; ++row) {
+        path.addPath(make_glyph_row(0, row * 16));
+    }
+    return path;
+}
+
+// Approximates a coastline: a circle with thousands of jittered vertices.
+static SkPath make_coastline(SkScalar cx, SkScalar cy, int count) {
+    SkRandom rand;
+    SkPath path;
+    for (int i = 0; i < count; ++i) {
+        SkScalar angle = SK_ScalarPI * 2 * i / count;
+        SkScalar radius = 300 + rand.nextRangeScalar(-5, 5);
+        SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+        if (i) {
+            path.lineTo(pt);
+        } else {
+            path.moveTo(pt);
+        }
+    }
+    path.close();
+    return path;
+}
+
+class PathOpsLargeBench : public Benchmark {
+    SkString    fName;
+    SkPath      fPath1, fPath2;
+
+public:
+    PathOpsLargeBench(const char suffix[], const SkPath& path1, const SkPath& path2)
+            : fPath1(path1), fPath2(path2) {
+        fName.printf("pathops_large_%s", suffix);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkPath result;
+            if (fPath2.isEmpty()) {
+                Simplify(fPath1, &result);
+            } else {
+                Op(fPath1, fPath2, kUnion_SkPathOp, &result);
+            }
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new PathOpsLargeBench("polygons", make_random_polygons(2000), SkPath()); )
+DEF_BENCH( return new PathOpsLargeBench("glyphs", make_glyphs(), SkPath()); )
+DEF_BENCH( return new PathOpsLargeBench("coastline", make_coastline(500, 500, 4000),
+                                        make_coastline(600, 550, 4000)); )
+
+// Unions each row of glyphs, optionally resolving the rows in parallel.
+class PathOpsBuilderBench : public Benchmark {
+    SkString                    fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+public:
+    explicit PathOpsBuilderBench(bool parallel) {
+        fName.printf("pathops_builder_glyphs%s", parallel ? "_parallel" : "");
+        if (parallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            for (int row = 0; row < 40; ++row) {
+                builder.add(make_glyph_row(0, row * 16), kUnion_SkPathOp);
+            }
+            SkPath result;
+            builder.resolve(&result, fExecutor.get());
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new PathOpsBuilderBench(false); )
+DEF_BENCH( return new PathOpsBuilderBench(true); )
+
 #include "include/core/SkPathBuilder.h"
 
 template <size_t N> struct ArrayPath {
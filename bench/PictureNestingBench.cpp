@@ -8,6 +8,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkData.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
@@ -162,6 +163,47 @@ private:
     using INHERITED = PictureNesting;
 };
 
+// Loads a serialized picture and draws the top-left corner of it, as a viewer opening a document
+// would.  When shared, nested pictures outside that corner are never deserialized.
+class PictureNestingFirstFrame : public PictureNesting {
+public:
+    PictureNestingFirstFrame(int maxLevel, int maxPictureLevel, bool shared)
+        : INHERITED(shared ? "first_frame_shared" : "first_frame_copied",
+                    maxLevel, maxPictureLevel)
+        , fShared(shared) {
+    }
+protected:
+    void onDelayedSetup() override {
+        this->INHERITED::onDelayedSetup();
+
+        SkIPoint canvasSize = onGetSize();
+        SkPictureRecorder recorder;
+        SkCanvas* c = recorder.beginRecording(SkIntToScalar(canvasSize.x()),
+                                              SkIntToScalar(canvasSize.y()));
+
+        this->doDraw(c);
+        fData = recorder.finishRecordingAsPicture()->serialize();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkIPoint canvasSize = onGetSize();
+        for (int i = 0; i < loops; i++) {
+            sk_sp<SkPicture> picture = fShared ? SkPicture::MakeFromSharedData(fData)
+                                               : SkPicture::MakeFromData(fData.get());
+            canvas->save();
+            canvas->clipRect(SkRect::MakeWH(canvasSize.x() / 8.0f, canvasSize.y() / 8.0f));
+            canvas->drawPicture(picture);
+            canvas->restore();
+        }
+    }
+
+private:
+    sk_sp<SkData> fData;
+    bool          fShared;
+
+    using INHERITED = PictureNesting;
+};
+
 DEF_BENCH( return new PictureNestingRecording(8, 0); )
 DEF_BENCH( return new PictureNestingRecording(8, 1); )
 DEF_BENCH( return new PictureNestingRecording(8, 2); )
@@ -181,3 +223,8 @@ DEF_BENCH( return new PictureNestingPlayback(8, 5); )
 DEF_BENCH( return new PictureNestingPlayback(8, 6); )
 DEF_BENCH( return new PictureNestingPlayback(8, 7); )
 DEF_BENCH( return new PictureNestingPlayback(8, 8); )
+
+DEF_BENCH( return new PictureNestingFirstFrame(8, 4, false); )
+DEF_BENCH( return new PictureNestingFirstFrame(8, 4, true); )
+DEF_BENCH( return new PictureNestingFirstFrame(8, 8, false); )
+DEF_BENCH( return new PictureNestingFirstFrame(8, 8, true); )
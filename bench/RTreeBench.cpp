@@ -23,8 +23,12 @@ typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
 // Time how long it takes to build an R-Tree.
 class RTreeBuildBench : public Benchmark {
 public:
-    RTreeBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
+    RTreeBuildBench(const char* name, MakeRectProc proc, int numRects = NUM_BUILD_RECTS)
+            : fProc(proc), fNumRects(numRects) {
         fName.printf("rtree_%s_build", name);
+        if (numRects != NUM_BUILD_RECTS) {
+            fName.appendf("_%d", numRects);
+        }
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -37,19 +41,20 @@ protected:
     }
     void onDraw(int loops, SkCanvas* canvas) override {
         SkRandom rand;
-        SkAutoTMalloc<SkRect> rects(NUM_BUILD_RECTS);
-        for (int i = 0; i < NUM_BUILD_RECTS; ++i) {
-            rects[i] = fProc(rand, i, NUM_BUILD_RECTS);
+        SkAutoTMalloc<SkRect> rects(fNumRects);
+        for (int i = 0; i < fNumRects; ++i) {
+            rects[i] = fProc(rand, i, fNumRects);
         }
 
         for (int i = 0; i < loops; ++i) {
             SkRTree tree;
-            tree.insert(rects.get(), NUM_BUILD_RECTS);
+            tree.insert(rects.get(), fNumRects);
             SkASSERT(rects != nullptr);  // It'd break this bench if the tree took ownership of rects.
         }
     }
 private:
     MakeRectProc fProc;
+    int fNumRects;
     SkString fName;
     using INHERITED = Benchmark;
 };
@@ -57,8 +62,12 @@ private:
 // Time how long it takes to perform queries on an R-Tree.
 class RTreeQueryBench : public Benchmark {
 public:
-    RTreeQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
+    RTreeQueryBench(const char* name, MakeRectProc proc, int numRects = NUM_QUERY_RECTS)
+            : fProc(proc), fNumRects(numRects) {
         fName.printf("rtree_%s_query", name);
+        if (numRects != NUM_QUERY_RECTS) {
+            fName.appendf("_%d", numRects);
+        }
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -70,11 +79,11 @@ protected:
     }
     void onDelayedSetup() override {
         SkRandom rand;
-        SkAutoTMalloc<SkRect> rects(NUM_QUERY_RECTS);
-        for (int i = 0; i < NUM_QUERY_RECTS; ++i) {
-            rects[i] = fProc(rand, i, NUM_QUERY_RECTS);
+        SkAutoTMalloc<SkRect> rects(fNumRects);
+        for (int i = 0; i < fNumRects; ++i) {
+            rects[i] = fProc(rand, i, fNumRects);
         }
-        fTree.insert(rects.get(), NUM_QUERY_RECTS);
+        fTree.insert(rects.get(), fNumRects);
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -92,6 +101,7 @@ protected:
 private:
     SkRTree fTree;
     MakeRectProc fProc;
+    int fNumRects;
     SkString fName;
     using INHERITED = Benchmark;
 };
@@ -126,6 +136,18 @@ static inline SkRect make_concentric_rects(SkRandom&, int index, int numRects) {
     return SkRect::MakeWH(SkIntToScalar(index+1), SkIntToScalar(index+1));
 }
 
+// Small rects laid down in rows, in paint order, like a page of text.
+static inline SkRect make_page_rects(SkRandom& rand, int index, int numRects) {
+    const int perRow = 100;
+    const float rows = SkIntToScalar(numRects / perRow + 1);
+    SkRect out;
+    out.fLeft   = SkIntToScalar(index % perRow) * (GENERATE_EXTENTS / perRow);
+    out.fTop    = SkIntToScalar(index / perRow) * (GENERATE_EXTENTS / rows);
+    out.fRight  = out.fLeft + 1 + rand.nextRangeF(0, GENERATE_EXTENTS / perRow);
+    out.fBottom = out.fTop  + 1 + rand.nextRangeF(0, GENERATE_EXTENTS / rows);
+    return out;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new RTreeBuildBench("XY", &make_XYordered_rects));
@@ -137,3 +159,17 @@ DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeBuildBench("page", &make_page_rects,    10000));
+DEF_BENCH(return new RTreeBuildBench("page", &make_page_rects,   100000));
+DEF_BENCH(return new RTreeBuildBench("page", &make_page_rects,  1000000));
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects,   10000));
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects,  100000));
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects, 1000000));
+
+DEF_BENCH(return new RTreeQueryBench("page", &make_page_rects,    10000));
+DEF_BENCH(return new RTreeQueryBench("page", &make_page_rects,   100000));
+DEF_BENCH(return new RTreeQueryBench("page", &make_page_rects,  1000000));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects,   10000));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects,  100000));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects, 1000000));
@@ -8,6 +8,14 @@
 #include "bench/ResultsWriter.h"
 #include "bench/SkSLBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "include/private/SkMutex.h"
+#include "src/core/SkOSFile.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/mock/GrMockCaps.h"
@@ -16,7 +24,10 @@
 #include "src/sksl/SkSLParser.h"
 #include "src/sksl/codegen/SkSLVMCodeGenerator.h"
 #include "src/sksl/ir/SkSLProgram.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/Resources.h"
 
+#include <map>
 #include <regex>
 
 #include "src/sksl/generated/sksl_shared.minified.sksl"
@@ -571,8 +582,11 @@ void RunSkSLModuleBenchmarks(NanoJSONResultsWriter* log) {
 
 class SkSLModuleLoaderBench : public Benchmark {
 public:
-    SkSLModuleLoaderBench(const char* name, std::vector<SkSL::ProgramKind> moduleList)
-            : fName(name), fModuleList(std::move(moduleList)) {}
+    // With a nonzero thread count, each module is requested from its own task, as a multithreaded
+    // client would; modules that don't depend on each other then load concurrently.
+    SkSLModuleLoaderBench(const char* name, std::vector<SkSL::ProgramKind> moduleList,
+                          int threads = 0)
+            : fName(name), fModuleList(std::move(moduleList)), fThreads(threads) {}
 
     const char* onGetName() override {
         return fName;
@@ -586,12 +600,30 @@ public:
         return 1;
     }
 
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
     void onPreDraw(SkCanvas*) override {
         SkSL::ModuleLoader::Get().unloadModules();
     }
 
     void onDraw(int loops, SkCanvas*) override {
         SkASSERT(loops == 1);
+        if (fExecutor) {
+            SkTaskGroup group(*fExecutor);
+            for (SkSL::ProgramKind kind : fModuleList) {
+                group.add([kind] {
+                    GrShaderCaps caps;
+                    SkSL::Compiler compiler(&caps);
+                    compiler.moduleForProgramKind(kind);
+                });
+            }
+            group.wait();
+            return;
+        }
         GrShaderCaps caps;
         SkSL::Compiler compiler(&caps);
         for (SkSL::ProgramKind kind : fModuleList) {
@@ -601,6 +633,8 @@ public:
 
     const char* fName;
     std::vector<SkSL::ProgramKind> fModuleList;
+    int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
 };
 
 DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh",
@@ -616,6 +650,16 @@ DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh",
                                                    SkSL::ProgramKind::kCompute,
                                            });)
 
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh_threaded",
+                                           {
+                                                   SkSL::ProgramKind::kVertex,
+                                                   SkSL::ProgramKind::kFragment,
+                                                   SkSL::ProgramKind::kRuntimeShader,
+                                                   SkSL::ProgramKind::kPrivateRuntimeShader,
+                                                   SkSL::ProgramKind::kCompute,
+                                           },
+                                           /*threads=*/4);)
+
 DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite",
                                            {
                                                    SkSL::ProgramKind::kVertex,
@@ -630,3 +674,88 @@ DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite",
                                                    SkSL::ProgramKind::kGraphiteVertex,
                                                    SkSL::ProgramKind::kGraphiteFragment,
                                            });)
+
+// Creates, and draws once with, every runtime shader in resources/sksl/runtime, like a process that
+// has just started. With a warm PersistentCache, the effects load their SkVM code instead of
+// generating it.
+class SkSLRuntimeEffectStartupBench : public Benchmark {
+public:
+    explicit SkSLRuntimeEffectStartupBench(bool persistentCache)
+            : fUseCache(persistentCache) {}
+
+    const char* onGetName() override {
+        return fUseCache ? "sksl_rt_startup_persistent_cache" : "sksl_rt_startup";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkString dir = GetResourcePath("sksl/runtime");
+        SkOSFile::Iter iter(dir.c_str(), ".rts");
+        for (SkString name; iter.next(&name);) {
+            if (sk_sp<SkData> data = SkData::MakeFromFileName(
+                        SkOSPath::Join(dir.c_str(), name.c_str()).c_str())) {
+                fSources.emplace_back((const char*)data->data(), data->size());
+            }
+        }
+        fSurface = SkSurface::MakeRasterN32Premul(16, 16);
+
+        if (fUseCache) {
+            SkRuntimeEffect::SetPersistentCache(&fCache);
+            this->drawAll();
+            SkRuntimeEffect::SetPersistentCache(nullptr);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkRuntimeEffect::SetPersistentCache(fUseCache ? &fCache : nullptr);
+        for (int i = 0; i < loops; i++) {
+            this->drawAll();
+        }
+        SkRuntimeEffect::SetPersistentCache(nullptr);
+    }
+
+private:
+    class MemoryCache : public SkRuntimeEffect::PersistentCache {
+    public:
+        sk_sp<SkData> load(const SkData& key) override {
+            SkAutoMutexExclusive lock(fMutex);
+            auto iter = fEntries.find(std::string((const char*)key.data(), key.size()));
+            return iter == fEntries.end() ? nullptr : iter->second;
+        }
+        void store(const SkData& key, const SkData& data) override {
+            SkAutoMutexExclusive lock(fMutex);
+            fEntries[std::string((const char*)key.data(), key.size())] =
+                    SkData::MakeWithCopy(data.data(), data.size());
+        }
+
+    private:
+        SkMutex fMutex;
+        std::map<std::string, sk_sp<SkData>> fEntries;
+    };
+
+    void drawAll() {
+        for (const std::string& source : fSources) {
+            // Some of these effects need more than the default options allow; skip those.
+            auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(source));
+            if (!effect) {
+                continue;
+            }
+            std::vector<SkRuntimeEffect::ChildPtr> children(effect->children().size());
+            SkPaint paint;
+            paint.setShader(effect->makeShader(SkData::MakeZeroInitialized(effect->uniformSize()),
+                                               SkSpan(children)));
+            fSurface->getCanvas()->drawPaint(paint);
+        }
+    }
+
+    const bool               fUseCache;
+    std::vector<std::string> fSources;
+    sk_sp<SkSurface>         fSurface;
+    MemoryCache              fCache;
+};
+
+DEF_BENCH(return new SkSLRuntimeEffectStartupBench(/*persistentCache=*/false);)
+DEF_BENCH(return new SkSLRuntimeEffectStartupBench(/*persistentCache=*/true);)
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkString.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/private/SkTArray.h"
+#include "include/utils/SkRandom.h"
+#include "include/utils/SkTiledRasterizer.h"
+
+// Rasterizes a large scene of antialiased paths and gradients, either serially or through an
+// SkTiledRasterizer on a pool of N threads, to show how raster drawing scales with threads.
+class TiledRasterBench : public Benchmark {
+public:
+    // threads == 0 draws directly into the bitmap on the calling thread.
+    explicit TiledRasterBench(int threads) : fThreads(threads) {
+        if (threads) {
+            fName.printf("tiled_raster_%d_threads", threads);
+        } else {
+            fName.set("tiled_raster_serial");
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fBitmap.allocN32Pixels(kSize, kSize);
+        if (fThreads) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+
+        SkRandom rand;
+        for (int i = 0; i < kPaths; i++) {
+            SkPath path;
+            SkPoint center = {rand.nextRangeF(0, kSize), rand.nextRangeF(0, kSize)};
+            path.moveTo(center);
+            for (int j = 0; j < 4; j++) {
+                path.cubicTo(center + SkPoint{rand.nextSScalar1() * 100, rand.nextSScalar1() * 100},
+                             center + SkPoint{rand.nextSScalar1() * 100, rand.nextSScalar1() * 100},
+                             center + SkPoint{rand.nextSScalar1() * 100, rand.nextSScalar1() * 100});
+            }
+            fPaths.push_back(path);
+            fColors.push_back(rand.nextU() | 0x80000000);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            if (fThreads) {
+                SkTiledRasterizer tiled(fBitmap.pixmap(), *fExecutor);
+                this->drawScene(tiled.beginRecording());
+                tiled.flush();
+            } else {
+                SkCanvas canvas(fBitmap);
+                this->drawScene(&canvas);
+            }
+        }
+    }
+
+private:
+    void drawScene(SkCanvas* canvas) const {
+        SkPoint pts[] = {{0, 0}, {kSize, kSize}};
+        SkColor colors[] = {SK_ColorWHITE, SK_ColorGRAY};
+        SkPaint bg;
+        bg.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+        canvas->drawPaint(bg);
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < fPaths.size(); i++) {
+            paint.setColor(fColors[i]);
+            canvas->drawPath(fPaths[i], paint);
+        }
+    }
+
+    static constexpr int kSize  = 1024;
+    static constexpr int kPaths = 500;
+
+    int                         fThreads;
+    SkString                    fName;
+    SkBitmap                    fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkTArray<SkPath>            fPaths;
+    SkTArray<SkColor>           fColors;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new TiledRasterBench(0);)
+DEF_BENCH(return new TiledRasterBench(1);)
+DEF_BENCH(return new TiledRasterBench(2);)
+DEF_BENCH(return new TiledRasterBench(4);)
+DEF_BENCH(return new TiledRasterBench(8);)
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkString.h"
+#include "include/effects/SkGradientShader.h"
+
+extern bool gUseSkVMBlitter;
+
+// Blits a few common paints through either SkVMBlitter or SkRasterPipelineBlitter. Each draw
+// makes a new blitter, so with SkVM this includes finding the program in its cache.
+// (SkVM_BlitterProgramCache covers the cache's hits and misses.)
+class VMBlitterBench : public Benchmark {
+public:
+    enum class Paint { kSrcOver, kGradient, kBilerp };
+
+    VMBlitterBench(Paint paint, bool skvm) : fPaintType(paint), fSkVM(skvm) {
+        static const char* kNames[] = {"srcover_rgba_8888", "gradient", "bilerp"};
+        fName.printf("vm_blitter_%s_%s", kNames[(int)paint], skvm ? "skvm" : "skrp");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fBitmap.allocPixels(SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType,
+                                              kPremul_SkAlphaType));
+        switch (fPaintType) {
+            case Paint::kSrcOver:
+                fPaint.setColor(0x80336699);
+                break;
+            case Paint::kGradient: {
+                SkPoint pts[] = {{0, 0}, {kSize, kSize}};
+                SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+                fPaint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 3,
+                                                              SkTileMode::kClamp));
+                break;
+            }
+            case Paint::kBilerp: {
+                SkBitmap src;
+                src.allocN32Pixels(64, 64);
+                src.eraseColor(SK_ColorYELLOW);
+                src.erase(SK_ColorCYAN, SkIRect::MakeXYWH(0, 0, 32, 32));
+                fPaint.setShader(src.asImage()->makeShader(
+                        SkTileMode::kRepeat, SkTileMode::kMirror,
+                        SkSamplingOptions(SkFilterMode::kLinear),
+                        SkMatrix::Scale(1.7f, 1.3f)));
+                break;
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const bool prev = gUseSkVMBlitter;
+        gUseSkVMBlitter = fSkVM;
+
+        SkCanvas canvas(fBitmap);
+        SkRect r = SkRect::MakeXYWH(0.5f, 0.5f, kSize - 1, kSize - 1);
+        SkPaint aa = fPaint;
+        aa.setAntiAlias(true);
+        for (int i = 0; i < loops; i++) {
+            // A non-AA rect blits full coverage; AA edges add partial coverage.
+            canvas.drawRect(r, fPaint);
+            canvas.drawRect(r, aa);
+        }
+
+        gUseSkVMBlitter = prev;
+    }
+
+private:
+    static constexpr int kSize = 256;
+
+    Paint    fPaintType;
+    bool     fSkVM;
+    SkString fName;
+    SkBitmap fBitmap;
+    SkPaint  fPaint;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new VMBlitterBench(VMBlitterBench::Paint::kSrcOver,  true);)
+DEF_BENCH(return new VMBlitterBench(VMBlitterBench::Paint::kSrcOver,  false);)
+DEF_BENCH(return new VMBlitterBench(VMBlitterBench::Paint::kGradient, true);)
+DEF_BENCH(return new VMBlitterBench(VMBlitterBench::Paint::kGradient, false);)
+DEF_BENCH(return new VMBlitterBench(VMBlitterBench::Paint::kBilerp,   true);)
+DEF_BENCH(return new VMBlitterBench(VMBlitterBench::Paint::kBilerp,   false);)
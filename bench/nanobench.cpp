@@ -1475,6 +1475,9 @@ int main(int argc, char** argv) {
             TRACE_EVENT2("skia", "Benchmark", "name", TRACE_STR_COPY(bench->getUniqueName()),
                                               "config", TRACE_STR_COPY(config));
 
+            // The peak RSS is reported per bench, setup included.
+            const bool trackPeakRSS = sk_tools::resetPeakResidentSetSize();
+
             target->setup();
             bench->perCanvasPreDraw(canvas);
 
@@ -1514,6 +1517,9 @@ int main(int argc, char** argv) {
                 }
             }
 
+            const int64_t peakRSSBytes = trackPeakRSS ? sk_tools::getPeakResidentSetSizeBytes()
+                                                      : -1;
+
             // Scale each result to the benchmark's own units, time/unit.
             for (double& sample : samples) {
                 sample *= (1.0 / bench->getUnits());
@@ -1564,6 +1570,9 @@ int main(int argc, char** argv) {
                 log.appendDoubleDigits(sample, 16);
             }
             log.endArray(); // samples
+            if (peakRSSBytes >= 0) {
+                log.appendMetric("peak_rss_mb", peakRSSBytes / (1024.0 * 1024.0));
+            }
             benchStream.fillCurrentMetrics(log);
             if (!keys.empty()) {
                 // dump to json, only SKPBench currently returns valid keys / values
@@ -21,6 +21,7 @@
 #include "modules/skcms/skcms.h"
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <tuple>
 #include <vector>
@@ -602,6 +603,42 @@ public:
      */
     int outputScanline(int inputScanline) const;
 
+    /**
+     *  Called by decodeStrips() with each horizontal strip of the image, in top-to-bottom
+     *  order. top is the y-coordinate of the strip's first row in the full image. The
+     *  strip's pixels are only valid until the proc returns.
+     *
+     *  Return false to stop decoding early.
+     */
+    using StripProc = std::function<bool(const SkPixmap& strip, int top)>;
+
+    /**
+     *  Decode the image as a series of horizontal strips of stripHeight rows (the last
+     *  strip may be shorter), handing each one to proc.
+     *
+     *  When the codec supports top-down scanline decoding (e.g. JPEG, top-down BMP), or
+     *  decodes strips itself (non-interlaced PNG), every strip is decoded into the same buffer,
+     *  so the pixel memory needed is a single strip no matter how tall the image is. A
+     *  progressive JPEG still makes libjpeg hold the whole image's coefficients while
+     *  decoding. Other codecs (e.g. interlaced PNG, GIF, WebP) decode the whole image into a
+     *  temporary and then hand it to proc one strip at a time. So does a scanline decode that
+     *  stops short, to find out why.
+     *
+     *  This may require a rewind, and ends any scanline or incremental decode in progress.
+     *
+     *  @param dstInfo Info of each strip's rows. If the dimensions do not match those of
+     *      getInfo, this implies a scale.
+     *  @param stripHeight Number of rows per strip. Must be positive.
+     *  @param options fSubset must be null.
+     *  @return kSuccess if every strip was handed to proc (or proc stopped the decode).
+     *      kIncompleteInput or kErrorInInput if the data ran out or was corrupt part way
+     *      through, the same as getPixels() would return; the remaining rows are filled as
+     *      in getPixels() and all strips are still handed to proc. Otherwise, the reason no
+     *      strips could be decoded.
+     */
+    Result decodeStrips(const SkImageInfo& dstInfo, int stripHeight, const StripProc& proc,
+                        const Options* options = nullptr);
+
     /**
      *  Return the number of frames in the image.
      *
@@ -963,6 +1000,21 @@ private:
         return kUnimplemented;
     }
 
+    /**
+     *  Decode the whole image for decodeStrips(), one strip at a time into strip (stripHeight
+     *  rows of dstInfo), handing each strip to proc. Called after the same set up as
+     *  onGetPixels().
+     *
+     *  @param rowsDecoded On kIncompleteInput or kErrorInInput, set to the number of rows
+     *      decoded. Those of them not handed to proc yet are at the top of strip.
+     *  @return kSuccess once every strip was handed to proc, or proc returned false.
+     *      kUnimplemented to let decodeStrips() decode the image some other way.
+     */
+    virtual Result onDecodeStrips(const SkImageInfo& /*dstInfo*/, const SkPixmap& /*strip*/,
+                                  const StripProc&, const Options&, int* /*rowsDecoded*/) {
+        return kUnimplemented;
+    }
+
 
     virtual bool onSkipScanlines(int /*countLines*/) { return false; }
 
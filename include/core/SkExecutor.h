@@ -22,6 +22,14 @@ public:
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0,
                                                           bool allowBorrowing = true);
 
+    // Create a thread pool SkExecutor where each thread keeps its own list of work.
+    // Work added from a pool thread stays on that thread's list; work added from elsewhere is
+    // spread across the threads.  Idle threads steal half of a busy thread's list.
+    // If pinThreads is true, each thread is (where supported) bound to a single core.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingPool(int threads = 0,
+                                                            bool allowBorrowing = true,
+                                                            bool pinThreads = false);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
@@ -82,6 +82,24 @@ public:
     static sk_sp<SkPicture> MakeFromData(const void* data, size_t size,
                                          const SkDeserialProcs* procs = nullptr);
 
+    /** Like MakeFromData(), but the returned SkPicture may reference data in place rather than
+        copy from it: its op stream (when suitably aligned) and the encoded data of its images,
+        which are then decoded lazily. data is kept alive for as long as anything references it.
+
+        Unless procs has custom decoders, large nested pictures are also left in data until they
+        are first drawn, so they are only validated then: one that turns out to be malformed
+        draws nothing.
+
+        Intended for large serialized pictures mapped with SkData::MakeFromFileName(), where
+        only the pages that are actually used need be read.
+
+        @param data   container for serial data
+        @param procs  custom serial data decoders; may be nullptr
+        @return       SkPicture constructed from data
+    */
+    static sk_sp<SkPicture> MakeFromSharedData(sk_sp<SkData> data,
+                                               const SkDeserialProcs* procs = nullptr);
+
     /** \class SkPicture::AbortCallback
         AbortCallback is an abstract class. An implementation of AbortCallback may
         passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -239,13 +257,15 @@ private:
     SkPicture();
     friend class SkBigPicture;
     friend class SkEmptyPicture;
+    friend class SkLazyPicture;
     friend class SkPicturePriv;
 
     void serialize(SkWStream*, const SkSerialProcs*, class SkRefCntSet* typefaces,
         bool textBlobsOnly=false) const;
     static sk_sp<SkPicture> MakeFromStreamPriv(SkStream*, const SkDeserialProcs*,
                                                class SkTypefacePlayback*,
-                                               int recursionLimit);
+                                               int recursionLimit,
+                                               const SkData* sharedData);
     friend class SkPictureData;
 
     /** Return true if the SkStream/Buffer represents a serialized picture, and
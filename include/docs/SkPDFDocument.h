@@ -134,15 +134,36 @@ struct Metadata {
     /** Executor to handle threaded work within PDF Backend. If this is nullptr,
         then all work will be done serially on the main thread. To have worker
         threads assist with various tasks, set this to a valid SkExecutor
-        instance. Currently used for executing Deflate algorithm in parallel.
+        instance. Currently used for finishing page content streams, gradient
+        functions, images, and font subsets in parallel, and for executing
+        Deflate algorithm in parallel, both across streams and across 128 KB
+        blocks of large streams.
 
-        If set, the PDF output will be non-reproducible in the order and
-        internal numbering of objects, but should render the same.
+        The output is reproducible, and matches the output without an executor,
+        except that streams deflated in blocks compress slightly differently.
 
         Experimental.
     */
     SkExecutor* fExecutor = nullptr;
 
+    /** Deflate compression levels.  Higher levels make smaller files more slowly.
+    */
+    enum class CompressionLevel : int {
+        Default = -1,
+        None = 0,
+        LowButFast = 1,
+        Average = 6,
+        HighButSlow = 9,
+    };
+
+    /** Compression level for page content and other non-image streams.
+    */
+    CompressionLevel fCompressionLevel = CompressionLevel::Default;
+
+    /** Compression level for images that are deflated rather than JPEG encoded.
+    */
+    CompressionLevel fImageCompressionLevel = CompressionLevel::Default;
+
     /** Preferred Subsetter. Only respected if both are compiled in.
 
         The Sfntly subsetter is deprecated.
@@ -153,6 +174,16 @@ struct Metadata {
         kHarfbuzz_Subsetter,
         kSfntly_Subsetter,
     } fSubsetter = kHarfbuzz_Subsetter;
+
+    /** If true, each page is written out when it ends, rather than held until
+        the document is closed, so memory use no longer grows with the number
+        of pages.  Only the references to each page and the glyphs used from
+        each font are kept until then, when the fonts are subset.
+
+        The document's page tree is shaped slightly differently than it would
+        otherwise be, but is equally valid.
+    */
+    bool fStreamPages = false;
 };
 
 /** Associate a node ID with subsequent drawing commands in an
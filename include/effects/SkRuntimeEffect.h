@@ -19,6 +19,7 @@
 #include "include/private/SkOnce.h"
 #include "include/private/SkSLSampleUsage.h"
 
+#include <memory>
 #include <string>
 #include <optional>
 #include <vector>
@@ -39,9 +40,11 @@ class FunctionDefinition;
 struct Program;
 enum class ProgramKind : int8_t;
 struct ProgramSettings;
+class SkVMTemplate;
 }  // namespace SkSL
 
 namespace skvm {
+struct Features;
 class Program;
 }  // namespace skvm
 
@@ -243,6 +246,46 @@ public:
     };
     static TracedShader MakeTraced(sk_sp<SkShader> shader, const SkIPoint& traceCoord);
 
+    /**
+     * Storage that lets the CPU backend reuse the code it generates for a runtime effect across
+     * processes, instead of regenerating it the first time each process draws with the effect.
+     * Keys are derived from the effect's SkSL, its kind and options, and the version of Skia, so
+     * entries written by an incompatible build are never loaded.
+     */
+    class SK_API PersistentCache {
+    public:
+        virtual ~PersistentCache() = default;
+
+        /**
+         * Returns the data for the key if it exists in the cache, otherwise returns null.
+         */
+        virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+        /**
+         * Stores data in the cache, indexed by key.
+         */
+        virtual void store(const SkData& key, const SkData& data) = 0;
+
+    protected:
+        PersistentCache() = default;
+        PersistentCache(const PersistentCache&) = delete;
+        PersistentCache& operator=(const PersistentCache&) = delete;
+    };
+
+    /**
+     * Sets the cache used by all runtime effects, or stops using one if cache is null. It may be
+     * called from any thread, so load() and store() must be thread-safe. The cache must outlive
+     * every effect that might draw while it's set.
+     */
+    static void SetPersistentCache(PersistentCache* cache);
+
+    /**
+     * Returns a PersistentCache that keeps each entry in its own file in 'directory', creating the
+     * directory if needed, so entries stored by one process are loaded by the next. Any number of
+     * processes may share a directory. Returns null if the directory can't be created.
+     */
+    static std::unique_ptr<PersistentCache> MakeDirectoryCache(const char directory[]);
+
     // Returns the SkSL source of the runtime effect shader.
     const std::string& source() const;
 
@@ -304,6 +347,10 @@ private:
 
     const SkFilterColorProgram* getFilterColorProgram() const;
 
+    // Returns the template for emitting this effect's main() into builders with these features, or
+    // null if there isn't one.
+    const SkSL::SkVMTemplate* getVMTemplate(const skvm::Features& features) const;
+
 #if SK_SUPPORT_GPU
     friend class GrSkSLFP;             // fBaseProgram, fSampleUsages
     friend class GrGLSLSkSLFP;         //
@@ -326,6 +373,9 @@ private:
 
     std::unique_ptr<SkFilterColorProgram> fFilterColorProgram;
 
+    mutable SkOnce fVMTemplateOnce;
+    mutable std::unique_ptr<SkSL::SkVMTemplate> fVMTemplate;
+
     uint32_t fFlags;  // Flags
 };
 
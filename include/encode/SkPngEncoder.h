@@ -11,6 +11,7 @@
 #include "include/core/SkDataTable.h"
 #include "include/encode/SkEncoder.h"
 
+class SkExecutor;
 class SkPngEncoderMgr;
 class SkWStream;
 struct skcms_ICCProfile;
@@ -70,6 +71,17 @@ public:
          */
         const skcms_ICCProfile* fICCProfile = nullptr;
         const char* fICCProfileDescription = nullptr;
+
+        /**
+         *  If set, large images encoded all at once are filtered and compressed in bands of
+         *  rows, in parallel on this executor.  Each band is compressed on its own and written
+         *  as its own IDAT chunk, so the output is still a standard png, though usually slightly
+         *  larger than a serial encode.
+         *
+         *  Only 8-bit per channel outputs are encoded in parallel.  Others, small images, and
+         *  images encoded a few rows at a time with encodeRows() are encoded serially.
+         */
+        SkExecutor* fExecutor = nullptr;
     };
 
     /**
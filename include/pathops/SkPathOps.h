@@ -12,6 +12,7 @@
 #include "include/private/SkTArray.h"
 #include "include/private/SkTDArray.h"
 
+class SkExecutor;
 struct SkRect;
 
 
@@ -96,10 +97,15 @@ public:
     /** Computes the sum of all paths and operands, and resets the builder to its
         initial state.
 
+        If an executor is supplied and every operand is a union, paths whose bounds don't touch
+        are split into clusters which are resolved in parallel on the executor, and the
+        resulting (disjoint) paths are appended in the order their clusters were first added.
+
         @param result The product of the operands.
+        @param executor Optional executor used to resolve disjoint clusters of paths.
         @return True if the operation succeeded.
       */
-    bool resolve(SkPath* result);
+    bool resolve(SkPath* result, SkExecutor* executor = nullptr);
 
 private:
     SkTArray<SkPath> fPathRefs;
@@ -107,6 +113,7 @@ private:
 
     static bool FixWinding(SkPath* path);
     static void ReversePath(SkPath* path);
+    int findUnionClusters(SkTDArray<int>* clusters) const;
     void reset();
 };
 
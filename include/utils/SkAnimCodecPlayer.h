@@ -12,16 +12,44 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkThreadAnnotations.h"
 
 #include <cstdint>
 #include <memory>
 #include <vector>
 
+class SkData;
+class SkExecutor;
 class SkImage;
+class SkTaskGroup;
 
 class SkAnimCodecPlayer {
 public:
     SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec);
+
+    struct DecodeOptions {
+        /**
+         *  If set, frames after the current one are decoded ahead of time on this executor.
+         *  Frames that do not depend on an earlier frame, or whose required frame is already
+         *  decoded, are decoded in parallel, each with its own SkCodec.
+         */
+        SkExecutor* fExecutor = nullptr;
+
+        /**
+         *  How many frames past the current one to decode ahead of time.
+         */
+        int fLookahead = 4;
+
+        /**
+         *  The maximum number of decoded frames to keep, or 0 to keep them all. When full, the
+         *  frame that would be shown furthest in the future is dropped.
+         */
+        int fMaxCachedFrames = 0;
+    };
+
+    SkAnimCodecPlayer(sk_sp<SkData> data, const DecodeOptions& options);
+
     ~SkAnimCodecPlayer();
 
     /**
@@ -56,11 +84,25 @@ private:
     std::unique_ptr<SkCodec>        fCodec;
     SkImageInfo                     fImageInfo;
     std::vector<SkCodec::FrameInfo> fFrameInfos;
-    std::vector<sk_sp<SkImage> >    fImages;
-    int                             fCurrIndex = 0;
     uint32_t                        fTotalDuration;
 
+    // Only set when decoding ahead of time; each task makes its own codec from fData.
+    sk_sp<SkData>                   fData;
+    DecodeOptions                   fOptions;
+    std::unique_ptr<SkTaskGroup>    fTaskGroup;
+
+    // Decoded frames may be written from fTaskGroup's threads.
+    mutable SkMutex                 fMutex;
+    std::vector<sk_sp<SkImage> >    fImages      SK_GUARDED_BY(fMutex);
+    std::vector<bool>               fInFlight    SK_GUARDED_BY(fMutex);
+    int                             fCachedCount SK_GUARDED_BY(fMutex) = 0;
+    int                             fCurrIndex   SK_GUARDED_BY(fMutex) = 0;
+
+    void init();
     sk_sp<SkImage> getFrameAt(int index);
+    sk_sp<SkImage> decodeFrame(SkCodec* codec, int index, sk_sp<SkImage> requiredImage) const;
+    void cacheFrame(int index, sk_sp<SkImage> image) SK_REQUIRES(fMutex);
+    void decodeAhead();
 };
 
 #endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledRasterizer_DEFINED
+#define SkTiledRasterizer_DEFINED
+
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTypes.h"
+
+class SkCanvas;
+class SkExecutor;
+class SkPicture;
+
+/**
+ *  SkTiledRasterizer draws into raster pixels using several threads at once.
+ *
+ *  Draws are recorded with an R-tree, then the destination is split into tiles.  Each tile
+ *  replays only the ops whose bounds touch it, and tiles run in parallel on an SkExecutor.
+ *  The pixels produced are the same as drawing directly into the pixmap: every op is
+ *  rasterized as it would be for the whole destination, and a tile only keeps the pixels
+ *  that fall inside it.
+ *
+ *  Layers are drawn whole by every tile they touch, so large layers don't speed up.  Pictures
+ *  that read back the destination outside of an op's own bounds (backdrop filters,
+ *  kInitWithPrevious layers, drawBehind) are drawn on the calling thread instead.
+ */
+class SK_API SkTiledRasterizer {
+public:
+    /**
+     *  Draws will land in dst's pixels, which must remain valid while this object draws into
+     *  them.  Tiles run on executor, which must outlive this object.
+     */
+    SkTiledRasterizer(const SkPixmap& dst, SkExecutor& executor,
+                      SkISize tileSize = {256, 256}, const SkSurfaceProps* props = nullptr);
+    ~SkTiledRasterizer();
+
+    /**
+     *  Starts recording.  The returned canvas is owned by this object and is valid until the
+     *  next call to flush().  It starts with an identity matrix and no clip.
+     */
+    SkCanvas* beginRecording();
+
+    /** Returns the recording canvas if we are recording, otherwise nullptr. */
+    SkCanvas* getRecordingCanvas();
+
+    /**
+     *  Ends the recording and rasterizes everything drawn since beginRecording() into the
+     *  destination pixels.  Returns once every tile is finished.
+     */
+    void flush();
+
+    /** Rasterizes picture into the destination pixels, tile by tile. */
+    void drawPicture(const SkPicture* picture);
+
+    int tileCount() const;
+
+private:
+    SkPixmap           fDst;
+    SkExecutor&        fExecutor;
+    SkISize            fTileSize;
+    SkSurfaceProps     fProps;
+    SkPictureRecorder  fRecorder;
+};
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "modules/skresources/include/SkResources.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
+#include "tools/Resources.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Renders a batch of frames with skottie_utils::ParallelFrameRenderer, to track batch export
+// scaling with the number of workers.
+class SkottieFrameBench final : public Benchmark {
+public:
+    SkottieFrameBench(const char* name, const char* source, int threads)
+        : fName(SkStringPrintf("skottie_frames_%s_%dt", name, threads))
+        , fSource(source)
+        , fThreads(threads) {}
+
+private:
+    static constexpr int kFrames = 32,
+                         kSize   = 256;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        fRenderer = skottie_utils::ParallelFrameRenderer::Make(
+                GetResourceAsData(fSource),
+                skresources::FileResourceProvider::Make(GetResourcePath("skottie/images")),
+                fThreads);
+        if (!fRenderer) {
+            return;
+        }
+
+        fBitmaps.resize(kFrames);
+        fPixmaps.resize(kFrames);
+        for (int i = 0; i < kFrames; ++i) {
+            fBitmaps[i].allocN32Pixels(kSize, kSize);
+            fPixmaps[i] = fBitmaps[i].pixmap();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fRenderer) {
+            return;
+        }
+
+        const auto& anim = fRenderer->animation();
+        const double step = anim->duration() * anim->fps() / kFrames;
+        while (loops-- > 0) {
+            fRenderer->renderFrames(0, step, fPixmaps);
+        }
+    }
+
+    const SkString     fName;
+    const char*        fSource;
+    const int          fThreads;
+
+    std::unique_ptr<skottie_utils::ParallelFrameRenderer> fRenderer;
+    std::vector<SkBitmap>                                 fBitmaps;
+    std::vector<SkPixmap>                                 fPixmaps;
+
+    using INHERITED = Benchmark;
+};
+
+// Plays an animation frame by frame, repainting either the full frame or only the damaged
+// areas (Animation::renderIncremental).  Each loop is one frame.  How much each animation
+// repaints is checked by Skottie_IncrementalRenderDamage.
+class SkottieDamageBench final : public Benchmark {
+public:
+    SkottieDamageBench(const char* name, const char* source, bool incremental)
+        : fName(SkStringPrintf("skottie_%s_%s", incremental ? "damage" : "full", name))
+        , fSource(source)
+        , fIncremental(incremental) {}
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        if (auto data = GetResourceAsData(fSource)) {
+            fAnimation = skottie::Animation::Make(static_cast<const char*>(data->data()),
+                                                  data->size());
+        }
+        if (!fAnimation) {
+            return;
+        }
+
+        fBitmap.allocN32Pixels(SkScalarCeilToInt(fAnimation->size().width()),
+                               SkScalarCeilToInt(fAnimation->size().height()));
+        fCanvas = std::make_unique<SkCanvas>(fBitmap);
+
+        fAnimation->seekFrame(0);
+        fBitmap.eraseColor(SK_ColorTRANSPARENT);
+        fAnimation->render(fCanvas.get());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fAnimation) {
+            return;
+        }
+
+        const auto frame_count = static_cast<int>(fAnimation->duration() * fAnimation->fps());
+        sksg::InvalidationController ic;
+        while (loops-- > 0) {
+            fFrame = (fFrame + 1) % std::max(frame_count, 1);
+            if (fIncremental) {
+                ic.reset();
+                fAnimation->seekFrame(fFrame, &ic);
+                fAnimation->renderIncremental(fCanvas.get(), ic, nullptr, 0);
+            } else {
+                fAnimation->seekFrame(fFrame);
+                fBitmap.eraseColor(SK_ColorTRANSPARENT);
+                fAnimation->render(fCanvas.get());
+            }
+        }
+    }
+
+    const SkString fName;
+    const char*    fSource;
+    const bool     fIncremental;
+
+    sk_sp<skottie::Animation> fAnimation;
+    SkBitmap                  fBitmap;
+    std::unique_ptr<SkCanvas> fCanvas;
+    int                       fFrame = 0;
+
+    using INHERITED = Benchmark;
+};
+
+} // namespace
+
+DEF_BENCH(return new SkottieFrameBench("sphere", "skottie/skottie-sphere-effect.json", 1));
+DEF_BENCH(return new SkottieFrameBench("sphere", "skottie/skottie-sphere-effect.json", 4));
+DEF_BENCH(return new SkottieFrameBench("phonehub_onboard",
+                                       "skottie/skottie-phonehub-onboard.json", 1));
+DEF_BENCH(return new SkottieFrameBench("phonehub_onboard",
+                                       "skottie/skottie-phonehub-onboard.json", 4));
+
+DEF_BENCH(return new SkottieDamageBench("auto_orient",
+                                        "skottie/skottie-auto-orient.json", false));
+DEF_BENCH(return new SkottieDamageBench("auto_orient",
+                                        "skottie/skottie-auto-orient.json", true));
+DEF_BENCH(return new SkottieDamageBench("chained_mattes",
+                                        "skottie/skottie-chained-mattes.json", false));
+DEF_BENCH(return new SkottieDamageBench("chained_mattes",
+                                        "skottie/skottie-chained-mattes.json", true));
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "include/utils/SkRandom.h"
+#include "modules/skottie/include/Skottie.h"
+
+namespace {
+
+// Seeks a synthetic animation with many keyframed (eased) transform properties.  Sequential
+// seeks model playback, random seeks model scrubbing.
+//
+// Timing is reported per animated property, but covers all of Animation::seekFrame(): keyframe
+// lookup and easing, plus pushing the values into the scene graph and revalidating it.
+class SkottieSeekBench final : public Benchmark {
+public:
+    SkottieSeekBench(int layers, int keyframes, bool sequential)
+        : fName(SkStringPrintf("skottie_seek_%s_%dx%d",
+                               sequential ? "sequential" : "random", layers, keyframes))
+        , fLayers(layers)
+        , fKeyframes(keyframes)
+        , fSequential(sequential) {}
+
+private:
+    static constexpr int kFrames             = 60,
+                         kPropertiesPerLayer = 4;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+
+        // Keyframes are evenly spaced, with random values and a standard AE ease.
+        const auto keyframes = [&](int dim) {
+            SkString kfs("{\"a\":1,\"k\":[");
+            for (int i = 0; i < fKeyframes; ++i) {
+                kfs.appendf("%s{\"t\":%f,\"s\":[", i ? "," : "",
+                            static_cast<float>(i * kFrames) / (fKeyframes - 1));
+                for (int j = 0; j < dim; ++j) {
+                    kfs.appendf("%s%f", j ? "," : "", rand.nextRangeF(0, 100));
+                }
+                kfs.append("],\"o\":{\"x\":[0.33],\"y\":[0]},\"i\":{\"x\":[0.67],\"y\":[1]}}");
+            }
+            kfs.append("]}");
+            return kfs;
+        };
+
+        SkString json;
+        json.appendf("{\"v\":\"5.5.0\",\"fr\":30,\"ip\":0,\"op\":%d,\"w\":500,\"h\":500,"
+                     "\"layers\":[", kFrames);
+        for (int i = 0; i < fLayers; ++i) {
+            json.appendf("%s{\"ty\":4,\"ind\":%d,\"ip\":0,\"op\":%d,\"st\":0,"
+                         "\"ks\":{\"p\":%s,\"r\":%s,\"o\":%s,\"s\":%s},"
+                         "\"shapes\":[{\"ty\":\"rc\",\"p\":{\"a\":0,\"k\":[0,0]},"
+                                       "\"s\":{\"a\":0,\"k\":[10,10]},"
+                                       "\"r\":{\"a\":0,\"k\":0}},"
+                                      "{\"ty\":\"fl\",\"c\":{\"a\":0,\"k\":[1,0,0,1]},"
+                                       "\"o\":{\"a\":0,\"k\":100}}]}",
+                         i ? "," : "", i + 1, kFrames,
+                         keyframes(2).c_str(), keyframes(1).c_str(),
+                         keyframes(1).c_str(), keyframes(2).c_str());
+        }
+        json.append("]}");
+
+        fAnimation = skottie::Animation::Make(json.c_str(), json.size());
+        this->setUnits(fLayers * kPropertiesPerLayer);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fAnimation) {
+            return;
+        }
+
+        for (int i = 0; i < loops; ++i) {
+            // Half-frame steps, for a mix of same-segment and next-segment sequential seeks.
+            fFrame = fSequential ? fFrame + 0.5f : fRand.nextRangeF(0, kFrames);
+            if (fFrame >= kFrames) {
+                fFrame = 0;
+            }
+            fAnimation->seekFrame(fFrame);
+        }
+    }
+
+    const SkString fName;
+    const int      fLayers,
+                   fKeyframes;
+    const bool     fSequential;
+
+    sk_sp<skottie::Animation> fAnimation;
+    SkRandom                  fRand;
+    float                     fFrame = 0;
+
+    using INHERITED = Benchmark;
+};
+
+} // namespace
+
+DEF_BENCH(return new SkottieSeekBench(1000,  8, true ));
+DEF_BENCH(return new SkottieSeekBench(1000,  8, false));
+DEF_BENCH(return new SkottieSeekBench(1000, 64, true ));
+DEF_BENCH(return new SkottieSeekBench(1000, 64, false));
@@ -8,6 +8,7 @@
 #ifndef Skottie_DEFINED
 #define Skottie_DEFINED
 
+#include "include/core/SkColor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
@@ -22,9 +23,10 @@
 
 class SkCanvas;
 struct SkRect;
+class SkRegion;
 class SkStream;
 
-namespace skjson { class ObjectValue; }
+namespace skjson { class DOM; class ObjectValue; }
 
 namespace sksg {
 
@@ -163,6 +165,8 @@ public:
         sk_sp<Animation> makeFromFile(const char path[]);
 
     private:
+        sk_sp<Animation> makeFromDOM(const skjson::DOM&);
+
         const uint32_t          fFlags;
 
         sk_sp<ResourceProvider>   fResourceProvider;
@@ -211,6 +215,30 @@ public:
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
     void render(SkCanvas* canvas, const SkRect* dst, RenderFlags) const;
 
+    /**
+     * Draws the current animation frame incrementally: only the areas invalidated since the
+     * previous frame are repainted, and the existing canvas content is preserved elsewhere.
+     *
+     * The canvas must hold the previous frame, as drawn by one of the render() variants with the
+     * same |dst| and |flags|, and |ic| must have been passed to all seek() calls since.  Callers
+     * typically reset |ic| after each frame.
+     *
+     * Damaged areas are cleared to |background| before repainting.  Curves crossing into them
+     * are rasterized under a clip, so their antialiasing may differ slightly from render().
+     *
+     * @param canvas      destination canvas
+     * @param ic          invalidation controller tracking the damage since the previous frame
+     * @param dst         optional destination rect
+     * @param flags       RenderFlags
+     * @param background  clear color for the damaged areas
+     * @param damage      optional, receives the repainted area in device space
+     *                    (e.g. for partial presentation)
+     */
+    void renderIncremental(SkCanvas* canvas, const sksg::InvalidationController& ic,
+                           const SkRect* dst, RenderFlags flags,
+                           SkColor background = SK_ColorTRANSPARENT,
+                           SkRegion* damage = nullptr) const;
+
     /**
      * [Deprecated: use one of the other versions.]
      *
@@ -13,6 +13,7 @@
 #include "include/core/SkImage.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPoint.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkStream.h"
 #include "include/private/SkTArray.h"
 #include "include/private/SkTPin.h"
@@ -321,12 +322,40 @@ sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
         return nullptr;
     }
 
-    return this->make(static_cast<const char*>(data->data()), data->size());
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    fStats = Stats{};
+
+    fStats.fJsonSize = data->size();
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // The stream copy is ours to clobber: parse it in place, so long strings (e.g. embedded
+    // images) are referenced instead of duplicated in the DOM.
+    const skjson::DOM dom(std::move(data));
+
+    const auto t1 = std::chrono::steady_clock::now();
+    fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
+
+    return this->makeFromDOM(dom);
 }
 
 sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
+    fStats = Stats{};
+
+    fStats.fJsonSize = data_len;
+    const auto t0 = std::chrono::steady_clock::now();
+
+    const skjson::DOM dom(data, data_len);
+
+    const auto t1 = std::chrono::steady_clock::now();
+    fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
+
+    return this->makeFromDOM(dom);
+}
+
+sk_sp<Animation> Animation::Builder::makeFromDOM(const skjson::DOM& dom) {
     // Sanitize factory args.
     class NullResourceProvider final : public ResourceProvider {
         sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
@@ -334,12 +363,6 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     auto resolvedProvider = fResourceProvider
             ? fResourceProvider : sk_make_sp<NullResourceProvider>();
 
-    fStats = Stats{};
-
-    fStats.fJsonSize = data_len;
-    const auto t0 = std::chrono::steady_clock::now();
-
-    const skjson::DOM dom(data, data_len);
     if (!dom.root().is<skjson::ObjectValue>()) {
         // TODO: more error info.
         if (fLogger) {
@@ -350,7 +373,6 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     const auto& json = dom.root().as<skjson::ObjectValue>();
 
     const auto t1 = std::chrono::steady_clock::now();
-    fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
 
     const auto version  = ParseDefault<SkString>(json["v"], SkString());
     const auto size     = SkSize::Make(ParseDefault<float>(json["w"], 0.0f),
@@ -384,7 +406,7 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
 
     const auto t2 = std::chrono::steady_clock::now();
     fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t2-t1}.count();
-    fStats.fTotalLoadTimeMS  = std::chrono::duration<float, std::milli>{t2-t0}.count();
+    fStats.fTotalLoadTimeMS  = fStats.fJsonParseTimeMS + fStats.fSceneParseTimeMS;
 
     if (!ainfo.fScene && fLogger) {
         fLogger->log(Logger::Level::kError, "Could not parse animation.\n");
@@ -407,10 +429,11 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
 }
 
 sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
-    const auto data = SkData::MakeFromFileName(path);
+    // Read the file rather than mapping it: the copy can be parsed in place.
+    SkFILEStream stream(path);
 
-    return data ? this->make(static_cast<const char*>(data->data()), data->size())
-                : nullptr;
+    return stream.isValid() ? this->make(&stream)
+                            : nullptr;
 }
 
 Animation::Animation(std::unique_ptr<sksg::Scene> scene,
@@ -460,6 +483,43 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
     fScene->render(canvas);
 }
 
+void Animation::renderIncremental(SkCanvas* canvas, const sksg::InvalidationController& ic,
+                                  const SkRect* dstR, RenderFlags renderFlags,
+                                  SkColor background, SkRegion* damage) const {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    const SkRect srcR = SkRect::MakeSize(this->size());
+    auto local_to_device = canvas->getLocalToDeviceAs3x3();
+    if (dstR) {
+        local_to_device.preConcat(SkMatrix::RectToRect(srcR, *dstR,
+                                                       SkMatrix::kCenter_ScaleToFit));
+    }
+    const auto clip_to_bounds = !(renderFlags & RenderFlag::kDisableTopLevelClipping);
+
+    // The invalidation rects are in animation coordinates: map to device space, and snap to
+    // whole pixels so the repainted area fully covers any partially damaged pixels.
+    SkRegion device_damage;
+    for (const auto& inval : ic) {
+        auto r = inval;
+        if (clip_to_bounds && !r.intersect(srcR)) {
+            continue;
+        }
+        device_damage.op(local_to_device.mapRect(r).roundOut(), SkRegion::kUnion_Op);
+    }
+    device_damage.op(canvas->getDeviceClipBounds(), SkRegion::kIntersect_Op);
+
+    if (fScene && !device_damage.isEmpty()) {
+        SkAutoCanvasRestore acr(canvas, true);
+        canvas->clipRegion(device_damage);
+        canvas->drawColor(background, SkBlendMode::kSrc);
+        this->render(canvas, dstR, renderFlags);
+    }
+
+    if (damage) {
+        *damage = std::move(device_damage);
+    }
+}
+
 void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
@@ -5,15 +5,20 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
 #include "modules/skottie/src/text/SkottieShaper.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
 #include "src/core/SkFontDescriptor.h"
 #include "tests/Test.h"
+#include "tools/Resources.h"
 #include "tools/ToolUtils.h"
 
 #include <cmath>
@@ -849,3 +854,249 @@ DEF_TEST(Skottie_Layer_NoType, r) {
     // passes if we don't crash
     REPORTER_ASSERT(r, anim);
 }
+
+DEF_TEST(Skottie_IncrementalRender, r) {
+    // A small square moving over a static, full-frame background.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 10,
+             "layers": [
+               {
+                 "ty": 1,
+                 "sw": 10,
+                 "sh": 10,
+                 "sc": "#ff0000",
+                 "ip": 0,
+                 "op": 10,
+                 "ks": {
+                   "p": {
+                     "a": 1,
+                     "k": [
+                       { "t": 0, "s": [ 10, 10 ] },
+                       { "t": 10, "s": [ 80, 80 ] }
+                     ]
+                   }
+                 }
+               },
+               {
+                 "ty": 1,
+                 "sw": 100,
+                 "sh": 100,
+                 "sc": "#00ff00",
+                 "ip": 0,
+                 "op": 10,
+                 "ks": {}
+               }
+             ]
+           })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto anim = Animation::Make(&stream);
+    REPORTER_ASSERT(r, anim);
+
+    const auto info = SkImageInfo::MakeN32Premul(200, 200);
+    const auto dst  = SkRect::MakeWH(200, 200);
+
+    SkBitmap incremental, full;
+    incremental.allocPixels(info);
+    full.allocPixels(info);
+    SkCanvas incremental_canvas(incremental),
+             full_canvas(full);
+
+    anim->seekFrame(0);
+    incremental.eraseColor(SK_ColorTRANSPARENT);
+    anim->render(&incremental_canvas, &dst);
+
+    sksg::InvalidationController ic;
+    for (const double frame : {2.0, 2.0, 5.5, 9.0}) {
+        ic.reset();
+        anim->seekFrame(frame, &ic);
+
+        SkRegion damage;
+        anim->renderIncremental(&incremental_canvas, ic, &dst, 0, SK_ColorTRANSPARENT, &damage);
+
+        full.eraseColor(SK_ColorTRANSPARENT);
+        anim->render(&full_canvas, &dst);
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(incremental, full), "frame %g", frame);
+
+        // Only the square's old and new positions are repainted (20x20 in device space).
+        int64_t damage_area = 0;
+        for (SkRegion::Iterator it(damage); !it.done(); it.next()) {
+            damage_area += it.rect().width() * it.rect().height();
+        }
+        REPORTER_ASSERT(r, damage_area <= 2 * 20 * 20,
+                        "frame %g damage %lld", frame, (long long)damage_area);
+    }
+
+    // No damage when the frame doesn't change.
+    ic.reset();
+    anim->seekFrame(9.0, &ic);
+    SkRegion damage;
+    anim->renderIncremental(&incremental_canvas, ic, &dst, 0, SK_ColorTRANSPARENT, &damage);
+    REPORTER_ASSERT(r, damage.isEmpty());
+}
+
+DEF_TEST(Skottie_IncrementalRenderDamage, r) {
+    // Repainted area per frame, as a fraction of the frame, for real animations.
+    static constexpr struct {
+        const char* file;
+        float       max_damage;
+    } kTests[] = {
+        { "skottie/skottie-auto-orient.json"   , 0.05f },  // a small shape on a path
+        { "skottie/skottie-chained-mattes.json", 0.75f },  // large animated mattes
+    };
+
+    for (const auto& tst : kTests) {
+        auto data = GetResourceAsData(tst.file);
+        auto anim = data ? Animation::Make(static_cast<const char*>(data->data()), data->size())
+                         : nullptr;
+        if (!anim) {
+            ERRORF(r, "could not load %s", tst.file);
+            continue;
+        }
+
+        const auto info = SkImageInfo::MakeN32Premul(anim->size().toCeil());
+        SkBitmap incremental, full;
+        incremental.allocPixels(info);
+        full.allocPixels(info);
+        SkCanvas incremental_canvas(incremental),
+                 full_canvas(full);
+
+        anim->seekFrame(0);
+        full.eraseColor(SK_ColorTRANSPARENT);
+        anim->render(&full_canvas);
+
+        // Every 10th frame, to keep the test quick.
+        static constexpr int kStep = 10;
+        const auto frame_count = static_cast<int>(anim->duration() * anim->fps());
+        int64_t damage_area = 0;
+        int frames = 0;
+        sksg::InvalidationController ic;
+        for (int frame = kStep; frame < frame_count; frame += kStep, ++frames) {
+            // Start from an exact copy of the previous frame.
+            incremental.writePixels(full.pixmap());
+
+            ic.reset();
+            anim->seekFrame(frame, &ic);
+
+            SkRegion damage;
+            anim->renderIncremental(&incremental_canvas, ic, nullptr, 0, SK_ColorTRANSPARENT,
+                                    &damage);
+
+            full.eraseColor(SK_ColorTRANSPARENT);
+            anim->render(&full_canvas);
+
+            // Curves crossing into the damaged area are antialiased differently under the clip,
+            // so only the untouched pixels have to match exactly: nothing changed out there.
+            SkBitmap expected;
+            expected.allocPixels(info);
+            expected.writePixels(full.pixmap());
+            for (SkRegion::Iterator it(damage); !it.done(); it.next()) {
+                expected.erase(SK_ColorTRANSPARENT, it.rect());
+                incremental.erase(SK_ColorTRANSPARENT, it.rect());
+                damage_area += it.rect().width() * it.rect().height();
+            }
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(incremental, expected),
+                            "%s frame %d", tst.file, frame);
+        }
+
+        const auto damage = static_cast<float>(damage_area) /
+                            (static_cast<float>(frames) * info.width() * info.height());
+        REPORTER_ASSERT(r, frames > 0 && damage <= tst.max_damage,
+                        "%s damage %g", tst.file, damage);
+    }
+}
+
+DEF_TEST(Skottie_KeyframeSegments, r) {
+    // Opacity keyframes with hold, linear and cubic segments.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1,
+                 "ind": 0,
+                 "ip": 0,
+                 "op": 100,
+                 "sw": 100,
+                 "sh": 100,
+                 "sc": "#ff0000",
+                 "ks": {
+                   "o": { "a": 1, "k": [
+                     { "t":  5, "s": [  0 ], "h": 1 },
+                     { "t": 20, "s": [ 50 ] },
+                     { "t": 35, "s": [ 10 ], "o": { "x": [0.3], "y": [0] },
+                                             "i": { "x": [0.7], "y": [1] } },
+                     { "t": 50, "s": [ 90 ], "o": { "x": [0.9], "y": [0] },
+                                             "i": { "x": [0.1], "y": [1] } },
+                     { "t": 65, "s": [ 30 ], "h": 1 },
+                     { "t": 80, "s": [ 70 ] },
+                     { "t": 95, "s": [100 ] }
+                   ]}
+                 }
+               }
+             ]
+           })";
+
+    class OpacityObserver final : public PropertyObserver {
+    public:
+        void onOpacityProperty(const char[],
+                               const LazyHandle<OpacityPropertyHandle>& lh) override {
+            fHandle = lh();
+        }
+
+        std::unique_ptr<OpacityPropertyHandle> fHandle;
+    };
+
+    const auto opacity_at = [](const sk_sp<Animation>& anim,
+                               const sk_sp<OpacityObserver>& observer,
+                               float frame) {
+        anim->seekFrame(frame);
+        return observer->fHandle->get();
+    };
+
+    auto observer = sk_make_sp<OpacityObserver>();
+    auto anim = Animation::Builder().setPropertyObserver(observer).make(json, strlen(json));
+    REPORTER_ASSERT(r, anim && observer->fHandle);
+    if (!anim || !observer->fHandle) {
+        return;
+    }
+
+    // Forward playback, backward playback and random access should all resolve the same
+    // keyframe segments as a cold seek.
+    std::vector<float> frames;
+    for (float f = 0; f <= 100; f += 0.5f) {
+        frames.push_back(f);
+    }
+    for (float f = 100; f >= 0; f -= 0.75f) {
+        frames.push_back(f);
+    }
+    for (float f : { 3.f, 90.f, 21.f, 64.f, 35.f, 34.9f, 5.f, 96.f, 49.f, 80.f, 20.f, 0.f }) {
+        frames.push_back(f);
+    }
+
+    for (float f : frames) {
+        auto ref_observer = sk_make_sp<OpacityObserver>();
+        auto ref_anim = Animation::Builder().setPropertyObserver(ref_observer)
+                                            .make(json, strlen(json));
+        REPORTER_ASSERT(r, opacity_at(anim, observer, f) ==
+                           opacity_at(ref_anim, ref_observer, f), "frame %g", f);
+    }
+
+    // Spot-check a few values.
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(opacity_at(anim, observer,  0),   0));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(opacity_at(anim, observer, 19),   0));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(opacity_at(anim, observer, 20),  50));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(opacity_at(anim, observer, 70),  30));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(opacity_at(anim, observer, 99), 100));
+}
@@ -53,6 +53,20 @@ KeyframeAnimator::KFSegment KeyframeAnimator::find_segment(float t) const {
     auto kf0 = &fKFs.front(),
          kf1 = &fKFs.back();
 
+    // Narrow the search range based on the previous segment.
+    if (fCurrentSegment.kf0) {
+        if (t < fCurrentSegment.kf0->t) {
+            kf1 = fCurrentSegment.kf0;
+        } else {
+            kf0 = fCurrentSegment.kf1;
+
+            // Sequential playback mostly advances to the next segment.
+            if (t < kf0[1].t) {
+                kf1 = kf0 + 1;
+            }
+        }
+    }
+
     // Binary-search, until we reduce to sequential keyframes.
     while (kf0 + 1 != kf1) {
         SkASSERT(kf0 < kf1);
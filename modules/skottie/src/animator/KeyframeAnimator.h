@@ -97,7 +97,7 @@ private:
         }
     };
 
-    // Find the KFSegment containing |t|.
+    // Find the KFSegment containing |t|, starting from the current (cached) segment.
     KFSegment find_segment(float t) const;
 
     // Given a |t| and a containing KFSegment, compute the local interpolation weight.
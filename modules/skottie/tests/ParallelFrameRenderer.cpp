@@ -0,0 +1,162 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "modules/skresources/include/SkResources.h"
+#include "tests/Test.h"
+
+#include <vector>
+
+namespace {
+
+// An animated shape over a static image, which the renderer shares between its workers.
+static constexpr char kJson[] =
+    R"({
+         "v": "5.2.1",
+         "w": 64,
+         "h": 48,
+         "fr": 30,
+         "ip": 0,
+         "op": 30,
+         "assets": [{
+           "id": "img_0",
+           "p" : "img_0.png",
+           "u" : "images/",
+           "w" : 64,
+           "h" : 48
+         }],
+         "layers": [
+           {
+             "ty": 4,
+             "ip": 0,
+             "op": 30,
+             "ks": {
+               "p": { "a": 1, "k": [ { "t":  0, "s": [  8,  8], "e": [56, 40] },
+                                     { "t": 30, "s": [ 56, 40] } ] },
+               "r": { "a": 1, "k": [ { "t":  0, "s": [0], "e": [90] },
+                                     { "t": 30, "s": [90] } ] }
+             },
+             "shapes": [
+               { "ty": "rc", "s": { "a": 0, "k": [20, 10] }, "p": { "a": 0, "k": [0, 0] },
+                 "r": { "a": 0, "k": 0 } },
+               { "ty": "fl", "o": { "a": 0, "k": 100 },
+                 "c": { "a": 1, "k": [ { "t":  0, "s": [1, 0, 0, 1], "e": [0, 0, 1, 1] },
+                                       { "t": 30, "s": [0, 0, 1, 1] } ] } }
+             ]
+           },
+           {
+             "ty": 2,
+             "ip": 0,
+             "op": 30,
+             "refId": "img_0",
+             "ks": {
+               "o": { "a": 1, "k": [ { "t":  0, "s": [100], "e": [20] },
+                                     { "t": 30, "s": [20] } ] }
+             }
+           }
+         ]
+       })";
+
+class TestResourceProvider final : public skresources::ResourceProvider {
+public:
+    TestResourceProvider() {
+        const SkPoint pts[] = {{0, 0}, {64, 48}};
+        const SkColor colors[] = {SK_ColorGREEN, SK_ColorMAGENTA};
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                     SkTileMode::kClamp));
+        auto surf = SkSurface::MakeRasterN32Premul(64, 48);
+        surf->getCanvas()->drawPaint(paint);
+        fImage = surf->makeImageSnapshot();
+    }
+
+private:
+    class StaticAsset final : public skresources::ImageAsset {
+    public:
+        explicit StaticAsset(sk_sp<SkImage> image) : fImage(std::move(image)) {}
+
+    private:
+        bool isMultiFrame() override { return false; }
+        sk_sp<SkImage> getFrame(float) override { return fImage; }
+
+        const sk_sp<SkImage> fImage;
+    };
+
+    sk_sp<skresources::ImageAsset> loadImageAsset(const char[], const char[],
+                                                  const char[]) const override {
+        return sk_make_sp<StaticAsset>(fImage);
+    }
+
+    sk_sp<SkImage> fImage;
+};
+
+// Renders the frames one at a time, the way ParallelFrameRenderer promises to match.
+std::vector<SkBitmap> render_serially(sk_sp<skresources::ResourceProvider> rp,
+                                      double first_frame, double frame_step, int count) {
+    auto anim = skottie::Animation::Builder()
+                    .setResourceProvider(std::move(rp))
+                    .make(kJson, strlen(kJson));
+
+    std::vector<SkBitmap> frames(count);
+    for (int i = 0; i < count; ++i) {
+        frames[i].allocN32Pixels(64, 48);
+        SkCanvas canvas(frames[i]);
+        const auto bounds = SkRect::MakeIWH(64, 48);
+        anim->seekFrame(first_frame + i * frame_step);
+        canvas.clear(SK_ColorWHITE);
+        anim->render(&canvas, &bounds);
+    }
+    return frames;
+}
+
+void check_frames(skiatest::Reporter* r, skottie_utils::ParallelFrameRenderer* renderer,
+                  double first_frame, double frame_step, int count) {
+    std::vector<SkBitmap> bitmaps(count);
+    std::vector<SkPixmap> pixmaps;
+    for (auto& bm : bitmaps) {
+        bm.allocN32Pixels(64, 48);
+        bm.eraseColor(SK_ColorBLACK);
+        pixmaps.push_back(bm.pixmap());
+    }
+    renderer->renderFrames(first_frame, frame_step, pixmaps);
+
+    const auto expected = render_serially(sk_make_sp<TestResourceProvider>(),
+                                          first_frame, frame_step, count);
+    for (int i = 0; i < count; ++i) {
+        bool same = true;
+        for (int y = 0; y < 48 && same; ++y) {
+            same = !memcmp(bitmaps[i].getAddr32(0, y), expected[i].getAddr32(0, y), 64 * 4);
+        }
+        REPORTER_ASSERT(r, same, "frame %g", first_frame + i * frame_step);
+    }
+}
+
+} // namespace
+
+DEF_TEST(Skottie_ParallelFrameRenderer, r) {
+    auto renderer = skottie_utils::ParallelFrameRenderer::Make(
+            SkData::MakeWithoutCopy(kJson, strlen(kJson)),
+            sk_make_sp<TestResourceProvider>(), 4);
+    REPORTER_ASSERT(r, renderer);
+    REPORTER_ASSERT(r, renderer->workers() == 4);
+
+    // More frames than workers, so each worker seeks forward through several.
+    check_frames(r, renderer.get(), 0, 1.5, 17);
+
+    // Fewer frames than workers, and earlier ones than the workers last rendered.
+    check_frames(r, renderer.get(), 3, 2, 3);
+    check_frames(r, renderer.get(), 7.25, 0, 1);
+
+    // Nothing to do.
+    check_frames(r, renderer.get(), 0, 1, 0);
+}
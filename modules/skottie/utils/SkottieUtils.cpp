@@ -7,6 +7,16 @@
 
 #include "modules/skottie/utils/SkottieUtils.h"
 
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <thread>
+
 namespace skottie_utils {
 
 class CustomPropertyManager::PropertyInterceptor final : public skottie::PropertyObserver {
@@ -337,4 +347,184 @@ sk_sp<skottie::PropertyObserver> SlotManager::getPropertyObserver() {
     return fPropertyObserver;
 }
 
+namespace {
+
+class StaticImageAsset final : public skresources::ImageAsset {
+public:
+    explicit StaticImageAsset(FrameData data) : fData(std::move(data)) {}
+
+private:
+    bool isMultiFrame() override { return false; }
+
+    FrameData getFrameData(float) override { return fData; }
+
+    const FrameData fData;
+};
+
+} // namespace
+
+// Resolves each external resource once, and hands out instances which are safe to share between
+// concurrently rendering animations.
+class ParallelFrameRenderer::SharedResourceProvider final
+        : public skresources::ResourceProviderProxyBase {
+public:
+    explicit SharedResourceProvider(sk_sp<skresources::ResourceProvider> rp)
+        : INHERITED(std::move(rp)) {}
+
+private:
+    sk_sp<SkData> load(const char resource_path[], const char resource_name[]) const override {
+        const auto key = SkStringPrintf("%s/%s", resource_path, resource_name);
+
+        SkAutoMutexExclusive amx(fMutex);
+        if (const auto* data = fDataCache.find(key)) {
+            return *data;
+        }
+        auto data = this->INHERITED::load(resource_path, resource_name);
+        fDataCache.set(key, data);
+
+        return data;
+    }
+
+    sk_sp<skresources::ImageAsset> loadImageAsset(const char resource_path[],
+                                                  const char resource_name[],
+                                                  const char resource_id[]) const override {
+        const SkString key(resource_id);
+
+        SkAutoMutexExclusive amx(fMutex);
+        if (const auto* asset = fImageCache.find(key)) {
+            return *asset;
+        }
+
+        auto asset = this->INHERITED::loadImageAsset(resource_path, resource_name, resource_id);
+        if (!asset || asset->isMultiFrame()) {
+            // Animated images seek on every frame: each worker gets its own instance.
+            return asset;
+        }
+
+        // Static images are queried once per animation instance: decode upfront, and share the
+        // raster image between workers.
+        auto frame_data = asset->getFrameData(0);
+        if (frame_data.image) {
+            if (auto raster = frame_data.image->makeRasterImage()) {
+                frame_data.image = std::move(raster);
+            }
+        }
+        sk_sp<skresources::ImageAsset> shared =
+                sk_make_sp<StaticImageAsset>(std::move(frame_data));
+        fImageCache.set(key, shared);
+
+        return shared;
+    }
+
+    sk_sp<SkTypeface> loadTypeface(const char name[], const char url[]) const override {
+        const auto key = SkStringPrintf("%s|%s", name, url);
+
+        SkAutoMutexExclusive amx(fMutex);
+        if (const auto* tf = fTypefaceCache.find(key)) {
+            return *tf;
+        }
+        auto tf = this->INHERITED::loadTypeface(name, url);
+        fTypefaceCache.set(key, tf);
+
+        return tf;
+    }
+
+    sk_sp<SkData> loadFont(const char name[], const char url[]) const override {
+        const auto key = SkStringPrintf("%s|%s", name, url);
+
+        SkAutoMutexExclusive amx(fMutex);
+        if (const auto* data = fFontCache.find(key)) {
+            return *data;
+        }
+        auto data = this->INHERITED::loadFont(name, url);
+        fFontCache.set(key, data);
+
+        return data;
+    }
+
+    mutable SkMutex                                              fMutex;
+    mutable SkTHashMap<SkString, sk_sp<SkData>>                  fDataCache;
+    mutable SkTHashMap<SkString, sk_sp<skresources::ImageAsset>> fImageCache;
+    mutable SkTHashMap<SkString, sk_sp<SkTypeface>>              fTypefaceCache;
+    mutable SkTHashMap<SkString, sk_sp<SkData>>                  fFontCache;
+
+    using INHERITED = skresources::ResourceProviderProxyBase;
+};
+
+std::unique_ptr<ParallelFrameRenderer> ParallelFrameRenderer::Make(
+        sk_sp<SkData> json, sk_sp<skresources::ResourceProvider> rp, int threads) {
+    if (!json) {
+        return nullptr;
+    }
+
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    auto executor = threads > 1 ? SkExecutor::MakeFIFOThreadPool(threads) : nullptr;
+
+    const auto shared_rp = rp ? sk_make_sp<SharedResourceProvider>(std::move(rp)) : nullptr;
+
+    // Scene construction dominates load time, so the instances are built concurrently.
+    std::vector<sk_sp<skottie::Animation>> animations(threads);
+    {
+        SkTaskGroup tg(executor ? *executor : SkExecutor::GetDefault());
+        tg.batch(threads, [&](int i) {
+            animations[i] = skottie::Animation::Builder()
+                    .setResourceProvider(shared_rp)
+                    .make(static_cast<const char*>(json->data()), json->size());
+        });
+    }
+
+    animations.erase(std::remove(animations.begin(), animations.end(), nullptr),
+                     animations.end());
+    if (animations.empty()) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<ParallelFrameRenderer>(
+            new ParallelFrameRenderer(std::move(animations), std::move(executor)));
+}
+
+ParallelFrameRenderer::ParallelFrameRenderer(std::vector<sk_sp<skottie::Animation>> animations,
+                                             std::unique_ptr<SkExecutor> executor)
+    : fAnimations(std::move(animations))
+    , fExecutor(std::move(executor)) {}
+
+ParallelFrameRenderer::~ParallelFrameRenderer() = default;
+
+void ParallelFrameRenderer::renderFrames(double first_frame, double frame_step,
+                                         SkSpan<const SkPixmap> dst, SkColor background) {
+    const auto frame_count = static_cast<int>(dst.size()),
+                   workers = std::min(this->workers(), frame_count);
+
+    auto render_worker = [&](int w) {
+        auto* anim = fAnimations[w].get();
+        for (int i = w; i < frame_count; i += workers) {
+            const auto& pm = dst[i];
+            auto canvas = SkCanvas::MakeRasterDirect(pm.info(), pm.writable_addr(),
+                                                     pm.rowBytes());
+            if (!canvas) {
+                continue;
+            }
+
+            const auto bounds = SkRect::MakeIWH(pm.width(), pm.height());
+            anim->seekFrame(first_frame + i * frame_step);
+            canvas->clear(background);
+            anim->render(canvas.get(), &bounds);
+        }
+    };
+
+    if (workers <= 1 || !fExecutor) {
+        for (int w = 0; w < workers; ++w) {
+            render_worker(w);
+        }
+        return;
+    }
+
+    SkTaskGroup tg(*fExecutor);
+    tg.batch(workers, render_worker);
+    tg.wait();
+}
+
 } // namespace skottie_utils
@@ -8,6 +8,10 @@
 #ifndef SkottieUtils_DEFINED
 #define SkottieUtils_DEFINED
 
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSpan.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
@@ -17,6 +21,8 @@
 #include <unordered_map>
 #include <vector>
 
+class SkExecutor;
+
 namespace skottie_utils {
 
 /**
@@ -150,6 +156,50 @@ private:
     sk_sp<SlottablePropertyObserver> fPropertyObserver;
 };
 
+/**
+ * Renders frames of a single animation on multiple threads, for batch export.
+ *
+ * Animation instances are not thread safe, so each worker owns a separate instance built from
+ * the same JSON payload.  External resources are resolved once and shared between workers:
+ * data blobs, typefaces and static images are immutable, while multi-frame images and audio
+ * tracks carry playback state and are loaded for each worker.
+ */
+class ParallelFrameRenderer final {
+public:
+    /**
+     * @param json     Lottie JSON payload
+     * @param rp       resource provider for external assets (optional)
+     * @param threads  number of workers (0 -> cores count)
+     */
+    static std::unique_ptr<ParallelFrameRenderer> Make(sk_sp<SkData> json,
+                                                       sk_sp<skresources::ResourceProvider> rp,
+                                                       int threads = 0);
+    ~ParallelFrameRenderer();
+
+    // The first worker's animation, for querying size/duration/fps or single-threaded rendering.
+    const sk_sp<skottie::Animation>& animation() const { return fAnimations.front(); }
+
+    int workers() const { return static_cast<int>(fAnimations.size()); }
+
+    /**
+     * Renders frame (first_frame + i * frame_step) into dst[i], for each destination pixmap.
+     * Pixmaps are cleared to |background| and the animation is scaled to fill them.
+     *
+     * Frames are distributed round-robin, so each worker renders a disjoint, increasing
+     * sequence of frames.  Blocks until all frames are rendered.
+     */
+    void renderFrames(double first_frame, double frame_step, SkSpan<const SkPixmap> dst,
+                      SkColor background = SK_ColorWHITE);
+
+private:
+    class SharedResourceProvider;
+
+    ParallelFrameRenderer(std::vector<sk_sp<skottie::Animation>>, std::unique_ptr<SkExecutor>);
+
+    const std::vector<sk_sp<skottie::Animation>> fAnimations;
+    const std::unique_ptr<SkExecutor>            fExecutor;
+};
+
 } // namespace skottie_utils
 
 #endif // SkottieUtils_DEFINED
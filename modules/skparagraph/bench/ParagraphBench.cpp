@@ -13,6 +13,7 @@
 
 #include <cfloat>
 #include "include/core/SkPictureRecorder.h"
+#include "include/utils/SkRandom.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
 
 using namespace skia::textlayout;
@@ -46,13 +47,92 @@ struct ParagraphBench : public Benchmark {
         SkCanvas* canvas = rec.beginRecording({0,0, 2000,3000});
         while (loops-- > 0) {
             paragraph->layout(fWidth);
-            auto impl = static_cast<ParagraphImpl*>(paragraph.get());
             paragraph->paint(canvas, 0, 0);
             paragraph->markDirty();
-            impl->resetCache();
+            fontCollection->getParagraphCache()->reset();
         }
     }
 };
+
+// Lays out a stream of chat messages, each a new paragraph: the first-level paragraph cache never
+// hits, but senders, timestamps and the shorter replies repeat, so their shaped runs can be reused.
+struct ChatBench : public Benchmark {
+    explicit ChatBench(bool shapedRunCache) : fShapedRunCache(shapedRunCache) {}
+
+    const char* onGetName() override {
+        return fShapedRunCache ? "paragraph_chat" : "paragraph_chat_no_run_cache";
+    }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        fFontCollection = sk_make_sp<FontCollection>();
+        fFontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+        if (!fShapedRunCache) {
+            fFontCollection->getParagraphCache()->setShapedRunCacheBudget(0);
+        }
+
+        static const char* kSenders[] = { "Alice", "Bob", "Carol", "Dmitri", "Eve" };
+        static const char* kReplies[] = {
+            "ok", "thanks!", "lol", "see you there", "sounds good to me",
+            "Can you send me the slides from this morning?",
+            "I'm running about ten minutes late, start without me.",
+            "Did anyone else get the build failure on the release branch?",
+        };
+        SkRandom rand;
+        for (int i = 0; i < kMessages; ++i) {
+            Message& message = fMessages[i];
+            message.fSender = kSenders[rand.nextULessThan(std::size(kSenders))];
+            message.fTime.printf("%d:%02d", 9 + i / 60, i % 60);
+            message.fBody = kReplies[rand.nextULessThan(std::size(kReplies))];
+            if (rand.nextBool()) {
+                message.fBody.appendf(" %s", kReplies[rand.nextULessThan(std::size(kReplies))]);
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        ParagraphStyle paragraphStyle;
+        paragraphStyle.turnHintingOff();
+        TextStyle sender, time, body;
+        sender.setFontFamilies({SkString("Roboto")});
+        sender.setFontSize(14);
+        sender.setFontStyle(SkFontStyle::Bold());
+        time = sender;
+        time.setFontSize(11);
+        time.setFontStyle(SkFontStyle::Normal());
+        body = sender;
+        body.setFontStyle(SkFontStyle::Normal());
+
+        while (loops-- > 0) {
+            for (const Message& message : fMessages) {
+                ParagraphBuilderImpl builder(paragraphStyle, fFontCollection);
+                builder.pushStyle(sender);
+                builder.addText(message.fSender);
+                builder.pop();
+                builder.pushStyle(time);
+                builder.addText("  ");
+                builder.addText(message.fTime.c_str());
+                builder.addText("\n");
+                builder.pop();
+                builder.pushStyle(body);
+                builder.addText(message.fBody.c_str());
+                builder.pop();
+                builder.Build()->layout(300);
+            }
+        }
+    }
+
+    struct Message {
+        const char* fSender;
+        SkString fTime;
+        SkString fBody;
+    };
+    // More messages than the paragraph cache holds, so paragraphs never come from it.
+    static constexpr int kMessages = 240;
+    Message fMessages[kMessages];
+    bool fShapedRunCache;
+    sk_sp<FontCollection> fFontCollection;
+};
 }  // namespace
 
 #define PARAGRAPH_BENCH(X) DEF_BENCH(return new ParagraphBench(50000, "text/" #X ".txt", "paragraph_" #X);)
@@ -61,4 +141,7 @@ struct ParagraphBench : public Benchmark {
 PARAGRAPH_BENCH(english)
 #undef PARAGRAPH_BENCH
 
+DEF_BENCH(return new ChatBench(true);)
+DEF_BENCH(return new ChatBench(false);)
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
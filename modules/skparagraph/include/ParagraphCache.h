@@ -2,9 +2,15 @@
 #ifndef ParagraphCache_DEFINED
 #define ParagraphCache_DEFINED
 
+#include "include/core/SkFont.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkString.h"
 #include "include/private/SkMutex.h"
+#include "modules/skshaper/include/SkShaper.h"
 #include "src/core/SkLRUCache.h"
+#include <atomic>
 #include <functional>  // std::function
+#include <memory>
 
 #define PARAGRAPH_CACHE_STATS
 
@@ -35,6 +41,22 @@ public:
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
+    // The second-level cache: shaped runs, shared between paragraphs. Calls shape(), which must
+    // pass the handler it's given to the shaper, unless text with the same font, bidi level,
+    // locale and features has been shaped before (in any paragraph); then replays those runs into
+    // the handler instead. Safe to call from several threads at once.
+    using ShapeFunction = std::function<void(SkShaper::RunHandler*)>;
+    void shapeText(SkSpan<const char> utf8, const SkFont& font, uint8_t bidiLevel,
+                   const SkString& locale, SkSpan<const SkShaper::Feature> features,
+                   SkShaper::RunHandler* handler, const ShapeFunction& shape);
+
+    // The shaped run cache evicts its least recently used runs to stay within this many bytes.
+    void setShapedRunCacheBudget(size_t bytes);
+    size_t shapedRunCacheBudget() const { return fShapedRunBudget; }
+    size_t shapedRunCacheBytesUsed() const;
+    int shapedRunCacheHits() const { return fShapedRunHits; }
+    int shapedRunCacheMisses() const { return fShapedRunMisses; }
+
  private:
 
     struct Entry;
@@ -54,6 +76,16 @@ public:
     bool fCacheIsOn;
     ParagraphCacheValue* fLastCachedValue;
 
+    // Shaped runs are spread over several independently locked LRU caches by key hash, so that
+    // threads laying out different text rarely wait on each other.
+    static constexpr int kShapedRunShards = 16;
+    static constexpr size_t kDefaultShapedRunBudget = 4 * 1024 * 1024;
+    struct ShapedRunShard;
+    std::unique_ptr<ShapedRunShard[]> fShapedRunShards;
+    std::atomic<size_t> fShapedRunBudget;
+    std::atomic<int> fShapedRunHits;
+    std::atomic<int> fShapedRunMisses;
+
 #ifdef PARAGRAPH_CACHE_STATS
     int fTotalRequests;
     int fCacheMisses;
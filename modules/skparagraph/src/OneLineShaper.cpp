@@ -645,13 +645,6 @@ bool OneLineShaper::shape() {
                         continue;
                     }
                     auto unresolvedText = fParagraph->text(unresolvedRange);
-
-                    SkShaper::TrivialFontRunIterator fontIter(font, unresolvedText.size());
-                    LangIterator langIter(unresolvedText, blockSpan,
-                                      fParagraph->paragraphStyle().getTextStyle());
-                    SkShaper::TrivialBiDiRunIterator bidiIter(defaultBidiLevel, unresolvedText.size());
-                    auto scriptIter = SkShaper::MakeSkUnicodeHbScriptRunIterator(
-                            unresolvedText.begin(), unresolvedText.size());
                     fCurrentText = unresolvedRange;
 
                     // Map the block's features to subranges within the unresolved range.
@@ -665,10 +658,25 @@ bool OneLineShaper::shape() {
                         }
                     }
 
-                    shaper->shape(unresolvedText.begin(), unresolvedText.size(),
-                            fontIter, bidiIter,*scriptIter, langIter,
-                            adjustedFeatures.data(), adjustedFeatures.size(),
-                            limitlessWidth, this);
+                    // The same text may well have been shaped with this font before, by this or
+                    // another paragraph; the language comes from the block's style.
+                    fParagraph->fFontCollection->getParagraphCache()->shapeText(
+                            unresolvedText, font, defaultBidiLevel, block.fStyle.getLocale(),
+                            SkSpan<const SkShaper::Feature>(adjustedFeatures.data(),
+                                                            adjustedFeatures.size()),
+                            this,
+                            [&](SkShaper::RunHandler* handler) {
+                        SkShaper::TrivialFontRunIterator fontIter(font, unresolvedText.size());
+                        LangIterator langIter(unresolvedText, blockSpan,
+                                          fParagraph->paragraphStyle().getTextStyle());
+                        SkShaper::TrivialBiDiRunIterator bidiIter(defaultBidiLevel, unresolvedText.size());
+                        auto scriptIter = SkShaper::MakeSkUnicodeHbScriptRunIterator(
+                                unresolvedText.begin(), unresolvedText.size());
+                        shaper->shape(unresolvedText.begin(), unresolvedText.size(),
+                                fontIter, bidiIter,*scriptIter, langIter,
+                                adjustedFeatures.data(), adjustedFeatures.size(),
+                                limitlessWidth, handler);
+                    });
 
                     // Take off the queue the block we tried to resolved -
                     // whatever happened, we have now smaller pieces of it to deal with
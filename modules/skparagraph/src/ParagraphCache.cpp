@@ -1,5 +1,7 @@
 // Copyright 2019 Google LLC.
+#include <limits>
 #include <memory>
+#include <vector>
 
 #include "modules/skparagraph/include/FontArguments.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
@@ -22,6 +24,13 @@ namespace {
     bool exactlyEqual(SkScalar x, SkScalar y) {
         return x == y || (x != x && y != y);
     }
+
+    uint32_t mixHash(uint32_t hash, uint32_t data) {
+        hash += data;
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+        return hash;
+    }
 }  // namespace
 
 class ParagraphCacheKey {
@@ -96,6 +105,171 @@ public:
     TextIndex fTrailingSpaces;
 };
 
+// Everything that goes into shaping one piece of text: the script comes from the text itself.
+class ShapedRunKey {
+public:
+    ShapedRunKey(SkSpan<const char> utf8, const SkFont& font, uint8_t bidiLevel,
+                 const SkString& locale, SkSpan<const SkShaper::Feature> features)
+        : fText(utf8.data(), utf8.size())
+        , fFont(font)
+        , fBidiLevel(bidiLevel)
+        , fLocale(locale)
+        , fFeatures(features.begin(), features.end()) {
+        fHash = computeHash();
+    }
+
+    bool operator==(const ShapedRunKey& other) const;
+
+    uint32_t hash() const { return fHash; }
+
+    size_t bytesUsed() const {
+        return sizeof(*this) + fText.size() + fLocale.size() +
+               fFeatures.size() * sizeof(SkShaper::Feature);
+    }
+
+    struct Hash {
+        uint32_t operator()(const ShapedRunKey& key) const { return key.hash(); }
+    };
+
+private:
+    uint32_t computeHash() const;
+
+    SkString fText;
+    SkFont fFont;
+    uint8_t fBidiLevel;
+    SkString fLocale;
+    std::vector<SkShaper::Feature> fFeatures;
+    uint32_t fHash;
+};
+
+uint32_t ShapedRunKey::computeHash() const {
+    uint32_t hash = SkGoodHash()(fText);
+    hash = mixHash(hash, SkGoodHash()(fFont.getTypeface() ? fFont.getTypeface()->uniqueID() : 0));
+    hash = mixHash(hash, SkGoodHash()(fFont.getSize()));
+    hash = mixHash(hash, SkGoodHash()(fFont.getSkewX()));
+    hash = mixHash(hash, SkGoodHash()(fFont.isEmbolden() ? 1 : 0));
+    hash = mixHash(hash, SkGoodHash()(fBidiLevel));
+    hash = mixHash(hash, SkGoodHash()(fLocale));
+    for (auto& feature : fFeatures) {
+        hash = mixHash(hash, SkGoodHash()(feature.tag));
+        hash = mixHash(hash, SkGoodHash()(feature.value));
+        hash = mixHash(hash, SkGoodHash()(feature.start));
+        hash = mixHash(hash, SkGoodHash()(feature.end));
+    }
+    return hash;
+}
+
+bool ShapedRunKey::operator==(const ShapedRunKey& other) const {
+    if (fHash != other.fHash ||
+        fBidiLevel != other.fBidiLevel ||
+        fFont != other.fFont ||
+        fText != other.fText ||
+        fLocale != other.fLocale ||
+        fFeatures.size() != other.fFeatures.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < fFeatures.size(); ++i) {
+        auto& fa = fFeatures[i];
+        auto& fb = other.fFeatures[i];
+        if (fa.tag != fb.tag || fa.value != fb.value || fa.start != fb.start || fa.end != fb.end) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The runs the shaper produced for a ShapedRunKey, with positions relative to the run buffer's
+// point so they can be replayed anywhere in any paragraph.
+class ShapedRuns {
+public:
+    struct ShapedRun {
+        SkFont fFont;
+        uint8_t fBidiLevel;
+        SkVector fAdvance;
+        SkShaper::RunHandler::Range fUtf8Range;
+        std::vector<SkGlyphID> fGlyphs;
+        std::vector<SkPoint> fPositions;
+        std::vector<SkPoint> fOffsets;
+        std::vector<uint32_t> fClusters;
+    };
+
+    // Calls the handler exactly as the shaper did when these runs were recorded.
+    void replay(SkShaper::RunHandler* handler) const {
+        handler->beginLine();
+        for (auto& run : fRuns) {
+            handler->runInfo(runInfo(run));
+        }
+        handler->commitRunInfo();
+        for (auto& run : fRuns) {
+            const auto info = runInfo(run);
+            const auto buffer = handler->runBuffer(info);
+            for (size_t i = 0; i < run.fGlyphs.size(); ++i) {
+                buffer.glyphs[i] = run.fGlyphs[i];
+                if (buffer.offsets) {
+                    buffer.positions[i] = run.fPositions[i] + buffer.point;
+                    buffer.offsets[i] = run.fOffsets[i];
+                } else {
+                    buffer.positions[i] = run.fPositions[i] + buffer.point + run.fOffsets[i];
+                }
+                if (buffer.clusters) {
+                    buffer.clusters[i] = run.fClusters[i];
+                }
+            }
+            handler->commitRunBuffer(info);
+        }
+        handler->commitLine();
+    }
+
+    size_t bytesUsed() const {
+        size_t bytes = sizeof(*this);
+        for (auto& run : fRuns) {
+            bytes += sizeof(ShapedRun) + run.fGlyphs.size() * (sizeof(SkGlyphID) +
+                                                               2 * sizeof(SkPoint) +
+                                                               sizeof(uint32_t));
+        }
+        return bytes;
+    }
+
+    std::vector<ShapedRun> fRuns;
+
+private:
+    static SkShaper::RunHandler::RunInfo runInfo(const ShapedRun& run) {
+        return { run.fFont, run.fBidiLevel, run.fAdvance, run.fGlyphs.size(), run.fUtf8Range };
+    }
+};
+
+// Records the runs of a single line, as SkShaper::MakeShapeDontWrapOrReorder produces.
+class ShapedRunRecorder final : public SkShaper::RunHandler {
+public:
+    explicit ShapedRunRecorder(ShapedRuns* runs) : fRuns(runs) { }
+
+private:
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    void commitLine() override {}
+
+    Buffer runBuffer(const RunInfo& info) override {
+        auto& run = fRuns->fRuns.emplace_back();
+        run.fFont = info.fFont;
+        run.fBidiLevel = info.fBidiLevel;
+        run.fAdvance = info.fAdvance;
+        run.fUtf8Range = info.utf8Range;
+        run.fGlyphs.resize(info.glyphCount);
+        run.fPositions.resize(info.glyphCount);
+        run.fOffsets.resize(info.glyphCount);
+        run.fClusters.resize(info.glyphCount);
+        // Shaping at the origin means replaying only has to add the real buffer's point, which
+        // gives exactly what the shaper would have written there itself.
+        return {run.fGlyphs.data(), run.fPositions.data(), run.fOffsets.data(),
+                run.fClusters.data(), {0, 0}};
+    }
+
+    void commitRunBuffer(const RunInfo&) override {}
+
+    ShapedRuns* fRuns;
+};
+
 uint32_t ParagraphCacheKey::mix(uint32_t hash, uint32_t data) {
     hash += data;
     hash += (hash << 10);
@@ -239,11 +413,34 @@ struct ParagraphCache::Entry {
     std::unique_ptr<ParagraphCacheValue> fValue;
 };
 
+struct ParagraphCache::ShapedRunShard {
+    struct Entry {
+        std::shared_ptr<const ShapedRuns> fRuns;
+        size_t fBytesUsed;
+    };
+
+    ShapedRunShard() : fLRUCache(std::numeric_limits<int>::max()) {}
+
+    void purge(size_t budget) {
+        while (fBytesUsed > budget) {
+            fBytesUsed -= fLRUCache.removeLRU().fBytesUsed;
+        }
+    }
+
+    SkMutex fMutex;
+    SkLRUCache<ShapedRunKey, Entry, ShapedRunKey::Hash> fLRUCache;
+    size_t fBytesUsed = 0;
+};
+
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
     , fLRUCacheMap(kMaxEntries)
     , fCacheIsOn(true)
     , fLastCachedValue(nullptr)
+    , fShapedRunShards(new ShapedRunShard[kShapedRunShards])
+    , fShapedRunBudget(kDefaultShapedRunBudget)
+    , fShapedRunHits(0)
+    , fShapedRunMisses(0)
 #ifdef PARAGRAPH_CACHE_STATS
     , fTotalRequests(0)
     , fCacheMisses(0)
@@ -282,6 +479,11 @@ void ParagraphCache::printStatistics() {
     SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
     int cacheHits = fTotalRequests - fCacheMisses;
     SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    int shapedRunRequests = fShapedRunHits + fShapedRunMisses;
+    SkDebugf("Shaped run requests: %d\n", shapedRunRequests);
+    SkDebugf("Shaped run hit %%: %f\n",
+             (shapedRunRequests > 0) ? 100.f * fShapedRunHits / shapedRunRequests : 0.f);
+    SkDebugf("Shaped run bytes: %zu\n", this->shapedRunCacheBytesUsed());
     SkDebugf("---------------------\n");
 }
 
@@ -298,6 +500,15 @@ void ParagraphCache::reset() {
 #endif
     fLRUCacheMap.reset();
     fLastCachedValue = nullptr;
+
+    for (int i = 0; i < kShapedRunShards; ++i) {
+        auto& shard = fShapedRunShards[i];
+        SkAutoMutexExclusive shardLock(shard.fMutex);
+        shard.fLRUCache.reset();
+        shard.fBytesUsed = 0;
+    }
+    fShapedRunHits = 0;
+    fShapedRunMisses = 0;
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -380,5 +591,72 @@ bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
     // It does not look like editing the text
     return false;
 }
+
+void ParagraphCache::shapeText(SkSpan<const char> utf8, const SkFont& font, uint8_t bidiLevel,
+                               const SkString& locale, SkSpan<const SkShaper::Feature> features,
+                               SkShaper::RunHandler* handler, const ShapeFunction& shape) {
+    if (!fCacheIsOn || fShapedRunBudget == 0) {
+        shape(handler);
+        return;
+    }
+
+    ShapedRunKey key(utf8, font, bidiLevel, locale, features);
+    // The shard's own hash table uses the low bits of the hash; pick the shard with the high bits.
+    auto& shard = fShapedRunShards[key.hash() >> 28];
+    static_assert(kShapedRunShards == 16);
+
+    std::shared_ptr<const ShapedRuns> runs;
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (auto entry = shard.fLRUCache.find(key)) {
+            runs = entry->fRuns;
+        }
+    }
+    if (runs) {
+        ++fShapedRunHits;
+        runs->replay(handler);
+        return;
+    }
+    ++fShapedRunMisses;
+
+    // Shape without holding the lock; if another thread shapes the same text meanwhile, the first
+    // one to finish is kept.
+    auto recorded = std::make_shared<ShapedRuns>();
+    ShapedRunRecorder recorder(recorded.get());
+    shape(&recorder);
+    recorded->replay(handler);
+
+    const size_t bytesUsed = key.bytesUsed() + recorded->bytesUsed();
+    const size_t shardBudget = fShapedRunBudget / kShapedRunShards;
+    if (bytesUsed > shardBudget) {
+        return;
+    }
+    SkAutoMutexExclusive lock(shard.fMutex);
+    if (!shard.fLRUCache.find(key)) {
+        shard.fLRUCache.insert(key, {std::move(recorded), bytesUsed});
+        shard.fBytesUsed += bytesUsed;
+        shard.purge(shardBudget);
+    }
+}
+
+void ParagraphCache::setShapedRunCacheBudget(size_t bytes) {
+    fShapedRunBudget = bytes;
+    for (int i = 0; i < kShapedRunShards; ++i) {
+        auto& shard = fShapedRunShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.purge(bytes / kShapedRunShards);
+    }
+}
+
+size_t ParagraphCache::shapedRunCacheBytesUsed() const {
+    size_t bytesUsed = 0;
+    for (int i = 0; i < kShapedRunShards; ++i) {
+        auto& shard = fShapedRunShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        bytesUsed += shard.fBytesUsed;
+    }
+    return bytesUsed;
+}
+
 }  // namespace textlayout
 }  // namespace skia
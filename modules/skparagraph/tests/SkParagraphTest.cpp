@@ -7273,3 +7273,79 @@ DEF_TEST(SkParagraph_lineMetricsAfterUpdate, reporter) {
     paragraph->getLineMetrics(lm);
     REPORTER_ASSERT(reporter, lm.size() == 2);
 }
+
+UNIX_ONLY_TEST(SkParagraph_ShapedRunCache, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+    sk_sp<ResourceFontCollection> uncachedCollection = sk_make_sp<ResourceFontCollection>();
+    uncachedCollection->getParagraphCache()->setShapedRunCacheBudget(0);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+    TextStyle bold_style = text_style;
+    bold_style.setFontStyle(SkFontStyle::Bold());
+
+    auto layout = [&](sk_sp<FontCollection> collection, const char* text) {
+        TestParagraphBuilderImpl builder(paragraph_style, collection);
+        builder.pushStyle(text_style);
+        builder.addText(text);
+        builder.pop();
+        builder.pushStyle(bold_style);
+        builder.addText("Alice");
+        builder.pop();
+        auto paragraph = builder.Build();
+        paragraph->layout(TestCanvasWidth);
+        return paragraph;
+    };
+
+    auto cache = fontCollection->getParagraphCache();
+    auto first = layout(fontCollection, "hello ");
+    REPORTER_ASSERT(reporter, cache->shapedRunCacheHits() == 0);
+    REPORTER_ASSERT(reporter, cache->shapedRunCacheMisses() == 2);
+    REPORTER_ASSERT(reporter, cache->shapedRunCacheBytesUsed() > 0);
+
+    // A different paragraph, so it isn't in the paragraph cache, but "Alice" has been shaped.
+    auto second = layout(fontCollection, "hi ");
+    REPORTER_ASSERT(reporter, cache->shapedRunCacheHits() == 1);
+    REPORTER_ASSERT(reporter, cache->shapedRunCacheMisses() == 3);
+
+    // The reused run, at its new offset, must match one shaped from scratch.
+    auto expected = layout(uncachedCollection, "hi ");
+    // With no budget the cache is bypassed entirely: no lookups, no recording.
+    auto uncached = uncachedCollection->getParagraphCache();
+    REPORTER_ASSERT(reporter, uncached->shapedRunCacheHits() == 0);
+    REPORTER_ASSERT(reporter, uncached->shapedRunCacheMisses() == 0);
+    REPORTER_ASSERT(reporter, uncached->shapedRunCacheBytesUsed() == 0);
+    auto runs = static_cast<ParagraphImpl*>(second.get())->runs();
+    auto expectedRuns = static_cast<ParagraphImpl*>(expected.get())->runs();
+    REPORTER_ASSERT(reporter, runs.size() == 2 && expectedRuns.size() == 2);
+    for (size_t r = 0; r < std::min(runs.size(), expectedRuns.size()); ++r) {
+        auto& run = runs[r];
+        auto& expectedRun = expectedRuns[r];
+        REPORTER_ASSERT(reporter, run.textRange() == expectedRun.textRange());
+        REPORTER_ASSERT(reporter, run.size() == expectedRun.size());
+        for (size_t i = 0; i < std::min(run.size(), expectedRun.size()); ++i) {
+            REPORTER_ASSERT(reporter, run.glyphs()[i] == expectedRun.glyphs()[i]);
+            REPORTER_ASSERT(reporter, run.positions()[i] == expectedRun.positions()[i]);
+            REPORTER_ASSERT(reporter, run.offsets()[i] == expectedRun.offsets()[i]);
+            REPORTER_ASSERT(reporter, run.clusterIndexes()[i] == expectedRun.clusterIndexes()[i]);
+        }
+    }
+    REPORTER_ASSERT(reporter, second->getMaxIntrinsicWidth() == expected->getMaxIntrinsicWidth());
+
+    // A stream of distinct messages from the same sender, as in a chat: every paragraph misses
+    // the paragraph cache, and each one shapes its body but reuses the sender's run.
+    const int hits = cache->shapedRunCacheHits(),
+              misses = cache->shapedRunCacheMisses();
+    for (int i = 0; i < 20; ++i) {
+        layout(fontCollection, SkStringPrintf("message %d ", i).c_str());
+    }
+    REPORTER_ASSERT(reporter, cache->shapedRunCacheHits() == hits + 20);
+    REPORTER_ASSERT(reporter, cache->shapedRunCacheMisses() == misses + 20);
+
+    cache->setShapedRunCacheBudget(0);
+    REPORTER_ASSERT(reporter, cache->shapedRunCacheBytesUsed() == 0);
+}
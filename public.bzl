@@ -223,6 +223,7 @@ SKIA_PUBLIC_HDRS = [
     "include/utils/SkRandom.h",
     "include/utils/SkShadowUtils.h",
     "include/utils/SkTextUtils.h",
+    "include/utils/SkTiledRasterizer.h",
     "include/utils/SkTraceEventPhase.h",
     "include/utils/mac/SkCGUtils.h",
 ]
@@ -1659,6 +1660,7 @@ BASE_SRCS_ALL = [
     "src/utils/SkShadowUtils.cpp",
     "src/utils/SkTestCanvas.h",
     "src/utils/SkTextUtils.cpp",
+    "src/utils/SkTiledRasterizer.cpp",
     "src/utils/SkUTF.cpp",
     "src/utils/SkUTF.h",
     "src/utils/SkVMVisualizer.cpp",
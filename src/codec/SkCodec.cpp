@@ -27,6 +27,7 @@
 #include "src/codec/SkBmpCodec.h"
 #include "src/codec/SkWbmpCodec.h"
 
+#include <algorithm>
 #include <utility>
 
 #ifdef SK_HAS_ANDROID_CODEC
@@ -658,6 +659,109 @@ bool SkCodec::skipScanlines(int countLines) {
     return result;
 }
 
+SkCodec::Result SkCodec::decodeStrips(const SkImageInfo& info, int stripHeight,
+                                      const StripProc& proc, const Options* options) {
+    if (info.isEmpty() || stripHeight <= 0 || !proc || (options && options->fSubset)) {
+        return kInvalidParameters;
+    }
+    stripHeight = std::min(stripHeight, info.height());
+
+    // Decodes the whole image and hands it out a strip at a time, starting at firstTop.
+    auto decodeImage = [&](int firstTop) {
+        SkBitmap image;
+        if (!image.tryAllocPixels(info)) {
+            return kInternalError;
+        }
+        Result result = this->getPixels(image.pixmap(), options);
+        if (result != kSuccess && result != kIncompleteInput && result != kErrorInInput) {
+            return result;
+        }
+        for (int top = firstTop; top < info.height(); top += stripHeight) {
+            const int rows = std::min(stripHeight, info.height() - top);
+            SkPixmap pixels;
+            SkAssertResult(image.pixmap().extractSubset(
+                    &pixels, SkIRect::MakeXYWH(0, top, info.width(), rows)));
+            if (!proc(pixels, top)) {
+                return kSuccess;
+            }
+        }
+        return result;
+    };
+
+    // With a top-down scanline decoder, each strip can reuse the same buffer.
+    Result result = this->startScanlineDecode(info, options);
+    if (result == kSuccess && this->getScanlineOrder() == kTopDown_SkScanlineOrder) {
+        SkBitmap strip;
+        if (!strip.tryAllocPixels(info.makeWH(info.width(), stripHeight))) {
+            return kInternalError;
+        }
+
+        for (int top = 0; top < info.height(); top += stripHeight) {
+            const int rows = std::min(stripHeight, info.height() - top);
+            if (this->getScanlines(strip.getPixels(), rows, strip.rowBytes()) < rows) {
+                // The scanline decoder can't say whether the data ran out or was corrupt. Only
+                // getPixels() reports that, and it fills in the missing rows the same way, so
+                // let it decode the image again and hand out the rest of the strips.
+                return decodeImage(top);
+            }
+            SkPixmap pixels;
+            SkAssertResult(strip.pixmap().extractSubset(&pixels,
+                                                        SkIRect::MakeWH(info.width(), rows)));
+            if (!proc(pixels, top)) {
+                return kSuccess;
+            }
+        }
+        return kSuccess;
+    }
+    if (result != kSuccess && result != kUnimplemented) {
+        return result;
+    }
+
+    // So can codecs which decode strips themselves, with the same set up as getPixels().
+    Options optsStorage;
+    const Options& opts = options ? *options : optsStorage;
+    if (opts.fFrameIndex == 0) {
+        SkBitmap strip;
+        if (!strip.tryAllocPixels(info.makeWH(info.width(), stripHeight))) {
+            return kInternalError;
+        }
+        result = this->handleFrameIndex(info, strip.getPixels(), strip.rowBytes(), opts);
+        if (result != kSuccess) {
+            return result;
+        }
+        if (!this->dimensionsSupported(info.dimensions())) {
+            return kInvalidScale;
+        }
+        fDstInfo = info;
+        fOptions = opts;
+
+        int rowsDecoded = 0;
+        result = this->onDecodeStrips(info, strip.pixmap(), proc, opts, &rowsDecoded);
+        if (result == kIncompleteInput || result == kErrorInInput) {
+            // Fill the rest of the strip the decode stopped in, and the strips after it, the
+            // same way getPixels() fills the rest of the image.
+            int top = rowsDecoded / stripHeight * stripHeight;
+            for (rowsDecoded -= top; top < info.height(); top += stripHeight, rowsDecoded = 0) {
+                const int rows = std::min(stripHeight, info.height() - top);
+                this->fillIncompleteImage(info, strip.getPixels(), strip.rowBytes(),
+                                          kNo_ZeroInitialized, rows, rowsDecoded);
+                SkPixmap pixels;
+                SkAssertResult(strip.pixmap().extractSubset(&pixels,
+                                                            SkIRect::MakeWH(info.width(), rows)));
+                if (!proc(pixels, top)) {
+                    return kSuccess;
+                }
+            }
+        }
+        if (result != kUnimplemented) {
+            return result;
+        }
+    }
+
+    // Otherwise decode the whole image and hand it out a strip at a time.
+    return decodeImage(0);
+}
+
 int SkCodec::outputScanline(int inputScanline) const {
     SkASSERT(0 <= inputScanline && inputScanline < fEncodedInfo.height());
     return this->onOutputScanline(inputScanline);
@@ -12,6 +12,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkPngChunkReader.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
@@ -511,6 +512,9 @@ public:
         , fRowBytes(0)
         , fFirstRow(0)
         , fLastRow(0)
+        , fStrip(nullptr)
+        , fStripProc(nullptr)
+        , fStripProcStopped(false)
     {}
 
     static void AllRowsCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum, int /*pass*/) {
@@ -521,11 +525,21 @@ public:
         GetDecoder(png_ptr)->rowCallback(row, rowNum);
     }
 
+    static void StripRowCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum,
+                                 int /*pass*/) {
+        GetDecoder(png_ptr)->stripRowCallback(row, rowNum);
+    }
+
 private:
     int                         fRowsWrittenToOutput;
     void*                       fDst;
     size_t                      fRowBytes;
 
+    // Variables for strip decode
+    const SkPixmap*             fStrip;
+    const StripProc*            fStripProc;
+    bool                        fStripProcStopped;
+
     // Variables for partial decode
     int                         fFirstRow;  // FIXME: Move to baseclass?
     int                         fLastRow;
@@ -566,6 +580,59 @@ private:
         fDst = SkTAddOffset<void>(fDst, fRowBytes);
     }
 
+    Result decodeAllRowsInStrips(const SkPixmap& strip, const StripProc& proc,
+                                 int* rowsDecoded) override {
+        const int height = this->dimensions().height();
+        png_set_progressive_read_fn(this->png_ptr(), this, nullptr, StripRowCallback, nullptr);
+        fStrip = &strip;
+        fStripProc = &proc;
+        fStripProcStopped = false;
+        fDst = strip.writable_addr();
+        fRowBytes = strip.rowBytes();
+
+        fRowsWrittenToOutput = 0;
+        fFirstRow = 0;
+        fLastRow = height - 1;
+
+        const bool success = this->processData();
+        if (fStripProcStopped || (success && fRowsWrittenToOutput == height)) {
+            return kSuccess;
+        }
+
+        *rowsDecoded = fRowsWrittenToOutput;
+        return log_and_return_error(success);
+    }
+
+    void stripRowCallback(png_bytep row, int rowNum) {
+        SkASSERT(rowNum == fRowsWrittenToOutput);
+        fRowsWrittenToOutput++;
+        this->applyXformRow(fDst, row);
+        fDst = SkTAddOffset<void>(fDst, fRowBytes);
+
+        const int rows = fRowsWrittenToOutput % fStrip->height();
+        if (rows && fRowsWrittenToOutput != this->dimensions().height()) {
+            return;
+        }
+
+        // The strip is full (or this was the last row): hand it out, and start over at its top.
+        bool keepDecoding;
+        {
+            const int top = (fRowsWrittenToOutput - 1) / fStrip->height() * fStrip->height();
+            SkPixmap pixels;
+            SkAssertResult(fStrip->extractSubset(&pixels, SkIRect::MakeWH(
+                    fStrip->width(), rows ? rows : fStrip->height())));
+            keepDecoding = (*fStripProc)(pixels, top);
+        }
+        fDst = fStrip->writable_addr();
+
+        if (!keepDecoding) {
+            fStripProcStopped = true;
+            // Fake error to stop decoding. The pixmap is out of scope, as longjmp skips
+            // destructors.
+            longjmp(PNG_JMPBUF(this->png_ptr()), kStopDecoding);
+        }
+    }
+
     void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) override {
         png_set_progressive_read_fn(this->png_ptr(), this, nullptr, RowCallback, nullptr);
         fFirstRow = firstRow;
@@ -764,6 +831,11 @@ private:
         return log_and_return_error(success);
     }
 
+    Result decodeAllRowsInStrips(const SkPixmap&, const StripProc&, int*) override {
+        // Each row is only final after the last pass, so they would all have to be kept.
+        return kUnimplemented;
+    }
+
     void setUpInterlaceBuffer(int height) {
         fPng_rowbytes = png_get_rowbytes(this->png_ptr(), this->info_ptr());
         fInterlaceBuffer.reset(fPng_rowbytes * height);
@@ -1180,6 +1252,19 @@ SkCodec::Result SkPngCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
     return this->decodeAllRows(dst, rowBytes, rowsDecoded);
 }
 
+SkCodec::Result SkPngCodec::onDecodeStrips(const SkImageInfo& dstInfo, const SkPixmap& strip,
+                                           const StripProc& proc, const Options& options,
+                                           int* rowsDecoded) {
+    Result result = this->initializeXforms(dstInfo, options);
+    if (kSuccess != result) {
+        return result;
+    }
+
+    this->allocateStorage(dstInfo);
+    this->initializeXformParams();
+    return this->decodeAllRowsInStrips(strip, proc, rowsDecoded);
+}
+
 SkCodec::Result SkPngCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo,
         void* dst, size_t rowBytes, const SkCodec::Options& options) {
     Result result = this->initializeXforms(dstInfo, options);
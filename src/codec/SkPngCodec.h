@@ -82,6 +82,9 @@ protected:
             const SkCodec::Options&) override;
     Result onIncrementalDecode(int*) override;
 
+    Result onDecodeStrips(const SkImageInfo& dstInfo, const SkPixmap& strip, const StripProc&,
+                          const Options&, int* rowsDecoded) override;
+
     sk_sp<SkPngChunkReader>     fPngChunkReader;
     voidp                       fPng_ptr;
     voidp                       fInfo_ptr;
@@ -116,6 +119,8 @@ private:
     virtual Result decodeAllRows(void* dst, size_t rowBytes, int* rowsDecoded) = 0;
     virtual void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) = 0;
     virtual Result decode(int* rowsDecoded) = 0;
+    virtual Result decodeAllRowsInStrips(const SkPixmap& strip, const StripProc&,
+                                         int* rowsDecoded) = 0;
 
     XformMode                      fXformMode;
     int                            fXformWidth;
@@ -58,6 +58,7 @@ class SkDrawTiler {
     // fCurr... are only used if fNeedTiling
     SkTLazy<SkPostTranslateMatrixProvider> fTileMatrixProvider;
     SkRasterClip                           fTileRC;
+    SkIRect                                fTileBlitBounds;
     SkIPoint                               fOrigin;
 
     bool            fDone, fNeedsTiling;
@@ -120,6 +121,9 @@ public:
         }
 
         fDraw.fProps = &fDevice->surfaceProps();
+        if (dev->fBlitBounds) {
+            fDraw.fBlitBounds = fNeedsTiling ? &fTileBlitBounds : &*dev->fBlitBounds;
+        }
     }
 
     bool needsTiling() const { return fNeedsTiling; }
@@ -172,6 +176,9 @@ private:
         fDevice->fRCStack.rc().translate(-fOrigin.x(), -fOrigin.y(), &fTileRC);
         fTileRC.op(SkIRect::MakeWH(fDraw.fDst.width(), fDraw.fDst.height()),
                    SkClipOp::kIntersect);
+        if (fDevice->fBlitBounds) {
+            fTileBlitBounds = fDevice->fBlitBounds->makeOffset(-fOrigin.x(), -fOrigin.y());
+        }
     }
 };
 
@@ -196,6 +203,9 @@ public:
         }
         fMatrixProvider = dev;
         fRC = &dev->fRCStack.rc();
+        if (dev->fBlitBounds) {
+            fBlitBounds = &*dev->fBlitBounds;
+        }
     }
 };
 
@@ -584,6 +594,9 @@ void SkBitmapDevice::drawSpecial(SkSpecialImage* src,
         }
         draw.fMatrixProvider = &matrixProvider;
         draw.fRC = &fRCStack.rc();
+        if (fBlitBounds) {
+            draw.fBlitBounds = &*fBlitBounds;
+        }
         draw.drawBitmap(resultBM, SkMatrix::I(), nullptr, sampling, paint);
     }
 }
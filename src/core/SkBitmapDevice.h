@@ -20,6 +20,8 @@
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRasterClipStack.h"
 
+#include <optional>
+
 class SkImageFilterCache;
 class SkMatrix;
 class SkPaint;
@@ -61,6 +63,15 @@ public:
     static SkBitmapDevice* Create(const SkImageInfo&, const SkSurfaceProps&,
                                   SkRasterHandleAllocator* = nullptr);
 
+    /**
+     *  Only let subsequent draws write the pixels inside bounds (in device space). Unlike a clip
+     *  this does not change how anything is rasterized: each draw computes exactly what it would
+     *  for the whole device, and the blits that fall outside of bounds are dropped. The one
+     *  exception is the outermost ring of pixels in bounds, which may round slightly differently
+     *  (see SkDraw::restrictBlitter()). Devices this one creates for layers are not restricted.
+     */
+    void setBlitBounds(const SkIRect& bounds) { fBlitBounds = bounds; }
+
 protected:
     void* getRasterHandle() const override { return fRasterHandle; }
 
@@ -157,6 +168,7 @@ private:
     SkBitmap    fBitmap;
     void*       fRasterHandle = nullptr;
     SkRasterClipStack  fRCStack;
+    std::optional<SkIRect> fBlitBounds;
     SkGlyphRunListPainterCPU fGlyphPainter;
 
 
@@ -53,8 +53,82 @@ static SkPaint make_paint_with_image(const SkPaint& origPaint, const SkBitmap& b
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// Like SkRectClipBlitter, but any blit that lies entirely inside the bounds is passed on
+// untouched, so those pixels come out exactly as if there were no bounds. Only the paired
+// blits that straddle the edge of the bounds (blitAntiH2(), blitAntiV2(), blitAntiRect()) get
+// broken up into simpler ones, which may round a little differently.
+class BlitBoundsBlitter final : public SkBlitter {
+public:
+    BlitBoundsBlitter(SkBlitter* blitter, const SkIRect& bounds)
+            : fBlitter(blitter), fBounds(bounds) {
+        fClipper.init(blitter, bounds);
+    }
+
+    void blitH(int x, int y, int width) override { fClipper.blitH(x, y, width); }
+    void blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) override {
+        fClipper.blitAntiH(x, y, aa, runs);
+    }
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        fClipper.blitV(x, y, height, alpha);
+    }
+    void blitRect(int x, int y, int width, int height) override {
+        fClipper.blitRect(x, y, width, height);
+    }
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        fClipper.blitMask(mask, clip);
+    }
+
+    void blitAntiRect(int x, int y, int width, int height,
+                      SkAlpha leftAlpha, SkAlpha rightAlpha) override {
+        if (fBounds.contains(SkIRect::MakeXYWH(x, y, width + 2, height))) {
+            fBlitter->blitAntiRect(x, y, width, height, leftAlpha, rightAlpha);
+        } else {
+            this->SkBlitter::blitAntiRect(x, y, width, height, leftAlpha, rightAlpha);
+        }
+    }
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override {
+        if (fBounds.contains(SkIRect::MakeXYWH(x, y, 2, 1))) {
+            fBlitter->blitAntiH2(x, y, a0, a1);
+        } else {
+            this->SkBlitter::blitAntiH2(x, y, a0, a1);
+        }
+    }
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override {
+        if (fBounds.contains(SkIRect::MakeXYWH(x, y, 1, 2))) {
+            fBlitter->blitAntiV2(x, y, a0, a1);
+        } else {
+            this->SkBlitter::blitAntiV2(x, y, a0, a1);
+        }
+    }
+
+    // Handing out the pixels would let the caller write outside of fBounds.
+    const SkPixmap* justAnOpaqueColor(uint32_t*) override { return nullptr; }
+
+    int requestRowsPreserved() const override { return fBlitter->requestRowsPreserved(); }
+    void* allocBlitMemory(size_t sz) override { return fBlitter->allocBlitMemory(sz); }
+
+private:
+    SkBlitter*        fBlitter;
+    const SkIRect     fBounds;
+    SkRectClipBlitter fClipper;
+};
+
+}  // namespace
+
 SkDraw::SkDraw() {}
 
+SkBlitter* SkDraw::restrictBlitter(SkBlitter* blitter, SkArenaAlloc* alloc) const {
+    if (!blitter || !fBlitBounds) {
+        return blitter;
+    }
+    if (fBlitBounds->isEmpty()) {
+        return alloc->make<SkNullBlitter>();
+    }
+    return alloc->make<BlitBoundsBlitter>(blitter, *fBlitBounds);
+}
+
 bool SkDraw::computeConservativeLocalClipBounds(SkRect* localBounds) const {
     if (fRC->isEmpty()) {
         return false;
@@ -1103,8 +1177,10 @@ void SkDraw::drawBitmap(const SkBitmap& bitmap, const SkMatrix& prematrix,
         if (clipHandlesSprite(*fRC, ix, iy, pmap)) {
             SkSTArenaAlloc<kSkBlitterContextSize> allocator;
             // blitter will be owned by the allocator.
-            SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, *paint, pmap, ix, iy, &allocator,
-                                                         fRC->clipShader());
+            SkBlitter* blitter = this->restrictBlitter(
+                    SkBlitter::ChooseSprite(fDst, *paint, pmap, ix, iy, &allocator,
+                                            fRC->clipShader()),
+                    &allocator);
             if (blitter) {
                 SkScan::FillIRect(SkIRect::MakeXYWH(ix, iy, pmap.width(), pmap.height()),
                                   *fRC, blitter);
@@ -1165,8 +1241,9 @@ void SkDraw::drawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint& ori
     if (nullptr == paint.getColorFilter() && clipHandlesSprite(*fRC, x, y, pmap)) {
         // blitter will be owned by the allocator.
         SkSTArenaAlloc<kSkBlitterContextSize> allocator;
-        SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, paint, pmap, x, y, &allocator,
-                                                     fRC->clipShader());
+        SkBlitter* blitter = this->restrictBlitter(
+                SkBlitter::ChooseSprite(fDst, paint, pmap, x, y, &allocator, fRC->clipShader()),
+                &allocator);
         if (blitter) {
             SkScan::FillIRect(bounds, *fRC, blitter);
             return;
@@ -17,6 +17,7 @@
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkMask.h"
 
+class SkArenaAlloc;
 class SkBitmap;
 class SkClipStack;
 class SkBaseDevice;
@@ -125,6 +126,14 @@ public:
     static RectType ComputeRectType(const SkRect&, const SkPaint&, const SkMatrix&,
                                     SkPoint* strokeSize);
 
+    /**
+     *  If fBlitBounds is set, returns a blitter (allocated from alloc) that passes on only the
+     *  parts of each blit that land inside fBlitBounds. Blits entirely inside are passed on
+     *  untouched, but the few that combine two pixels and straddle the edge are split up, so
+     *  the outermost ring of pixels may be off by a bit. Otherwise returns the blitter unchanged.
+     */
+    SkBlitter* restrictBlitter(SkBlitter*, SkArenaAlloc*) const;
+
 private:
 #if defined(SK_SUPPORT_LEGACY_ALPHA_BITMAP_AS_COVERAGE)
     void drawBitmapAsMask(const SkBitmap&, const SkSamplingOptions&, const SkPaint&) const;
@@ -167,6 +176,10 @@ public:
     const SkMatrixProvider* fMatrixProvider{nullptr};  // required
     const SkRasterClip*     fRC{nullptr};              // required
     const SkSurfaceProps*   fProps{nullptr};           // optional
+    // Unlike fRC, this does not affect how anything is rasterized; it only discards the blits
+    // that fall outside of it. Pixels along its edge may round differently than they would
+    // without it (see restrictBlitter()).
+    const SkIRect*          fBlitBounds{nullptr};      // optional
 
 #ifdef SK_DEBUG
     void validate() const;
@@ -158,8 +158,10 @@ void SkDraw::drawAtlas(const SkRSXform xform[],
             isOpaque = false;
         }
 
-        auto blitter = SkCreateRasterPipelineBlitter(
-                fDst, p, pipeline, isOpaque, &alloc, fRC->clipShader());
+        SkBlitter* blitter = this->restrictBlitter(
+                SkCreateRasterPipelineBlitter(fDst, p, pipeline, isOpaque, &alloc,
+                                              fRC->clipShader()),
+                &alloc);
         if (!blitter) {
             return false;
         }
@@ -197,8 +199,9 @@ void SkDraw::drawAtlas(const SkRSXform xform[],
             shader = sk_ref_sp(updateShader);
         }
         p.setShader(std::move(shader));
-        if (auto blitter = SkVMBlitter::Make(fDst, p, *fMatrixProvider, &alloc,
-                                             fRC->clipShader())) {
+        if (SkBlitter* blitter = this->restrictBlitter(
+                    SkVMBlitter::Make(fDst, p, *fMatrixProvider, &alloc, fRC->clipShader()),
+                    &alloc)) {
             SkPath scratchPath;
             for (int i = 0; i < count; ++i) {
                 if (colorShader) {
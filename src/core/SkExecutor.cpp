@@ -10,6 +10,7 @@
 #include "include/private/SkSemaphore.h"
 #include "include/private/SkSpinlock.h"
 #include "include/private/SkTArray.h"
+#include <atomic>
 #include <deque>
 #include <thread>
 
@@ -27,6 +28,18 @@
     }
 #endif
 
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #include <sched.h>
+    static void pin_to_core(int core) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core % num_cores(), &set);
+        (void)sched_setaffinity(0, sizeof(set), &set);  // Best effort.
+    }
+#else
+    static void pin_to_core(int) {}
+#endif
+
 SkExecutor::~SkExecutor() {}
 
 // The default default SkExecutor is an SkTrivialExecutor, which just runs the work right away.
@@ -139,6 +152,149 @@ private:
     bool                  fAllowBorrowing;
 };
 
+// An SkWorkStealingPool gives each thread its own list of work, so threads only contend when
+// they add work to or steal work from the same list.
+//
+// A pool thread pushes work onto the back of its own list and pops it back off LIFO, keeping
+// nested SkTaskGroup work on the thread (and in the cache) that made it.  Other threads add work
+// round-robin.  A thread that runs out of work steals the older half of another thread's list.
+class SkWorkStealingPool final : public SkExecutor {
+public:
+    SkWorkStealingPool(int threads, bool allowBorrowing, bool pinThreads)
+        : fLists(new WorkList[threads])
+        , fListCount(threads)
+        , fAllowBorrowing(allowBorrowing) {
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back(&Loop, this, i, pinThreads);
+        }
+    }
+
+    ~SkWorkStealingPool() override {
+        // Wake each thread.  Any that can't find work will see fShuttingDown and exit.
+        fShuttingDown.store(true, std::memory_order_relaxed);
+        fWorkAvailable.signal(fThreads.size());
+        for (int i = 0; i < fThreads.size(); i++) {
+            fThreads[i].join();
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        int index = gCurrentPool == this
+                  ? gCurrentIndex
+                  : (int)(fNextList.fetch_add(1, std::memory_order_relaxed) % fListCount);
+        {
+            SkAutoMutexExclusive lock(fLists[index].fLock);
+            fLists[index].fWork.emplace_back(std::move(work));
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        // If there is work waiting and we're allowed to borrow work, do it.
+        if (fAllowBorrowing && fWorkAvailable.try_wait()) {
+            std::function<void(void)> work = this->take(gCurrentPool == this ? gCurrentIndex : -1);
+            SkASSERT(work);
+            work();
+        }
+    }
+
+private:
+    struct alignas(64) WorkList {
+        SkMutex                               fLock;
+        std::deque<std::function<void(void)>> fWork;
+    };
+
+    bool pop(int index, std::function<void(void)>* work) {
+        SkAutoMutexExclusive lock(fLists[index].fLock);
+        if (fLists[index].fWork.empty()) {
+            return false;
+        }
+        *work = std::move(fLists[index].fWork.back());
+        fLists[index].fWork.pop_back();
+        return true;
+    }
+
+    // Take the older half of victim's work.  Return one piece in work, moving the rest to thief's
+    // list.  A thief of -1 (a borrowing thread) takes just one piece.
+    bool steal(int victim, int thief, std::function<void(void)>* work) {
+        SkSTArray<8, std::function<void(void)>> stolen;
+        {
+            SkAutoMutexExclusive lock(fLists[victim].fLock);
+            auto& list = fLists[victim].fWork;
+            size_t n = thief < 0 ? std::min<size_t>(list.size(), 1) : (list.size() + 1) / 2;
+            for (size_t i = 0; i < n; i++) {
+                stolen.push_back(std::move(list.front()));
+                list.pop_front();
+            }
+        }
+        if (stolen.empty()) {
+            return false;
+        }
+        *work = std::move(stolen.front());
+        if (stolen.size() > 1) {
+            SkAutoMutexExclusive lock(fLists[thief].fLock);
+            for (int i = 1; i < stolen.size(); i++) {
+                fLists[thief].fWork.emplace_front(std::move(stolen[i]));
+            }
+        }
+        return true;
+    }
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    // Returns an empty function only when the pool is shutting down and there's no work left.
+    std::function<void(void)> take(int index) {
+        std::function<void(void)> work;
+        for (;;) {
+            if (index >= 0 && this->pop(index, &work)) {
+                return work;
+            }
+            for (int i = 1; i <= fListCount; i++) {
+                int victim = (index + i + fListCount) % fListCount;
+                if (victim != index && this->steal(victim, index, &work)) {
+                    return work;
+                }
+            }
+            if (fShuttingDown.load(std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            // Our work is in flight between two other threads' lists.  Look again.
+            std::this_thread::yield();
+        }
+    }
+
+    static void Loop(SkWorkStealingPool* pool, int index, bool pinThread) {
+        if (pinThread) {
+            pin_to_core(index);
+        }
+        gCurrentPool  = pool;
+        gCurrentIndex = index;
+        for (;;) {
+            pool->fWorkAvailable.wait();
+            std::function<void(void)> work = pool->take(index);
+            if (!work) {
+                break;
+            }
+            work();
+        }
+        gCurrentPool = nullptr;
+    }
+
+    // Which pool (if any) owns the calling thread, and which of its lists belongs to that thread.
+    static thread_local const SkWorkStealingPool* gCurrentPool;
+    static thread_local int                       gCurrentIndex;
+
+    std::unique_ptr<WorkList[]> fLists;
+    const int                   fListCount;
+    SkTArray<std::thread>       fThreads;
+    std::atomic<uint32_t>       fNextList{0};
+    std::atomic<bool>           fShuttingDown{false};
+    SkSemaphore                 fWorkAvailable;
+    bool                        fAllowBorrowing;
+};
+
+thread_local const SkWorkStealingPool* SkWorkStealingPool::gCurrentPool  = nullptr;
+thread_local int                       SkWorkStealingPool::gCurrentIndex = -1;
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads, bool allowBorrowing) {
     using WorkList = std::deque<std::function<void(void)>>;
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
@@ -149,3 +305,8 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads, bool all
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
                                                     allowBorrowing);
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingPool(int threads, bool allowBorrowing,
+                                                             bool pinThreads) {
+    return std::make_unique<SkWorkStealingPool>(threads > 0 ? threads : num_cores(),
+                                                allowBorrowing, pinThreads);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkLazyPicture.h"
+
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkStream.h"
+#include "src/core/SkCanvasPriv.h"
+#include "src/core/SkFontDescriptor.h"
+#include "src/core/SkPictureData.h"
+
+// Smaller pictures are cheap enough to deserialize up front.
+static constexpr size_t kMinLazyPictureBytes = 4096;
+
+// Walks over a serialized picture (see SkPictureData::serialize()) without deserializing its ops,
+// arrays, or sub-pictures.  Returns false if it's malformed, or can't be skipped cheaply.
+static bool skip_picture(SkStream* stream, const SkTypefacePlayback& topLevelTypefaces,
+                         int recursionLimit, SkPictInfo* info) {
+    uint8_t trailingByte;
+    if (recursionLimit <= 0 ||
+        !SkPicture_StreamIsSKP(stream, info) ||
+        !stream->readU8(&trailingByte) ||
+        trailingByte != kPictureData_TrailingStreamByteAfterPictInfo) {
+        return false;
+    }
+
+    for (;;) {
+        uint32_t tag, size;
+        if (!stream->readU32(&tag)) {
+            return false;
+        }
+        if (SK_PICT_EOF_TAG == tag) {
+            return true;
+        }
+        if (!stream->readU32(&size)) {
+            return false;
+        }
+        switch (tag) {
+            case SK_PICT_READER_TAG:
+            case SK_PICT_FACTORY_TAG:
+            case SK_PICT_BUFFER_SIZE_TAG:
+                // These sizes are in bytes.
+                if (stream->skip(size) != size) {
+                    return false;
+                }
+                break;
+            case SK_PICT_TYPEFACE_TAG:
+                // A picture without typefaces of its own uses the top-level picture's, which we
+                // won't have when we load it later.
+                if (size == 0 && topLevelTypefaces.count() > 0) {
+                    return false;
+                }
+                for (uint32_t i = 0; i < size; ++i) {
+                    SkFontDescriptor desc;
+                    if (!SkFontDescriptor::Deserialize(stream, &desc)) {
+                        return false;
+                    }
+                }
+                break;
+            case SK_PICT_PICTURE_TAG:
+                for (uint32_t i = 0; i < size; ++i) {
+                    SkPictInfo nestedInfo;
+                    if (!skip_picture(stream, topLevelTypefaces, recursionLimit - 1,
+                                      &nestedInfo)) {
+                        return false;
+                    }
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+}
+
+sk_sp<SkPicture> SkLazyPicture::Make(SkStream* stream, const SkDeserialProcs& procs,
+                                     const SkTypefacePlayback& topLevelTypefaces,
+                                     int recursionLimit, const SkData* sharedData) {
+    SkASSERT(sharedData);
+
+    // Custom procs (and their contexts) need not outlive deserialization, so we can't defer
+    // calling them.
+    if (procs.fPictureProc || procs.fImageProc || procs.fTypefaceProc) {
+        return nullptr;
+    }
+
+    const size_t start = stream->getPosition();
+    SkPictInfo info;
+    if (!skip_picture(stream, topLevelTypefaces, recursionLimit, &info) ||
+        stream->getPosition() - start < kMinLazyPictureBytes) {
+        SkAssertResult(stream->seek(start));
+        return nullptr;
+    }
+
+    const size_t size = stream->getPosition() - start;
+    return sk_sp<SkPicture>(new SkLazyPicture(info.fCullRect,
+                                              SkData::MakeSubset(sharedData, start, size),
+                                              recursionLimit));
+}
+
+SkLazyPicture::SkLazyPicture(const SkRect& cull, sk_sp<SkData> data, int recursionLimit)
+    : fCullRect(cull)
+    , fData(std::move(data))
+    , fRecursionLimit(recursionLimit) {}
+
+const SkPicture* SkLazyPicture::load() const {
+    fLoadOnce([this] {
+        // fData is ours to share, so the loaded picture (and its own nested pictures, which load
+        // lazily in turn) can reference it rather than copy it.
+        SkMemoryStream stream(fData);
+        fPicture = MakeFromStreamPriv(&stream, nullptr, nullptr, fRecursionLimit, fData.get());
+    });
+    return fPicture.get();
+}
+
+void SkLazyPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
+    if (const SkPicture* picture = this->load()) {
+        picture->playback(canvas, callback);
+    }
+}
+
+int SkLazyPicture::approximateOpCount(bool nested) const {
+    if (nested) {
+        const SkPicture* picture = this->load();
+        return picture ? picture->approximateOpCount(nested) : 0;
+    }
+    // We can't count our ops without loading, but must claim more than
+    // kMaxPictureOpsToUnrollInsteadOfRef (SkCanvasPriv.h) to avoid being unrolled, and so loaded,
+    // as soon as we're drawn into a parent picture.
+    return kMaxPictureOpsToUnrollInsteadOfRef + 1;
+}
+
+size_t SkLazyPicture::approximateBytesUsed() const {
+    return sizeof(*this) + fData->size();
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkLazyPicture_DEFINED
+#define SkLazyPicture_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
+#include "include/private/SkOnce.h"
+
+struct SkDeserialProcs;
+class SkStream;
+class SkTypefacePlayback;
+
+// A picture nested in a serialized picture, kept as its serialized bytes until something needs
+// its contents: its first playback(), which SkCanvas only reaches once the picture's cull rect
+// survives culling, or approximateOpCount(true).
+class SkLazyPicture final : public SkPicture {
+public:
+    // If the picture at the stream's position can be loaded lazily, skips the stream past it and
+    // returns a picture referencing its bytes in sharedData, which the stream must be reading.
+    // Otherwise leaves the stream where it was and returns nullptr.
+    static sk_sp<SkPicture> Make(SkStream*, const SkDeserialProcs&,
+                                 const SkTypefacePlayback& topLevelTypefaces,
+                                 int recursionLimit, const SkData* sharedData);
+
+// SkPicture overrides
+    void playback(SkCanvas*, AbortCallback*) const override;
+    SkRect cullRect() const override { return fCullRect; }
+    int approximateOpCount(bool nested) const override;
+    size_t approximateBytesUsed() const override;
+
+private:
+    SkLazyPicture(const SkRect& cull, sk_sp<SkData>, int recursionLimit);
+
+    // Deserializes the picture the first time it's called.  Returns nullptr if that fails.
+    const SkPicture* load() const;
+
+    const SkRect        fCullRect;
+    const sk_sp<SkData> fData;
+    const int           fRecursionLimit;
+
+    mutable SkOnce           fLoadOnce;
+    mutable sk_sp<SkPicture> fPicture;
+};
+
+#endif//SkLazyPicture_DEFINED
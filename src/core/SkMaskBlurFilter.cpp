@@ -8,6 +8,7 @@
 #include "src/core/SkMaskBlurFilter.h"
 
 #include "include/core/SkColorPriv.h"
+#include "include/core/SkExecutor.h"
 #include "include/private/SkMalloc.h"
 #include "include/private/SkTPin.h"
 #include "include/private/SkTemplates.h"
@@ -15,9 +16,11 @@
 #include "include/private/SkVx.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkGaussFilter.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <cmath>
 #include <climits>
+#include <functional>
 
 namespace {
 static const double kPi = 3.14159265358979323846264338327950288;
@@ -195,6 +198,58 @@ public:
             }
         }
 
+        // Blur N rows at once, one per lane. src holds the rows interleaved: src[i*N + k] is the
+        // i'th alpha of row k. Lane k of the i'th result is written to dst[i*dstStride + k], so
+        // the transposed results of adjacent rows are stored together. buffer must hold
+        // N * bufferSize() values.
+        template <int N>
+        void blurLanes(const uint32_t* src, int srcLen, uint8_t* dst, int dstStride, int dstLen,
+                       uint32_t* buffer) const {
+            using U32 = skvx::Vec<N, uint32_t>;
+
+            const int size0 = fBuffer0End - fBuffer0,
+                      size1 = fBuffer1End - fBuffer1,
+                      size2 = fBuffer2End - fBuffer2;
+            uint32_t* buffer0 = buffer;
+            uint32_t* buffer1 = buffer0 + N * size0;
+            uint32_t* buffer2 = buffer1 + N * size1;
+
+            // The first pass consumes the source generating pixels, then lets the leading edge
+            // run off the right side of the mask. The second starts from the right and fills in
+            // the rest.
+            const int forwardCount = srcLen + fNoChangeCount;
+            const uint64_t weight = fWeight;
+            for (int pass = 0; pass < 2; ++pass) {
+                std::memset(buffer, 0x00, N * (size0 + size1 + size2) * sizeof(*buffer));
+                int cursor0 = 0, cursor1 = 0, cursor2 = 0;
+                U32 sum0 = 0, sum1 = 0, sum2 = 0;
+
+                const int count = pass == 0 ? forwardCount : dstLen - forwardCount;
+                for (int n = 0; n < count; ++n) {
+                    const int from = pass == 0 ? n : srcLen - 1 - n,
+                              to   = pass == 0 ? n : dstLen - 1 - n;
+                    U32 leadingEdge = from < srcLen ? U32::Load(src + N * from) : U32(0);
+                    sum0 += leadingEdge;
+                    sum1 += sum0;
+                    sum2 += sum1;
+
+                    finalScale(sum2, weight).store(dst + to * dstStride);
+
+                    sum2 -= U32::Load(buffer2 + N * cursor2);
+                    sum1.store(buffer2 + N * cursor2);
+                    cursor2 = (cursor2 + 1) < size2 ? cursor2 + 1 : 0;
+
+                    sum1 -= U32::Load(buffer1 + N * cursor1);
+                    sum0.store(buffer1 + N * cursor1);
+                    cursor1 = (cursor1 + 1) < size1 ? cursor1 + 1 : 0;
+
+                    sum0 -= U32::Load(buffer0 + N * cursor0);
+                    leadingEdge.store(buffer0 + N * cursor0);
+                    cursor0 = (cursor0 + 1) < size0 ? cursor0 + 1 : 0;
+                }
+            }
+        }
+
     private:
         inline static constexpr uint64_t kHalf = static_cast<uint64_t>(1) << 31;
 
@@ -202,6 +257,12 @@ public:
             return SkTo<uint8_t>((fWeight * sum + kHalf) >> 32);
         }
 
+        template <int N>
+        static skvx::Vec<N, uint8_t> finalScale(const skvx::Vec<N, uint32_t>& sum,
+                                                uint64_t weight) {
+            return skvx::cast<uint8_t>((skvx::cast<uint64_t>(sum) * weight + kHalf) >> 32);
+        }
+
         uint64_t  fWeight;
         int       fNoChangeCount;
         uint32_t* fBuffer0;
@@ -950,9 +1011,81 @@ static SkIPoint small_blur(double sigmaX, double sigmaY, const SkMask& src, SkMa
     return {radiusX, radiusY};
 }
 
+// The number of rows blurred together by PlanGauss::Scan::blurLanes().
+static constexpr int kLanes = 4;
+
+// Blur rows [begin, end) of a mask whose row 0 runs from start to end, writing row y's results
+// to dst + y, dstStride bytes apart. Unless scalar is true, rows are blurred kLanes at a time.
+template <typename AlphaIter>
+static void blur_rows(const PlanGauss& plan, AlphaIter start, AlphaIter end, uint32_t rowBytes,
+                      int srcLen, int begin, int endRow, uint8_t* dst, int dstStride, int dstLen,
+                      bool scalar) {
+    auto buffer = std::make_unique<uint32_t[]>(plan.bufferSize());
+    const PlanGauss::Scan& scan = plan.makeBlurScan(srcLen, buffer.get());
+
+    int y = begin;
+    // A one pixel window has no ring buffers; leave that to the scalar scan.
+    if (!scalar && plan.bufferSize() > 0) {
+        auto laneBuffer  = std::make_unique<uint32_t[]>(kLanes * plan.bufferSize());
+        auto interleaved = std::make_unique<uint32_t[]>(kLanes * srcLen);
+        for (; y + kLanes <= endRow; y += kLanes) {
+            AlphaIter row = start;
+            row >>= y * rowBytes;
+            for (int k = 0; k < kLanes; ++k, row >>= rowBytes) {
+                AlphaIter alpha = row;
+                for (int x = 0; x < srcLen; ++x, ++alpha) {
+                    interleaved[x * kLanes + k] = *alpha;
+                }
+            }
+            scan.blurLanes<kLanes>(interleaved.get(), srcLen, dst + y, dstStride, dstLen,
+                                   laneBuffer.get());
+        }
+    }
+
+    start >>= y * rowBytes;
+    end   >>= y * rowBytes;
+    for (; y < endRow; ++y, start >>= rowBytes, end >>= rowBytes) {
+        scan.blur(start, end, dst + y, dstStride, dst + y + dstStride * dstLen);
+    }
+}
+
+// Rows are blurred independently, so split them into bands (of whole groups of kLanes rows,
+// unless bandRows says otherwise), and blur large masks' bands in parallel on the default
+// SkExecutor.
+static void for_each_band(int rows, int rowLength, int bandRows,
+                          const std::function<void(int, int)>& blurBand) {
+    if (bandRows <= 0) {
+        // Enough work per band to be worth handing to another thread.
+        static constexpr int kMinBandPixels = 1 << 16;
+        bandRows = (kMinBandPixels / std::max(rowLength, 1) + kLanes - 1) / kLanes * kLanes;
+        bandRows = std::max(bandRows, 4 * kLanes);
+    }
+
+    const int bandCount = (rows + bandRows - 1) / bandRows;
+    if (bandCount <= 1) {
+        blurBand(0, rows);
+        return;
+    }
+
+    SkTaskGroup bands(SkExecutor::GetDefault());
+    bands.batch(bandCount, [&](int i) {
+        blurBand(i * bandRows, std::min(rows, (i + 1) * bandRows));
+    });
+    bands.wait();
+}
+
+SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
+    return this->blur(src, dst, 0, false);
+}
+
+SkIPoint SkMaskBlurFilter::blurForTesting(const SkMask& src, SkMask* dst,
+                                          int bandRows, bool scalar) const {
+    return this->blur(src, dst, bandRows, scalar);
+}
+
 // TODO: assuming sigmaW = sigmaH. Allow different sigmas. Right now the
 // API forces the sigmas to be the same.
-SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
+SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst, int bandRows, bool scalar) const {
 
     if (fSigmaW < 2.0 && fSigmaH < 2.0) {
         return small_blur(fSigmaW, fSigmaH, src, dst);
@@ -983,9 +1116,6 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
         dstH = dst->fBounds.height();
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
-    auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
-    auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
-
     // Blur both directions.
     int tmpW = srcH,
         tmpH = dstW;
@@ -997,43 +1127,32 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
     auto tmp = alloc.makeArrayDefault<uint8_t>(tmpW * tmpH);
 
     // Blur horizontally, and transpose.
-    const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
+    auto blurW = [&](auto start, auto end) {
+        for_each_band(srcH, tmpH, bandRows, [&](int begin, int endRow) {
+            blur_rows(planW, start, end, src.fRowBytes, srcW, begin, endRow, tmp, tmpW, tmpH,
+                      scalar);
+        });
+    };
     switch (src.fFormat) {
         case SkMask::kBW_Format: {
             const uint8_t* bwStart = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0);
-            auto end = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
+            blurW(SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0),
+                  SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8));
         } break;
         case SkMask::kA8_Format: {
             const uint8_t* a8Start = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
-            auto end = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
+            blurW(SkMask::AlphaIter<SkMask::kA8_Format>(a8Start),
+                  SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW));
         } break;
         case SkMask::kARGB32_Format: {
             const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
-            auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
+            blurW(SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart),
+                  SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW));
         } break;
         case SkMask::kLCD16_Format: {
             const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
-            auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
+            blurW(SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart),
+                  SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW));
         } break;
         default:
             SK_ABORT("Unhandled format.");
@@ -1041,14 +1160,11 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
 
     // Blur vertically (scan in memory order because of the transposition),
     // and transpose back to the original orientation.
-    const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
-    for (int y = 0; y < tmpH; y++) {
-        auto tmpStart = &tmp[y * tmpW];
-        auto dstStart = &dst->fImage[y];
-
-        scanH.blur(tmpStart, tmpStart + tmpW,
-                   dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
-    }
+    for_each_band(tmpH, dstH, bandRows, [&](int begin, int endRow) {
+        blur_rows(planH, SkMask::AlphaIter<SkMask::kA8_Format>(tmp),
+                  SkMask::AlphaIter<SkMask::kA8_Format>(tmp + tmpW), tmpW,
+                  tmpW, begin, endRow, dst->fImage, dst->fRowBytes, dstH, scalar);
+    });
 
     return {SkTo<int32_t>(borderW), SkTo<int32_t>(borderH)};
 }
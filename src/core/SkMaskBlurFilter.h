@@ -29,7 +29,13 @@ public:
     // Given a src SkMask, generate dst SkMask returning the border width and height.
     SkIPoint blur(const SkMask& src, SkMask* dst) const;
 
+    // For tests: blur() with large sigmas' rows split into bands of bandRows rows (or as blur()
+    // picks them if bandRows is 0), blurred one at a time by the scalar scan if scalar is true.
+    SkIPoint blurForTesting(const SkMask& src, SkMask* dst, int bandRows, bool scalar) const;
+
 private:
+    SkIPoint blur(const SkMask& src, SkMask* dst, int bandRows, bool scalar) const;
+
     const double fSigmaW;
     const double fSigmaH;
 };
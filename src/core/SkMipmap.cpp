@@ -10,12 +10,14 @@
 #include "include/private/SkColorData.h"
 #include "include/private/SkHalf.h"
 #include "include/private/SkImageInfoPriv.h"
+#include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
 #include "include/private/SkVx.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkMipmapBuilder.h"
 #include <new>
+#include <utility>
 
 //
 // ColorTypeFilter is the "Type" we pass to some downsample template functions.
@@ -383,6 +385,169 @@ template <typename F> void downsample_3_3(void* dst, const void* src, size_t src
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//
+// WideFilter is the "W" we pass to the downsample_*_wide functions, which filter W::N pixels at a
+// time.  Expand(p) expands the N pixels p[0], p[2], ... p[2N-2] into one vector (reading up to
+// p[2N-1]), and Compact() stores N filtered pixels.  Each wide function evaluates the same
+// expression, in the same order, as its one-pixel-at-a-time template above, on the same expanded
+// values, so the results are identical.  The template (W::F) finishes each row.
+//
+
+struct WideFilter_8888 {
+    using F = ColorTypeFilter_8888;
+    using Type = uint32_t;
+    static constexpr int N = 4;
+
+    // Like ColorTypeFilter_8888, but with each channel in 16 bits of a 32-bit lane, red and blue
+    // (or blue and red) in the low half of the vector, green and alpha in the high half.
+    static skvx::Vec<8, uint32_t> Expand(const uint32_t* p) {
+        auto even = skvx::shuffle<0,2,4,6>(skvx::Vec<8, uint32_t>::Load(p));
+        return skvx::join(even & 0x00ff00ff, (even >> 8) & 0x00ff00ff);
+    }
+    static void Compact(const skvx::Vec<8, uint32_t>& x, uint32_t* dst) {
+        ((x.lo & 0x00ff00ff) | ((x.hi & 0x00ff00ff) << 8)).store(dst);
+    }
+};
+
+struct WideFilter_8 {
+    using F = ColorTypeFilter_8;
+    using Type = uint8_t;
+    static constexpr int N = 8;
+
+    static skvx::Vec<8, uint16_t> Expand(const uint8_t* p) {
+        return skvx::Vec<8, uint16_t>::Load(p) & 0xff;
+    }
+    static void Compact(const skvx::Vec<8, uint16_t>& x, uint8_t* dst) {
+        skvx::cast<uint8_t>(x).store(dst);
+    }
+};
+
+struct WideFilter_1010102 {
+    using F = ColorTypeFilter_1010102;
+    using Type = uint32_t;
+    static constexpr int N = 4;
+
+    // Like ColorTypeFilter_1010102, but with two channels per 32-bit lane: red and blue in the low
+    // half of the vector, green and alpha in the high half.  Alpha sits at the top of its lane so
+    // that it wraps exactly as it does at the top of ColorTypeFilter_1010102's 64 bits.
+    static skvx::Vec<8, uint32_t> Expand(const uint32_t* p) {
+        auto x = skvx::shuffle<0,2,4,6>(skvx::Vec<8, uint32_t>::Load(p));
+        return skvx::join(((x      ) & 0x3ff) | ((x >>  4) & 0x3ff0000),
+                          ((x >> 10) & 0x3ff) | ((x >> 2) & 0x30000000));
+    }
+    static void Compact(const skvx::Vec<8, uint32_t>& x, uint32_t* dst) {
+        ((((x.lo      ) & 0x3ff)      ) |
+         (((x.hi      ) & 0x3ff) << 10) |
+         (((x.lo >> 16) & 0x3ff) << 20) |
+         (((x.hi >> 28) & 0x3  ) << 30)).store(dst);
+    }
+};
+
+// Each loop below stops while at least one pixel is left, so no wide load reads past the row.
+template <typename W> void downsample_2_2_wide(void* dst, const void* src, size_t srcRB,
+                                               int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const typename W::Type*>(src);
+    auto p1 = (const typename W::Type*)((const char*)p0 + srcRB);
+    auto d = static_cast<typename W::Type*>(dst);
+
+    int i = 0;
+    for (; i + W::N < count; i += W::N) {
+        auto c00 = W::Expand(p0 + 0);
+        auto c01 = W::Expand(p0 + 1);
+        auto c10 = W::Expand(p1 + 0);
+        auto c11 = W::Expand(p1 + 1);
+
+        auto c = c00 + c10 + c01 + c11;
+        W::Compact(shift_right(c, 2), d + i);
+        p0 += 2 * W::N;
+        p1 += 2 * W::N;
+    }
+    downsample_2_2<typename W::F>(d + i, p0, srcRB, count - i);
+}
+
+template <typename W> void downsample_2_3_wide(void* dst, const void* src, size_t srcRB,
+                                               int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const typename W::Type*>(src);
+    auto p1 = (const typename W::Type*)((const char*)p0 + srcRB);
+    auto p2 = (const typename W::Type*)((const char*)p1 + srcRB);
+    auto d = static_cast<typename W::Type*>(dst);
+
+    int i = 0;
+    for (; i + W::N < count; i += W::N) {
+        auto c00 = W::Expand(p0 + 0);
+        auto c01 = W::Expand(p0 + 1);
+        auto c10 = W::Expand(p1 + 0);
+        auto c11 = W::Expand(p1 + 1);
+        auto c20 = W::Expand(p2 + 0);
+        auto c21 = W::Expand(p2 + 1);
+
+        auto c = add_121(c00, c10, c20) + add_121(c01, c11, c21);
+        W::Compact(shift_right(c, 3), d + i);
+        p0 += 2 * W::N;
+        p1 += 2 * W::N;
+        p2 += 2 * W::N;
+    }
+    downsample_2_3<typename W::F>(d + i, p0, srcRB, count - i);
+}
+
+template <typename W> void downsample_3_2_wide(void* dst, const void* src, size_t srcRB,
+                                               int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const typename W::Type*>(src);
+    auto p1 = (const typename W::Type*)((const char*)p0 + srcRB);
+    auto d = static_cast<typename W::Type*>(dst);
+
+    int i = 0;
+    for (; i + W::N < count; i += W::N) {
+        auto a = W::Expand(p0 + 0) + W::Expand(p1 + 0);
+
+        auto b0 = W::Expand(p0 + 1);
+        auto b1 = W::Expand(p1 + 1);
+        auto b = b0 + b0 + b1 + b1;
+
+        auto c = W::Expand(p0 + 2) + W::Expand(p1 + 2);
+
+        auto sum = a + b + c;
+        W::Compact(shift_right(sum, 3), d + i);
+        p0 += 2 * W::N;
+        p1 += 2 * W::N;
+    }
+    downsample_3_2<typename W::F>(d + i, p0, srcRB, count - i);
+}
+
+template <typename W> void downsample_3_3_wide(void* dst, const void* src, size_t srcRB,
+                                               int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const typename W::Type*>(src);
+    auto p1 = (const typename W::Type*)((const char*)p0 + srcRB);
+    auto p2 = (const typename W::Type*)((const char*)p1 + srcRB);
+    auto d = static_cast<typename W::Type*>(dst);
+
+    int i = 0;
+    for (; i + W::N < count; i += W::N) {
+        auto a = add_121(W::Expand(p0 + 0), W::Expand(p1 + 0), W::Expand(p2 + 0));
+        auto b = shift_left(add_121(W::Expand(p0 + 1), W::Expand(p1 + 1), W::Expand(p2 + 1)), 1);
+        auto c = add_121(W::Expand(p0 + 2), W::Expand(p1 + 2), W::Expand(p2 + 2));
+
+        auto sum = a + b + c;
+        W::Compact(shift_right(sum, 4), d + i);
+        p0 += 2 * W::N;
+        p1 += 2 * W::N;
+        p2 += 2 * W::N;
+    }
+    downsample_3_3<typename W::F>(d + i, p0, srcRB, count - i);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static thread_local bool gWideFilters = true;
+
+bool SkMipmap::SetWideFiltersForTesting(bool wide) {
+    return std::exchange(gWideFilters, wide);
+}
+
 SkMipmap::SkMipmap(void* malloc, size_t size) : SkCachedData(malloc, size) {}
 SkMipmap::SkMipmap(size_t size, SkDiscardableMemory* dm) : SkCachedData(size, dm) {}
 
@@ -421,11 +586,11 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
+            proc_2_2 = downsample_2_2_wide<WideFilter_8888>;
+            proc_2_3 = downsample_2_3_wide<WideFilter_8888>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_8888>;
+            proc_3_2 = downsample_3_2_wide<WideFilter_8888>;
+            proc_3_3 = downsample_3_3_wide<WideFilter_8888>;
             break;
         case kRGB_565_SkColorType:
             proc_1_2 = downsample_1_2<ColorTypeFilter_565>;
@@ -453,11 +618,11 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_8>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_8>;
+            proc_2_2 = downsample_2_2_wide<WideFilter_8>;
+            proc_2_3 = downsample_2_3_wide<WideFilter_8>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_8>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_8>;
+            proc_3_2 = downsample_3_2_wide<WideFilter_8>;
+            proc_3_3 = downsample_3_3_wide<WideFilter_8>;
             break;
         case kRGBA_F16Norm_SkColorType:
         case kRGBA_F16_SkColorType:
@@ -505,11 +670,11 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_1010102>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_1010102>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_1010102>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_1010102>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_1010102>;
+            proc_2_2 = downsample_2_2_wide<WideFilter_1010102>;
+            proc_2_3 = downsample_2_3_wide<WideFilter_1010102>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_1010102>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_1010102>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_1010102>;
+            proc_3_2 = downsample_3_2_wide<WideFilter_1010102>;
+            proc_3_3 = downsample_3_3_wide<WideFilter_1010102>;
             break;
         case kA16_float_SkColorType:
             proc_1_2 = downsample_1_2<ColorTypeFilter_Alpha_F16>;
@@ -553,6 +718,33 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             return nullptr;
     }
 
+    if (!gWideFilters) {
+        auto use_templates = [&](auto filter) {
+            using F = decltype(filter);
+            proc_2_2 = downsample_2_2<F>;
+            proc_2_3 = downsample_2_3<F>;
+            proc_3_2 = downsample_3_2<F>;
+            proc_3_3 = downsample_3_3<F>;
+        };
+        switch (ct) {
+            case kRGBA_8888_SkColorType:
+            case kBGRA_8888_SkColorType:
+                use_templates(ColorTypeFilter_8888());
+                break;
+            case kAlpha_8_SkColorType:
+            case kGray_8_SkColorType:
+            case kR8_unorm_SkColorType:
+                use_templates(ColorTypeFilter_8());
+                break;
+            case kRGBA_1010102_SkColorType:
+            case kBGRA_1010102_SkColorType:
+                use_templates(ColorTypeFilter_1010102());
+                break;
+            default:
+                break;
+        }
+    }
+
     if (src.width() <= 1 && src.height() <= 1) {
         return nullptr;
     }
@@ -592,12 +784,16 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
     int         width = src.width();
     int         height = src.height();
     uint32_t    rowBytes;
-    SkPixmap    srcPM(src);
 
     // Depending on architecture and other factors, the pixel data alignment may need to be as
     // large as 8 (for F16 pixels). See the comment on SkMipmap::Level.
     SkASSERT(SkIsAlign8((uintptr_t)addr));
 
+    // For each level, the filter that makes it and how many rows of the level above each of its
+    // rows reads (1, 2, or 3).
+    SkAutoSTMalloc<16, FilterProc*> procs(countLevels);
+    SkAutoSTMalloc<16, int>         taps(countLevels);
+
     for (int i = 0; i < countLevels; ++i) {
         FilterProc* proc;
         if (height & 1) {
@@ -629,6 +825,9 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
                 proc = proc_2_2;
             }
         }
+        procs[i] = proc;
+        taps[i] = height == 1 ? 1 : (height & 1) ? 3 : 2;
+
         width = std::max(1, width >> 1);
         height = std::max(1, height >> 1);
         rowBytes = SkToU32(SkColorTypeMinRowBytes(ct, width));
@@ -639,21 +838,36 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
         new (&levels[i].fPixmap) SkPixmap(SkImageInfo::Make(width, height, ct, at), addr, rowBytes);
         levels[i].fScale  = SkSize::Make(SkIntToScalar(width)  / src.width(),
                                          SkIntToScalar(height) / src.height());
+        addr += height * rowBytes;
+    }
 
-        const SkPixmap& dstPM = levels[i].fPixmap;
-        if (computeContents) {
-            const void* srcBasePtr = srcPM.addr();
-            void* dstBasePtr = dstPM.writable_addr();
-
-            const size_t srcRB = srcPM.rowBytes();
-            for (int y = 0; y < height; y++) {
-                proc(dstBasePtr, srcBasePtr, srcRB, width);
-                srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-                dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
+    if (computeContents) {
+        // Rather than building each level from the whole of the one above, we build all levels
+        // together: after each row of the first level, every deeper level emits whatever rows it
+        // now has input for.  That way each level is read back while it is still in cache.
+        SkAutoSTMalloc<16, int> rowsDone(countLevels);
+        sk_bzero(rowsDone.get(), countLevels * sizeof(int));
+
+        auto emitRow = [&](int i) {
+            const SkPixmap& srcPM = i == 0 ? src : levels[i - 1].fPixmap;
+            const SkPixmap& dstPM = levels[i].fPixmap;
+            int y = rowsDone[i]++;
+            procs[i](dstPM.writable_addr(0, y), srcPM.addr(0, 2 * y), srcPM.rowBytes(),
+                     dstPM.width());
+        };
+
+        for (int y = 0; y < levels[0].fPixmap.height(); ++y) {
+            emitRow(0);
+            for (int i = 1; i < countLevels; ++i) {
+                while (rowsDone[i] < levels[i].fPixmap.height() &&
+                       2 * rowsDone[i] + taps[i] <= rowsDone[i - 1]) {
+                    emitRow(i);
+                }
             }
         }
-        srcPM = dstPM;
-        addr += height * rowBytes;
+        SkDEBUGCODE(for (int i = 0; i < countLevels; ++i) {
+            SkASSERT(rowsDone[i] == levels[i].fPixmap.height());
+        })
     }
     SkASSERT(addr == baseAddr + size);
 
@@ -39,6 +39,10 @@ public:
 
     static SkMipmap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
 
+    // On the calling thread, makes Build() use the one-pixel-at-a-time filters for the color
+    // types that also have wide ones, so tests can compare the two. Returns the previous setting.
+    static bool SetWideFiltersForTesting(bool wide);
+
     // Determines how many levels a SkMipmap will have without creating that mipmap.
     // This does not include the base mipmap level that the user provided when
     // creating the SkMipmap.
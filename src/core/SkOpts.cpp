@@ -150,4 +150,23 @@ namespace SkOpts {
         static SkOnce once;
         once(init);
     }
+
+    bool SetHSWForTesting(bool hsw) {
+    #if !defined(SK_ENABLE_OPTIMIZE_SIZE) && defined(SK_CPU_X86) && \
+            SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX
+        if (!SkCpu::Supports(SkCpu::SKX)) {
+            return false;
+        }
+        Init();
+        // Init_hsw() replaces everything Init_skx() does.
+        if (hsw) {
+            Init_hsw();
+        } else {
+            Init_skx();
+        }
+        return true;
+    #else
+        return false;
+    #endif
+    }
 }  // namespace SkOpts
@@ -70,6 +70,11 @@ namespace SkOpts {
     // Called by SkGraphics::Init().
     void Init();
 
+    // For benchmarks comparing skx with hsw on the same machine: installs the hsw
+    // specializations over the skx ones, or puts the skx ones back.  Returns false if this CPU
+    // or build doesn't have both.  Not thread-safe; nothing else may be drawing.
+    bool SetHSWForTesting(bool hsw);
+
     // Declare function pointers here...
 
     // May return nullptr if we haven't specialized the given Mode.
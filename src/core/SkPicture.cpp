@@ -26,18 +26,6 @@
 #include "include/private/chromium/Slug.h"
 #endif
 
-// When we read/write the SkPictInfo via a stream, we have a sentinel byte right after the info.
-// Note: in the read/write buffer versions, we have a slightly different convention:
-//      We have a sentinel int32_t:
-//          0 : failure
-//          1 : PictureData
-//         <0 : -size of the custom data
-enum {
-    kFailure_TrailingStreamByteAfterPictInfo     = 0,   // nothing follows
-    kPictureData_TrailingStreamByteAfterPictInfo = 1,   // SkPictureData follows
-    kCustom_TrailingStreamByteAfterPictInfo      = 2,   // -size32 follows
-};
-
 /* SkPicture impl.  This handles generic responsibilities like unique IDs and serialization. */
 
 SkPicture::SkPicture() {
@@ -143,7 +131,7 @@ sk_sp<SkPicture> SkPicture::Forwardport(const SkPictInfo& info,
 static const int kNestedSKPLimit = 100; // Arbitrarily set
 
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procs) {
-    return MakeFromStreamPriv(stream, procs, nullptr, kNestedSKPLimit);
+    return MakeFromStreamPriv(stream, procs, nullptr, kNestedSKPLimit, nullptr);
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromData(const void* data, size_t size,
@@ -152,7 +140,7 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const void* data, size_t size,
         return nullptr;
     }
     SkMemoryStream stream(data, size);
-    return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit);
+    return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit, nullptr);
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialProcs* procs) {
@@ -160,11 +148,21 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
         return nullptr;
     }
     SkMemoryStream stream(data->data(), data->size());
-    return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit);
+    return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit, nullptr);
+}
+
+sk_sp<SkPicture> SkPicture::MakeFromSharedData(sk_sp<SkData> data, const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    // The stream's position is always an offset into data.
+    SkMemoryStream stream(data);
+    return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit, data.get());
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromStreamPriv(SkStream* stream, const SkDeserialProcs* procsPtr,
-                                               SkTypefacePlayback* typefaces, int recursionLimit) {
+                                               SkTypefacePlayback* typefaces, int recursionLimit,
+                                               const SkData* sharedData) {
     if (recursionLimit <= 0) {
         return nullptr;
     }
@@ -184,7 +182,7 @@ sk_sp<SkPicture> SkPicture::MakeFromStreamPriv(SkStream* stream, const SkDeseria
         case kPictureData_TrailingStreamByteAfterPictInfo: {
             std::unique_ptr<SkPictureData> data(
                     SkPictureData::CreateFromStream(stream, info, procs, typefaces,
-                                                    recursionLimit));
+                                                    recursionLimit, sharedData));
             return Forwardport(info, data.get(), nullptr);
         }
         case kCustom_TrailingStreamByteAfterPictInfo: {
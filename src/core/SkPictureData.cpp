@@ -10,7 +10,7 @@
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkTo.h"
-#include "src/core/SkAutoMalloc.h"
+#include "src/core/SkLazyPicture.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
 #include "src/core/SkReadBuffer.h"
@@ -298,16 +298,33 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Reads the next size bytes of stream.  If the stream reads from sharedData, and those bytes are
+// 4-byte aligned (as SkReadBuffer requires), they are shared rather than copied.
+static sk_sp<SkData> read_data(SkStream* stream, size_t size, const SkData* sharedData) {
+    if (sharedData) {
+        size_t offset = stream->getPosition();
+        if (offset <= sharedData->size() && size <= sharedData->size() - offset &&
+            SkIsAlign4((uintptr_t)(sharedData->bytes() + offset))) {
+            if (stream->skip(size) != size) {
+                return nullptr;
+            }
+            return SkData::MakeSubset(sharedData, offset, size);
+        }
+    }
+    return SkData::MakeFromStream(stream, size);
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    const SkDeserialProcs& procs,
                                    SkTypefacePlayback* topLevelTFPlayback,
-                                   int recursionLimit) {
+                                   int recursionLimit,
+                                   const SkData* sharedData) {
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            fOpData = read_data(stream, size, sharedData);
             if (!fOpData) {
                 return false;
             }
@@ -363,8 +380,15 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             fPictures.reserve_back(SkToInt(size));
 
             for (uint32_t i = 0; i < size; i++) {
-                auto pic = SkPicture::MakeFromStreamPriv(stream, &procs,
-                                                         topLevelTFPlayback, recursionLimit - 1);
+                sk_sp<SkPicture> pic;
+                if (sharedData) {
+                    pic = SkLazyPicture::Make(stream, procs, *topLevelTFPlayback,
+                                              recursionLimit - 1, sharedData);
+                }
+                if (!pic) {
+                    pic = SkPicture::MakeFromStreamPriv(stream, &procs, topLevelTFPlayback,
+                                                        recursionLimit - 1, sharedData);
+                }
                 if (!pic) {
                     return false;
                 }
@@ -375,13 +399,17 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             if (StreamRemainingLengthIsBelow(stream, size)) {
                 return false;
             }
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
+            sk_sp<SkData> storage = read_data(stream, size, sharedData);
+            if (!storage) {
                 return false;
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(storage->data(), size);
             buffer.setVersion(fInfo.getVersion());
+            if (sharedData) {
+                // Let images reference their encoded data where it lies, rather than copy it.
+                buffer.setBackingData(storage);
+            }
 
             if (!fFactoryPlayback) {
                 return false;
@@ -515,13 +543,14 @@ SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                const SkDeserialProcs& procs,
                                                SkTypefacePlayback* topLevelTFPlayback,
-                                               int recursionLimit) {
+                                               int recursionLimit,
+                                               const SkData* sharedData) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
 
-    if (!data->parseStream(stream, procs, topLevelTFPlayback, recursionLimit)) {
+    if (!data->parseStream(stream, procs, topLevelTFPlayback, recursionLimit, sharedData)) {
         return nullptr;
     }
     return data.release();
@@ -541,7 +570,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 bool SkPictureData::parseStream(SkStream* stream,
                                 const SkDeserialProcs& procs,
                                 SkTypefacePlayback* topLevelTFPlayback,
-                                int recursionLimit) {
+                                int recursionLimit,
+                                const SkData* sharedData) {
     for (;;) {
         uint32_t tag;
         if (!stream->readU32(&tag)) { return false; }
@@ -551,7 +581,8 @@ bool SkPictureData::parseStream(SkStream* stream,
 
         uint32_t size;
         if (!stream->readU32(&size)) { return false; }
-        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, recursionLimit)) {
+        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, recursionLimit,
+                                  sharedData)) {
             return false; // we're invalid
         }
     }
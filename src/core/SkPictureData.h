@@ -49,6 +49,18 @@ public:
     SkRect      fCullRect;
 };
 
+// When we read/write the SkPictInfo via a stream, we have a sentinel byte right after the info.
+// Note: in the read/write buffer versions, we have a slightly different convention:
+//      We have a sentinel int32_t:
+//          0 : failure
+//          1 : PictureData
+//         <0 : -size of the custom data
+enum {
+    kFailure_TrailingStreamByteAfterPictInfo     = 0,   // nothing follows
+    kPictureData_TrailingStreamByteAfterPictInfo = 1,   // SkPictureData follows
+    kCustom_TrailingStreamByteAfterPictInfo      = 2,   // -size32 follows
+};
+
 #define SK_PICT_READER_TAG     SkSetFourByteTag('r', 'e', 'a', 'd')
 #define SK_PICT_FACTORY_TAG    SkSetFourByteTag('f', 'a', 'c', 't')
 #define SK_PICT_TYPEFACE_TAG   SkSetFourByteTag('t', 'p', 'f', 'c')
@@ -82,7 +94,8 @@ public:
                                            const SkPictInfo&,
                                            const SkDeserialProcs&,
                                            SkTypefacePlayback*,
-                                           int recursionLimit);
+                                           int recursionLimit,
+                                           const SkData* sharedData);
     static SkPictureData* CreateFromBuffer(SkReadBuffer&, const SkPictInfo&);
 
     void serialize(SkWStream*, const SkSerialProcs&, SkRefCntSet*, bool textBlobsOnly=false) const;
@@ -96,8 +109,9 @@ protected:
     explicit SkPictureData(const SkPictInfo& info);
 
     // Does not affect ownership of SkStream.
+    // If sharedData is not null, the stream reads from it, and the result may reference it.
     bool parseStream(SkStream*, const SkDeserialProcs&, SkTypefacePlayback*,
-                     int recursionLimit);
+                     int recursionLimit, const SkData* sharedData);
     bool parseBuffer(SkReadBuffer& buffer);
 
 public:
@@ -147,7 +161,7 @@ private:
     // Does not affect ownership of SkStream.
     bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size,
                         const SkDeserialProcs&, SkTypefacePlayback*,
-                        int recursionLimit);
+                        int recursionLimit, const SkData* sharedData);
     void parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
     void flattenToBuffer(SkWriteBuffer&, bool textBlobsOnly) const;
 
@@ -7,6 +7,11 @@
 
 #include "src/core/SkRTree.h"
 
+#include "include/private/SkVx.h"
+#include "src/core/SkMathPriv.h"
+
+#include <limits>
+
 SkRTree::SkRTree() : fCount(0) {}
 
 void SkRTree::insert(const SkRect boundsArray[], int N) {
@@ -23,7 +28,7 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
 
         Branch b;
         b.fBounds = bounds;
-        b.fOpIndex = i;
+        b.fIndex = i;
         branches.push_back(b);
     }
 
@@ -31,11 +36,9 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
     if (fCount) {
         if (1 == fCount) {
             fNodes.reserve(1);
-            Node* n = this->allocateNodeAtLevel(0);
-            n->fNumChildren = 1;
-            n->fChildren[0] = branches[0];
-            fRoot.fSubtree = n;
-            fRoot.fBounds  = branches[0].fBounds;
+            fRoot.fIndex  = this->allocateNodeAtLevel(0);
+            fRoot.fBounds = branches[0].fBounds;
+            this->appendChild(fRoot.fIndex, branches[0]);
         } else {
             fNodes.reserve(CountNodes(fCount));
             fRoot = this->bulkLoad(&branches);
@@ -43,14 +46,31 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
     }
 }
 
-SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
+int32_t SkRTree::allocateNodeAtLevel(uint16_t level) {
     SkDEBUGCODE(Node* p = fNodes.data());
     fNodes.push_back(Node{});
     Node& out = fNodes.back();
     SkASSERT(fNodes.data() == p);  // If this fails, we didn't reserve() enough.
+    // Empty slots get inverted, infinite bounds so that they fail every intersection test.
+    for (int i = 0; i < kSlots; ++i) {
+        out.fLeft  [i] = out.fTop   [i] = +std::numeric_limits<float>::infinity();
+        out.fRight [i] = out.fBottom[i] = -std::numeric_limits<float>::infinity();
+        out.fChildren[i] = -1;
+    }
     out.fNumChildren = 0;
     out.fLevel = level;
-    return &out;
+    return (int32_t)(fNodes.size() - 1);
+}
+
+void SkRTree::appendChild(int32_t node, const Branch& branch) {
+    Node& n = fNodes[node];
+    SkASSERT(n.fNumChildren < kMaxChildren);
+    int i = n.fNumChildren++;
+    n.fLeft    [i] = branch.fBounds.fLeft;
+    n.fTop     [i] = branch.fBounds.fTop;
+    n.fRight   [i] = branch.fBounds.fRight;
+    n.fBottom  [i] = branch.fBounds.fBottom;
+    n.fChildren[i] = branch.fIndex;
 }
 
 // This function parallels bulkLoad, but just counts how many nodes bulkLoad would allocate.
@@ -121,17 +141,15 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
                 remainder -= kMaxChildren - kMinChildren;
             }
         }
-        Node* n = allocateNodeAtLevel(level);
-        n->fNumChildren = 1;
-        n->fChildren[0] = (*branches)[currentBranch];
+        int32_t n = this->allocateNodeAtLevel(level);
+        this->appendChild(n, (*branches)[currentBranch]);
         Branch b;
         b.fBounds = (*branches)[currentBranch].fBounds;
-        b.fSubtree = n;
+        b.fIndex = n;
         ++currentBranch;
         for (int k = 1; k < incrementBy && currentBranch < (int)branches->size(); ++k) {
             b.fBounds.join((*branches)[currentBranch].fBounds);
-            n->fChildren[k] = (*branches)[currentBranch];
-            ++n->fNumChildren;
+            this->appendChild(n, (*branches)[currentBranch]);
             ++currentBranch;
         }
         (*branches)[newBranches] = b;
@@ -141,19 +159,59 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
     return this->bulkLoad(branches, level + 1);
 }
 
+// One bit per lane, set if that lane of the comparison was true.
+static uint32_t bitmask(const skvx::Vec<4, int32_t>& hit) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE1
+    return _mm_movemask_ps(skvx::bit_pun<__m128>(hit));
+#else
+    return (hit[0] & 1) | (hit[1] & 2) | (hit[2] & 4) | (hit[3] & 8);
+#endif
+}
+
 void SkRTree::search(const SkRect& query, std::vector<int>* results) const {
-    if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
-        this->search(fRoot.fSubtree, query, results);
+    if (fCount == 0 || !SkRect::Intersects(fRoot.fBounds, query)) {
+        return;
     }
-}
+    // The query intersects the root's bounds, so it's not empty, and a child intersects it
+    // exactly when the child's edges straddle the query's: no min/max needed.
+    const skvx::float4 qL = query.fLeft,
+                       qT = query.fTop,
+                       qR = query.fRight,
+                       qB = query.fBottom;
+
+    // Walk the tree depth first with an explicit stack.  Children are pushed last-to-first
+    // so that, like the bulk-loaded order, results come out in increasing op index order.
+    // Each level leaves at most kMaxChildren-1 siblings waiting on the stack.
+    int32_t stack[kMaxDepth * (kMaxChildren - 1) + 1];
+    int depth = 0;
+    SkASSERT(this->getDepth() <= kMaxDepth);
+    stack[depth++] = fRoot.fIndex;
+    while (depth > 0) {
+        const Node& node = fNodes[stack[--depth]];
+
+        // Bit i of mask is set if child i's bounds intersect the query.
+        uint32_t mask = 0;
+        for (int i = 0; i < node.fNumChildren; i += 4) {
+            auto hit = (qL < skvx::float4::Load(node.fRight  + i))
+                     & (qT < skvx::float4::Load(node.fBottom + i))
+                     & (skvx::float4::Load(node.fLeft + i) < qR)
+                     & (skvx::float4::Load(node.fTop  + i) < qB);
+            mask |= bitmask(hit) << i;
+        }
 
-void SkRTree::search(Node* node, const SkRect& query, std::vector<int>* results) const {
-    for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
-            if (0 == node->fLevel) {
-                results->push_back(node->fChildren[i].fOpIndex);
-            } else {
-                this->search(node->fChildren[i].fSubtree, query, results);
+        if (0 == node.fLevel) {
+            if (mask == (1u << node.fNumChildren) - 1) {
+                // Common for large queries: every child hits.
+                results->insert(results->end(), node.fChildren,
+                                                node.fChildren + node.fNumChildren);
+                continue;
+            }
+            for (; mask; mask &= mask - 1) {
+                results->push_back(node.fChildren[SkCTZ(mask)]);
+            }
+        } else {
+            for (; mask; mask &= ~(0x80000000u >> SkCLZ(mask))) {
+                stack[depth++] = node.fChildren[31 - SkCLZ(mask)];
             }
         }
     }
@@ -17,6 +17,8 @@
  *
  * It only supports bulk-loading, i.e. creation from a batch of bounding rectangles.
  * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm.
+ * Nodes live in one flat array, each storing its children's bounds as a structure of arrays,
+ * and search() walks them iteratively, testing several children's bounds at once.
  *
  * TODO: Experiment with other bulk-load algorithms (in particular the Hilbert pack variant,
  * which groups rects by position on the Hilbert curve, is probably worth a look). There also
@@ -38,7 +40,7 @@ public:
     // Methods and constants below here are only public for tests.
 
     // Return the depth of the tree structure.
-    int getDepth() const { return fCount ? fRoot.fSubtree->fLevel + 1 : 0; }
+    int getDepth() const { return fCount ? fNodes[fRoot.fIndex].fLevel + 1 : 0; }
     // Insertion count (not overall node count, which may be greater).
     int getCount() const { return fCount; }
 
@@ -47,23 +49,28 @@ public:
                      kMaxChildren = 11;
 
 private:
-    struct Node;
-
     struct Branch {
-        union {
-            Node* fSubtree;
-            int fOpIndex;
-        };
+        int32_t fIndex;  // An op index for the children of level-0 nodes, otherwise a node index.
         SkRect fBounds;
     };
 
-    struct Node {
+    // Each node keeps its children's bounds as a structure of arrays, padded out to a multiple
+    // of 4, so search() can test a node against a query 4 children at a time.  Unused slots
+    // hold bounds that no query can hit.
+    static constexpr int kSlots = (kMaxChildren + 3) & ~3;
+
+    struct alignas(64) Node {
+        float fLeft  [kSlots],
+              fTop   [kSlots],
+              fRight [kSlots],
+              fBottom[kSlots];
+        int32_t fChildren[kSlots];
         uint16_t fNumChildren;
         uint16_t fLevel;
-        Branch fChildren[kMaxChildren];
     };
 
-    void search(Node* root, const SkRect& query, std::vector<int>* results) const;
+    // Nodes below the root have at least kMinChildren children, so no tree is deeper than this.
+    static constexpr int kMaxDepth = 16;
 
     // Consumes the input array.
     Branch bulkLoad(std::vector<Branch>* branches, int level = 0);
@@ -71,7 +78,8 @@ private:
     // How many times will bulkLoad() call allocateNodeAtLevel()?
     static int CountNodes(int branches);
 
-    Node* allocateNodeAtLevel(uint16_t level);
+    int32_t allocateNodeAtLevel(uint16_t level);
+    void appendChild(int32_t node, const Branch&);
 
     // This is the count of data elements (rather than total nodes in the tree)
     int fCount;
@@ -133,8 +133,8 @@ struct skcms_TransferFunction;
 // The largest number of pixels we handle at a time. We have a separate value for the largest number
 // of pixels we handle in the highp pipeline. Many of the context structs in this file are only used
 // by stages that have no lowp implementation. They can therefore use the (smaller) highp value to
-// save memory in the arena.
-inline static constexpr int SkRasterPipeline_kMaxStride = 16;
+// save memory in the arena. (The lowp pipeline runs 32 pixels at a time on AVX-512 machines.)
+inline static constexpr int SkRasterPipeline_kMaxStride = 32;
 inline static constexpr int SkRasterPipeline_kMaxStride_highp = 8;
 
 // Raster pipeline programs are stored as a contiguous array of SkRasterPipelineStages.
@@ -305,6 +305,15 @@ sk_sp<SkData> SkReadBuffer::readByteArrayAsData() {
         return nullptr;
     }
 
+    if (fBackingData) {
+        const void* bytes = this->skipByteArray(&numBytes);
+        if (!bytes) {
+            return nullptr;
+        }
+        const char* base = static_cast<const char*>(fBackingData->data());
+        return SkData::MakeSubset(fBackingData.get(), (const char*)bytes - base, numBytes);
+    }
+
     SkAutoMalloc buffer(numBytes);
     if (!this->readByteArray(buffer.get(), numBytes)) {
         return nullptr;
@@ -8,6 +8,7 @@
 #ifndef SkReadBuffer_DEFINED
 #define SkReadBuffer_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkPath.h"
@@ -42,6 +43,16 @@ public:
 
     void setMemory(const void*, size_t);
 
+    /**
+     *  Declares that the memory being read lies within data.  readByteArrayAsData() (and so
+     *  readImage()) then returns subsets that share data, rather than copies.
+     */
+    void setBackingData(sk_sp<SkData> data) {
+        SkASSERT(!data || (fBase >= (const char*)data->data() &&
+                           fStop <= (const char*)data->data() + data->size()));
+        fBackingData = std::move(data);
+    }
+
     /**
      *  Returns true IFF the version is older than the specified version.
      */
@@ -221,6 +232,8 @@ private:
     const char* fStop = nullptr;  // end of buffer
     const char* fBase = nullptr;  // beginning of buffer
 
+    sk_sp<SkData> fBackingData;   // optional, contains [fBase, fStop)
+
     // Only used if we do not have an fFactoryArray.
     SkTHashMap<uint32_t, SkFlattenable::Factory> fFlattenableDict;
 
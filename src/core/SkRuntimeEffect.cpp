@@ -10,7 +10,10 @@
 #include "include/core/SkCapabilities.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
+#include "include/core/SkMilestone.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkTime.h"
 #include "include/private/SkMutex.h"
 #include "include/sksl/DSLCore.h"
 #include "src/core/SkBlenderBase.h"
@@ -20,10 +23,12 @@
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkLRUCache.h"
 #include "src/core/SkMatrixProvider.h"
+#include "src/core/SkOSFile.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRuntimeEffectPriv.h"
+#include "src/core/SkStreamPriv.h"
 #include "src/core/SkUtils.h"
 #include "src/core/SkVM.h"
 #include "src/core/SkWriteBuffer.h"
@@ -39,6 +44,7 @@
 #include "src/sksl/ir/SkSLProgram.h"
 #include "src/sksl/ir/SkSLVarDeclarations.h"
 #include "src/sksl/tracing/SkVMDebugTrace.h"
+#include "src/utils/SkOSPath.h"
 
 #if SK_SUPPORT_GPU
 #include "include/gpu/GrRecordingContext.h"
@@ -58,6 +64,10 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <utility>
 
 #if defined(SK_BUILD_FOR_DEBUGGER)
     #define SK_LENIENT_SKSL_DESERIALIZATION 1
@@ -887,6 +897,150 @@ const SkFilterColorProgram* SkRuntimeEffect::getFilterColorProgram() const {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+static std::atomic<SkRuntimeEffect::PersistentCache*> gPersistentCache{nullptr};
+
+void SkRuntimeEffect::SetPersistentCache(PersistentCache* cache) {
+    gPersistentCache.store(cache);
+}
+
+namespace {
+
+// Different in each process (with ASLR, even in ones started at the same time).
+uint32_t process_nonce() {
+    static const uint32_t nonce = [] {
+        uint64_t seed[2];
+        seed[0] = (uint64_t)SkTime::GetNSecs();
+        seed[1] = (uint64_t)(uintptr_t)&seed;
+        return SkOpts::hash_fn(seed, sizeof(seed), 0);
+    }();
+    return nonce;
+}
+
+class DirectoryCache final : public SkRuntimeEffect::PersistentCache {
+public:
+    explicit DirectoryCache(const char directory[]) : fDirectory(directory) {}
+
+    sk_sp<SkData> load(const SkData& key) override {
+        // Read the file rather than map it, since another process may rewrite it at any time.
+        SkFILEStream file(this->path(key).c_str());
+        sk_sp<SkData> entry = file.isValid() ? SkCopyStreamToData(&file) : nullptr;
+
+        // Each entry starts with its key, in case two keys' file names collide.
+        if (!entry || entry->size() < key.size() ||
+            memcmp(entry->data(), key.data(), key.size()) != 0) {
+            return nullptr;
+        }
+        return SkData::MakeSubset(entry.get(), key.size(), entry->size() - key.size());
+    }
+
+    void store(const SkData& key, const SkData& data) override {
+        // Write a file no other thread or process is writing, then move it into place, so that
+        // load() never sees a partly written entry.
+        static std::atomic<uint32_t> gNextTemp{0};
+        const SkString path = this->path(key);
+        const SkString temp = SkStringPrintf("%s.%08x.%u.tmp", path.c_str(), process_nonce(),
+                                             gNextTemp.fetch_add(1, std::memory_order_relaxed));
+        bool written;
+        {
+            SkFILEWStream file(temp.c_str());
+            written = file.isValid() &&
+                      file.write(key.data(), key.size()) &&
+                      file.write(data.data(), data.size());
+        }
+#if defined(SK_BUILD_FOR_WIN)
+        // Windows won't rename over an existing file. Readers just miss while it's gone.
+        if (written) {
+            std::remove(path.c_str());
+        }
+#endif
+        if (!written || std::rename(temp.c_str(), path.c_str()) != 0) {
+            std::remove(temp.c_str());
+        }
+    }
+
+private:
+    SkString path(const SkData& key) const {
+        uint64_t hash = (uint64_t)SkOpts::hash_fn(key.data(), key.size(), 0) << 32 |
+                                  SkOpts::hash_fn(key.data(), key.size(), 1);
+        SkString name = SkStringPrintf("%016" PRIx64 ".skvm", hash);
+        return SkOSPath::Join(fDirectory.c_str(), name.c_str());
+    }
+
+    const SkString fDirectory;
+};
+
+}  // namespace
+
+std::unique_ptr<SkRuntimeEffect::PersistentCache> SkRuntimeEffect::MakeDirectoryCache(
+        const char directory[]) {
+    if (!directory || !(sk_isdir(directory) || sk_mkdir(directory))) {
+        return nullptr;
+    }
+    return std::make_unique<DirectoryCache>(directory);
+}
+
+// Everything that goes into an SkVMTemplate: the program (which its source and settings
+// determine), the features it was recorded for, and the code generator that recorded it.
+static sk_sp<SkData> vm_template_key(const SkSL::Program& program,
+                                     const skvm::Features& features) {
+    const SkSL::ProgramSettings& settings = program.fConfig->fSettings;
+    SkDynamicMemoryWStream key;
+    key.write32(SK_MILESTONE);
+    key.write32(SkSL::SkVMTemplate::kVersion);
+    key.write8((int)program.fConfig->fKind);
+    key.writeBool(settings.fOptimize);
+    key.writeBool(settings.fForceNoInline);
+    key.write32(settings.fInlineThreshold);
+    key.write8((int)settings.fMaxVersionAllowed);
+    key.writeBool(features.fma);
+    key.writeBool(features.fp16);
+    key.write(program.fSource->data(), program.fSource->size());
+    return key.detachAsData();
+}
+
+static thread_local bool gVMTemplates = true;
+
+bool SkRuntimeEffectPriv::SetVMTemplatesForTesting(bool enabled) {
+    return std::exchange(gVMTemplates, enabled);
+}
+
+const SkSL::SkVMTemplate* SkRuntimeEffect::getVMTemplate(const skvm::Features& features) const {
+    if (!gVMTemplates) {
+        return nullptr;
+    }
+    fVMTemplateOnce([&] {
+        const size_t uniformSlots = this->uniformSize() / sizeof(int32_t);
+        const int childCount = SkToInt(fChildren.size());
+
+        PersistentCache* cache = gPersistentCache.load();
+        sk_sp<SkData> key;
+        if (cache) {
+            key = vm_template_key(*fBaseProgram, features);
+            if (sk_sp<SkData> data = cache->load(*key)) {
+                fVMTemplate = SkSL::SkVMTemplate::Deserialize(*data, uniformSlots, childCount,
+                                                              features);
+                if (fVMTemplate) {
+                    return;
+                }
+            }
+        }
+
+        fVMTemplate = SkSL::SkVMTemplate::Make(*fBaseProgram, fMain, uniformSlots, features);
+        if (cache && fVMTemplate) {
+            cache->store(*key, *fVMTemplate->serialize());
+        }
+    });
+
+    // Builders nearly always detect the same features, but a template only matches its own.
+    if (fVMTemplate && fVMTemplate->features().fma  == features.fma
+                    && fVMTemplate->features().fp16 == features.fp16) {
+        return fVMTemplate.get();
+    }
+    return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 #if SK_SUPPORT_GPU
 static GrFPResult make_effect_fp(sk_sp<SkRuntimeEffect> effect,
                                  const char* name,
@@ -1119,6 +1273,10 @@ public:
         // There should be no way for the color filter to use device coords, but we need to supply
         // something. (Uninitialized values can trigger asserts in skvm::Builder).
         skvm::Coord zeroCoord = { p->splat(0.0f), p->splat(0.0f) };
+        if (const SkSL::SkVMTemplate* t = fEffect->getVMTemplate(p->features())) {
+            return t->replay(p, SkSpan(uniform), /*device=*/zeroCoord, /*local=*/zeroCoord,
+                             c, c, &callbacks);
+        }
         return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p,/*debugTrace=*/nullptr,
                                    SkSpan(uniform), /*device=*/zeroCoord, /*local=*/zeroCoord,
                                    c, c, &callbacks);
@@ -1304,6 +1462,12 @@ public:
         std::vector<skvm::Val> uniform = make_skvm_uniforms(p, uniforms, fEffect->uniformSize(),
                                                             *inputs);
 
+        // Debug traces need the program's trace ops, which templates don't record.
+        if (!fDebugTrace) {
+            if (const SkSL::SkVMTemplate* t = fEffect->getVMTemplate(p->features())) {
+                return t->replay(p, SkSpan(uniform), device, local, paint, paint, &callbacks);
+            }
+        }
         return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p, fDebugTrace.get(),
                                    SkSpan(uniform), device, local, paint, paint, &callbacks);
     }
@@ -1405,6 +1569,10 @@ public:
 
         // Emit the blend function as an SkVM program.
         skvm::Coord zeroCoord = {p->splat(0.0f), p->splat(0.0f)};
+        if (const SkSL::SkVMTemplate* t = fEffect->getVMTemplate(p->features())) {
+            return t->replay(p, SkSpan(uniform), /*device=*/zeroCoord, /*local=*/zeroCoord,
+                             src, dst, &callbacks);
+        }
         return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p,/*debugTrace=*/nullptr,
                                    SkSpan(uniform), /*device=*/zeroCoord, /*local=*/zeroCoord,
                                    src, dst, &callbacks);
@@ -66,6 +66,11 @@ public:
 
     static bool CanDraw(const SkCapabilities*, const SkSL::Program*);
     static bool CanDraw(const SkCapabilities*, const SkRuntimeEffect*);
+
+    // On the calling thread, makes the CPU backend convert runtime effects with ProgramToSkVM()
+    // instead of replaying their SkVMTemplates, so tests can compare the two. Returns the previous
+    // setting.
+    static bool SetVMTemplatesForTesting(bool enabled);
 };
 
 // These internal APIs for creating runtime effects vary from the public API in two ways:
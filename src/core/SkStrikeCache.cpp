@@ -23,6 +23,12 @@
 
 bool gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental = false;
 
+SkStrikeCache::SkStrikeCache() {
+    for (Shard& shard : fShards) {
+        shard.fCache = this;
+    }
+}
+
 SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
     if (gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental) {
         static thread_local auto* cache = new SkStrikeCache;
@@ -33,12 +39,20 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
 }
 
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
-    if (strike == nullptr) {
-        strike = this->internalCreateStrike(strikeSpec);
+    Shard& shard = this->shardFor(strikeSpec.descriptor());
+    sk_sp<SkStrike> strike;
+    bool overBudget;
+    {
+        SkAutoMutexExclusive ac(shard.fLock);
+        strike = shard.findStrikeOrNull(strikeSpec.descriptor());
+        if (strike == nullptr) {
+            strike = this->internalCreateStrike(shard, strikeSpec);
+        }
+        overBudget = this->internalPurge(shard);
+    }
+    if (overBudget) {
+        this->reconcileBudgets();
     }
-    this->internalPurge();
     return strike;
 }
 
@@ -116,13 +130,21 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
-    this->internalPurge();
+    Shard& shard = this->shardFor(desc);
+    sk_sp<SkStrike> result;
+    bool overBudget;
+    {
+        SkAutoMutexExclusive ac(shard.fLock);
+        result = shard.findStrikeOrNull(desc);
+        overBudget = this->internalPurge(shard);
+    }
+    if (overBudget) {
+        this->reconcileBudgets();
+    }
     return result;
 }
 
-auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<SkStrike> {
+auto SkStrikeCache::Shard::findStrikeOrNull(const SkDescriptor& desc) -> sk_sp<SkStrike> {
 
     // Check head because it is likely the strike we are looking for.
     if (fHead != nullptr && fHead->getDescriptor() == desc) { return sk_ref_sp(fHead); }
@@ -152,53 +174,52 @@ sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
-    SkAutoMutexExclusive ac(fLock);
-    return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
+    Shard& shard = this->shardFor(strikeSpec.descriptor());
+    SkAutoMutexExclusive ac(shard.fLock);
+    return this->internalCreateStrike(shard, strikeSpec, maybeMetrics, std::move(pinner));
 }
 
 auto SkStrikeCache::internalCreateStrike(
+        Shard& shard,
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) -> sk_sp<SkStrike> {
     std::unique_ptr<SkScalerContext> scaler = strikeSpec.createScalerContext();
     auto strike =
         sk_make_sp<SkStrike>(this, strikeSpec, std::move(scaler), maybeMetrics, std::move(pinner));
-    this->internalAttachToHead(strike);
+    shard.attachToHead(strike);
     return strike;
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoMutexExclusive ac(fLock);
-    this->internalPurge(fTotalMemoryUsed);
+    SkAutoMutexExclusive purgeLock(fPurgeLock);
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive ac(shard.fLock);
+        this->internalPurge(shard, shard.fTotalMemoryUsed);
+    }
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fTotalMemoryUsed;
+    return fTotalMemoryUsed.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheCount;
+    return fCacheCount.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheCountLimit;
+    return fCacheCountLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
-    SkAutoMutexExclusive ac(fLock);
-
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
-    this->internalPurge();
+    SkAutoMutexExclusive purgeLock(fPurgeLock);
+    size_t prevLimit = fCacheSizeLimit.exchange(newLimit, std::memory_order_relaxed);
+    this->purgeAllShards();
     return prevLimit;
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheSizeLimit;
+    return fCacheSizeLimit.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::setCacheCountLimit(int newCount) {
@@ -206,47 +227,81 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoMutexExclusive ac(fLock);
-
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
-    this->internalPurge();
+    SkAutoMutexExclusive purgeLock(fPurgeLock);
+    int prevCount = fCacheCountLimit.exchange(newCount, std::memory_order_relaxed);
+    this->purgeAllShards();
     return prevCount;
 }
 
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoMutexExclusive ac(fLock);
+    for (const Shard& shard : fShards) {
+        SkAutoMutexExclusive ac(shard.fLock);
 
-    this->validate();
+        shard.validate();
+
+        for (SkStrike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
+            visitor(*strike);
+        }
+    }
+}
 
-    for (SkStrike* strike = fHead; strike != nullptr; strike = strike->fNext) {
-        visitor(*strike);
+void SkStrikeCache::purgeAllShards() {
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive ac(shard.fLock);
+        this->internalPurge(shard);
     }
 }
 
-size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
+void SkStrikeCache::reconcileBudgets() {
+    SkAutoMutexExclusive purgeLock(fPurgeLock);
+    this->purgeAllShards();
+}
+
+bool SkStrikeCache::internalPurge(Shard& shard, size_t minBytesNeeded) {
+    // Each shard may use more than its share while the cache as a whole is within budget.
+    // Once the cache is over budget, each shard is trimmed back to its share. The shares round
+    // up so that any nonzero budget leaves every shard room for its most recently used strike;
+    // the cache can then exceed its budget by less than one byte or strike per shard.
+    const size_t sizeLimit = fCacheSizeLimit.load(std::memory_order_relaxed);
+    const int countLimit = fCacheCountLimit.load(std::memory_order_relaxed);
+    const size_t sizeShare = sizeLimit / kShardCount + (sizeLimit % kShardCount != 0);
+    const int countShare = countLimit / kShardCount + (countLimit % kShardCount != 0);
+
     size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
+    if (fTotalMemoryUsed.load(std::memory_order_relaxed) > sizeLimit &&
+        shard.fTotalMemoryUsed > sizeShare) {
+        bytesNeeded = shard.fTotalMemoryUsed - sizeShare;
     }
     bytesNeeded = std::max(bytesNeeded, minBytesNeeded);
     if (bytesNeeded) {
         // no small purges!
-        bytesNeeded = std::max(bytesNeeded, fTotalMemoryUsed >> 2);
+        bytesNeeded = std::max(bytesNeeded, shard.fTotalMemoryUsed >> 2);
     }
 
     int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
+    if (fCacheCount.load(std::memory_order_relaxed) > countLimit &&
+        shard.fCacheCount > countShare) {
+        countNeeded = shard.fCacheCount - countShare;
         // no small purges!
-        countNeeded = std::max(countNeeded, fCacheCount >> 2);
+        countNeeded = std::max(countNeeded, shard.fCacheCount >> 2);
     }
 
-    // early exit
-    if (!countNeeded && !bytesNeeded) {
-        return 0;
+    if (countNeeded || bytesNeeded) {
+        shard.purge(bytesNeeded, countNeeded);
     }
 
+    // The cache is still over budget because of other shards only if together they hold more
+    // than their shares.
+    const size_t totalMemoryUsed = fTotalMemoryUsed.load(std::memory_order_relaxed);
+    const int cacheCount = fCacheCount.load(std::memory_order_relaxed);
+    return (totalMemoryUsed > sizeLimit &&
+            totalMemoryUsed - std::min(totalMemoryUsed, shard.fTotalMemoryUsed) >
+                    (kShardCount - 1) * sizeShare) ||
+           (cacheCount > countLimit &&
+            cacheCount - shard.fCacheCount > (kShardCount - 1) * countShare);
+}
+
+size_t SkStrikeCache::Shard::purge(size_t bytesNeeded, int countNeeded) {
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
@@ -260,11 +315,12 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
         if (strike->fPinner == nullptr || strike->fPinner->canDelete()) {
             bytesFreed += strike->fMemoryUsed;
             countFreed += 1;
-            this->internalRemoveStrike(strike);
+            this->removeStrike(strike);
         }
         strike = prev;
     }
 
+    this->publishMemoryUsed();
     this->validate();
 
 #ifdef SPEW_PURGE_STATUS
@@ -277,7 +333,7 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     return bytesFreed;
 }
 
-void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
+void SkStrikeCache::Shard::attachToHead(sk_sp<SkStrike> strike) {
     SkASSERT(fStrikeLookup.find(strike->getDescriptor()) == nullptr);
     SkStrike* strikePtr = strike.get();
     fStrikeLookup.set(std::move(strike));
@@ -285,6 +341,8 @@ void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
 
     fCacheCount += 1;
     fTotalMemoryUsed += strikePtr->fMemoryUsed;
+    fCache->fCacheCount.fetch_add(1, std::memory_order_relaxed);
+    fCache->fTotalMemoryUsed.fetch_add(strikePtr->fMemoryUsed, std::memory_order_relaxed);
 
     if (fHead != nullptr) {
         fHead->fPrev = strikePtr;
@@ -298,10 +356,29 @@ void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
     fHead = strikePtr; // Transfer ownership of strike to the cache list.
 }
 
-void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
+void SkStrikeCache::Shard::addMemoryUsed(size_t increase) {
+    fTotalMemoryUsed += increase;
+    fUnpublishedBytes += increase;
+    if (fUnpublishedBytes >= kPublishBytes) {
+        this->publishMemoryUsed();
+    }
+}
+
+void SkStrikeCache::Shard::publishMemoryUsed() {
+    if (fUnpublishedBytes != 0) {
+        fCache->fTotalMemoryUsed.fetch_add(fUnpublishedBytes, std::memory_order_relaxed);
+        fUnpublishedBytes = 0;
+    }
+}
+
+void SkStrikeCache::Shard::removeStrike(SkStrike* strike) {
     SkASSERT(fCacheCount > 0);
+    // Part of this strike's memory may not be published yet.
+    this->publishMemoryUsed();
     fCacheCount -= 1;
     fTotalMemoryUsed -= strike->fMemoryUsed;
+    fCache->fCacheCount.fetch_sub(1, std::memory_order_relaxed);
+    fCache->fTotalMemoryUsed.fetch_sub(strike->fMemoryUsed, std::memory_order_relaxed);
 
     if (strike->fPrev) {
         strike->fPrev->fNext = strike->fNext;
@@ -319,7 +396,7 @@ void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
     fStrikeLookup.remove(strike->getDescriptor());
 }
 
-void SkStrikeCache::validate() const {
+void SkStrikeCache::Shard::validate() const {
 #ifdef SK_DEBUG
     size_t computedBytes = 0;
     int computedCount = 0;
@@ -352,10 +429,11 @@ void SkStrikeCache::validate() const {
 
 void SkStrike::updateDelta(size_t increase) {
     if (increase != 0) {
-        SkAutoMutexExclusive lock{fStrikeCache->fLock};
+        SkStrikeCache::Shard& shard = fStrikeCache->shardFor(this->getDescriptor());
+        SkAutoMutexExclusive lock{shard.fLock};
         fMemoryUsed += increase;
         if (!fRemoved) {
-            fStrikeCache->fTotalMemoryUsed += increase;
+            shard.addMemoryUsed(increase);
         }
     }
 }
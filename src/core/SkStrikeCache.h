@@ -8,6 +8,7 @@
 #ifndef SkStrikeCache_DEFINED
 #define SkStrikeCache_DEFINED
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -207,21 +208,21 @@ public:
 
 class SkStrikeCache final : public sktext::StrikeForGPUCacheInterface {
 public:
-    SkStrikeCache() = default;
+    SkStrikeCache();
 
     static SkStrikeCache* GlobalStrikeCache();
 
-    sk_sp<SkStrike> findStrike(const SkDescriptor& desc) SK_EXCLUDES(fLock);
+    sk_sp<SkStrike> findStrike(const SkDescriptor& desc) SK_EXCLUDES(fPurgeLock);
 
     sk_sp<SkStrike> createStrike(
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_EXCLUDES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr) SK_EXCLUDES(fPurgeLock);
 
-    sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec) SK_EXCLUDES(fLock);
+    sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec) SK_EXCLUDES(fPurgeLock);
 
     sktext::ScopedStrikeForGPU findOrCreateScopedStrike(
-            const SkStrikeSpec& strikeSpec) override SK_EXCLUDES(fLock);
+            const SkStrikeSpec& strikeSpec) override SK_EXCLUDES(fPurgeLock);
 
     static void PurgeAll();
     static void Dump();
@@ -230,55 +231,100 @@ public:
     // SkTraceMemoryDump interface.
     static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
 
-    void purgeAll() SK_EXCLUDES(fLock); // does not change budget
+    void purgeAll() SK_EXCLUDES(fPurgeLock); // does not change budget
 
-    int getCacheCountLimit() const SK_EXCLUDES(fLock);
-    int setCacheCountLimit(int limit) SK_EXCLUDES(fLock);
-    int getCacheCountUsed() const SK_EXCLUDES(fLock);
+    int getCacheCountLimit() const;
+    int setCacheCountLimit(int limit) SK_EXCLUDES(fPurgeLock);
+    int getCacheCountUsed() const;
 
-    size_t getCacheSizeLimit() const SK_EXCLUDES(fLock);
-    size_t setCacheSizeLimit(size_t limit) SK_EXCLUDES(fLock);
-    size_t getTotalMemoryUsed() const SK_EXCLUDES(fLock);
+    size_t getCacheSizeLimit() const;
+    size_t setCacheSizeLimit(size_t limit) SK_EXCLUDES(fPurgeLock);
+    size_t getTotalMemoryUsed() const;
 
 private:
     friend class SkStrike;  // for SkStrike::updateDelta
-    sk_sp<SkStrike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
+
+    // Strikes are split across shards by descriptor checksum. Each shard has its own lock and
+    // LRU list, so threads working on different strikes rarely contend.
+    static constexpr int kShardBits = 3;
+    static constexpr int kShardCount = 1 << kShardBits;
+
+    // Glyph memory added to a shard is published to fTotalMemoryUsed in batches of at least this
+    // many bytes, so the cache-wide total is behind by less than kShardCount * kPublishBytes.
+    static constexpr size_t kPublishBytes = 8 * 1024;
+
+    // Each shard gets its own cache line so that locking one doesn't slow down its neighbors.
+    struct alignas(64) Shard {
+        sk_sp<SkStrike> findStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
+
+        // The following methods can only be called when mutex is already held.
+        void removeStrike(SkStrike* strike) SK_REQUIRES(fLock);
+        void attachToHead(sk_sp<SkStrike> strike) SK_REQUIRES(fLock);
+
+        // Account for glyphs added to a strike in this shard.
+        void addMemoryUsed(size_t increase) SK_REQUIRES(fLock);
+        void publishMemoryUsed() SK_REQUIRES(fLock);
+
+        // Purge from the tail of the LRU list until both needs are met (or nothing unpinned is
+        // left). Returns number of bytes freed.
+        size_t purge(size_t bytesNeeded, int countNeeded) SK_REQUIRES(fLock);
+
+        // A simple accounting of what each glyph cache reports and the shard total.
+        void validate() const SK_REQUIRES(fLock);
+
+        SkStrikeCache* fCache{nullptr};
+        mutable SkMutex fLock;
+        SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
+        SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
+        struct StrikeTraits {
+            static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike) {
+                return strike->getDescriptor();
+            }
+            static uint32_t Hash(const SkDescriptor& descriptor) {
+                return descriptor.getChecksum();
+            }
+        };
+        SkTHashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup
+                SK_GUARDED_BY(fLock);
+        size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
+        size_t  fUnpublishedBytes SK_GUARDED_BY(fLock) {0};
+        int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
+    };
+
+    // Use the top bits of the checksum; each shard's hash table indexes by the bottom bits.
+    Shard& shardFor(const SkDescriptor& desc) {
+        return fShards[desc.getChecksum() >> (32 - kShardBits)];
+    }
+
     sk_sp<SkStrike> internalCreateStrike(
+            Shard& shard,
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(shard.fLock);
 
-    // The following methods can only be called when mutex is already held.
-    void internalRemoveStrike(SkStrike* strike) SK_REQUIRES(fLock);
-    void internalAttachToHead(sk_sp<SkStrike> strike) SK_REQUIRES(fLock);
+    // If the whole cache is over budget, purge this shard down to its share of the budgets,
+    // modulated by the specified min-bytes-needed-to-purge.
+    // Returns true if the cache is still over budget because of other shards.
+    bool internalPurge(Shard& shard, size_t minBytesNeeded = 0) SK_REQUIRES(shard.fLock);
 
-    // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
-    // Returns number of bytes freed.
-    size_t internalPurge(size_t minBytesNeeded = 0) SK_REQUIRES(fLock);
+    // Bring every shard within its share of the budgets, taking each shard's lock in turn.
+    void purgeAllShards() SK_REQUIRES(fPurgeLock);
 
-    // A simple accounting of what each glyph cache reports and the strike cache total.
-    void validate() const SK_REQUIRES(fLock);
+    // Called after a shard's lock is released, when internalPurge() found the cache still over
+    // budget: the excess is in other shards.
+    void reconcileBudgets() SK_EXCLUDES(fPurgeLock);
 
-    void forEachStrike(std::function<void(const SkStrike&)> visitor) const SK_EXCLUDES(fLock);
+    void forEachStrike(std::function<void(const SkStrike&)> visitor) const SK_EXCLUDES(fPurgeLock);
 
-    mutable SkMutex fLock;
-    SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
-    SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
-    struct StrikeTraits {
-        static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike) {
-            return strike->getDescriptor();
-        }
-        static uint32_t Hash(const SkDescriptor& descriptor) {
-            return descriptor.getChecksum();
-        }
-    };
-    SkTHashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup SK_GUARDED_BY(fLock);
+    // Serializes purges that walk every shard. Always taken before any shard's lock.
+    SkMutex fPurgeLock;
+
+    Shard fShards[kShardCount];
 
-    size_t  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
-    size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
-    int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
-    int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
+    std::atomic<size_t>  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
+    std::atomic<size_t>  fTotalMemoryUsed{0};
+    std::atomic<int32_t> fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
+    std::atomic<int32_t> fCacheCount{0};
 };
 
 #endif  // SkStrikeCache_DEFINED
@@ -963,6 +963,8 @@ namespace skvm {
 
         uint64_t hash() const;
 
+        Features features() const { return fFeatures; }
+
         Val push(Instruction);
 
         bool allImm() const { return true; }
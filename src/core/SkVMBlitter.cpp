@@ -38,6 +38,9 @@ namespace {
     static_assert(SkIsAlign4(sizeof(BlitterUniforms)), "");
     inline static constexpr int kBlitterUniformsCount = sizeof(BlitterUniforms) / 4;
 
+    // See SkVMBlitter::GetProgramCacheStats().  Like the program cache, these are per-thread.
+    thread_local static SkVMBlitter::ProgramCacheStats gProgramCacheStats = {0, 0, 0};
+
     static skvm::Coord device_coord(skvm::Builder* p, skvm::Uniforms* uniforms) {
         skvm::I32 dx = p->uniform32(uniforms->base, offsetof(BlitterUniforms, right))
                      - p->index(),
@@ -581,6 +584,14 @@ SkString SkVMBlitter::DebugName(const Key& key) {
 
 void SkVMBlitter::ReleaseProgramCache() {}
 
+SkVMBlitter::ProgramCacheStats SkVMBlitter::GetProgramCacheStats() {
+    return gProgramCacheStats;
+}
+
+void SkVMBlitter::ResetProgramCacheStats() {
+    gProgramCacheStats = {0, 0, 0};
+}
+
 skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
     // eg, blitter re-use...
     if (fProgramPtrs[coverage]) {
@@ -597,10 +608,12 @@ skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
         }
         if (p) {
             SkASSERT(!p->empty());
+            gProgramCacheStats.hits++;
             fProgramPtrs[coverage] = p;
             return p;
         }
     }
+    gProgramCacheStats.misses++;
 
     // Okay, let's build it...
     fStoreToCache = true;
@@ -617,19 +630,12 @@ skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
               "%zu, prev was %zu", fUniforms.buf.size(), prev);
 
     skvm::Program program = builder.done(DebugName(key).c_str());
-    if ((false)) {
-        static std::atomic<int> missed{0},
-                                total{0};
-        if (!program.hasJIT()) {
+    if (!program.hasJIT()) {
+        gProgramCacheStats.withoutJIT++;
+        if ((false)) {
             SkDebugf("\ncouldn't JIT %s\n", DebugName(key).c_str());
             builder.dump();
             program.dump();
-
-            missed++;
-        }
-        if (0 == total++) {
-            atexit([]{ SkDebugf("SkVMBlitter compiled %d programs, %d without JIT.\n",
-                                total.load(), missed.load()); });
         }
     }
     fProgramPtrs[coverage] = fPrograms[coverage].set(std::move(program));
@@ -39,6 +39,17 @@ public:
 
     ~SkVMBlitter() override;
 
+    // Counts of program cache lookups made by SkVMBlitters on the calling thread, for tests and
+    // tools.  Like the cache itself, these are per-thread.  Without a JIT there is no cache, so
+    // every program is a miss.
+    struct ProgramCacheStats {
+        int64_t hits;        // Programs found already compiled in this thread's cache.
+        int64_t misses;      // Programs we had to build.
+        int64_t withoutJIT;  // Of those misses, programs we couldn't JIT and will interpret.
+    };
+    static ProgramCacheStats GetProgramCacheStats();
+    static void ResetProgramCacheStats();
+
 private:
     enum Coverage { Full, UniformF, MaskA8, MaskLCD16, Mask3D, kCount };
     struct Key {
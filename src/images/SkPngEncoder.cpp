@@ -14,6 +14,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -26,6 +27,7 @@
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkPngPriv.h"
 #include "src/core/SkMSAN.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/images/SkImageEncoderFns.h"
 #include "src/images/SkImageEncoderPriv.h"
 
@@ -39,6 +41,7 @@
 
 #include <png.h>
 #include <pngconf.h>
+#include <zlib.h>
 
 static_assert(PNG_FILTER_NONE  == (int)SkPngEncoder::FilterFlag::kNone,  "Skia libpng filter err.");
 static_assert(PNG_FILTER_SUB   == (int)SkPngEncoder::FilterFlag::kSub,   "Skia libpng filter err.");
@@ -78,6 +81,9 @@ public:
     bool writeInfo(const SkImageInfo& srcInfo);
     void chooseProc(const SkImageInfo& srcInfo);
 
+    bool canEncodeParallel(const SkPixmap& src) const;
+    bool encodeParallel(const SkPixmap& src);
+
     png_structp pngPtr() { return fPngPtr; }
     png_infop infoPtr() { return fInfoPtr; }
     int pngBytesPerPixel() const { return fPngBytesPerPixel; }
@@ -94,10 +100,19 @@ private:
         , fInfoPtr(infoPtr)
     {}
 
+    bool writeChunk(const char* name, const void* data, size_t length);
+
     png_structp             fPngPtr;
     png_infop               fInfoPtr;
     int                     fPngBytesPerPixel;
     transform_scanline_proc fProc;
+
+    // Only needed by encodeParallel().
+    int                     fBitDepth = 8;
+    bool                    fHasFiller = false;
+    int                     fFilters = PNG_ALL_FILTERS;
+    int                     fZLibLevel = 6;
+    SkExecutor*             fExecutor = nullptr;
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -221,6 +236,12 @@ bool SkPngEncoderMgr::setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::
     SkASSERT(zlibLevel == options.fZLibLevel);
     png_set_compression_level(fPngPtr, zlibLevel);
 
+    fBitDepth  = bitDepth;
+    // Like libpng, which picks its own default when no filters are set.
+    fFilters   = filters ? filters : PNG_ALL_FILTERS;
+    fZLibLevel = zlibLevel;
+    fExecutor  = options.fExecutor;
+
     // Set comments in tEXt chunk
     const sk_sp<SkDataTable>& comments = options.fComments;
     if (comments != nullptr) {
@@ -412,6 +433,7 @@ bool SkPngEncoderMgr::writeInfo(const SkImageInfo& srcInfo) {
         // For kOpaque, kRGBA_F16, we will keep the row as RGBA and tell libpng
         // to skip the alpha channel.
         png_set_filler(fPngPtr, 0, PNG_FILLER_AFTER);
+        fHasFiller = true;
     }
 
     return true;
@@ -421,6 +443,243 @@ void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) {
     fProc = choose_proc(srcInfo);
 }
 
+// Parallel encoding cuts the image into bands of about this many bytes of filtered rows.  Each
+// band is filtered and deflated on its own, ending in a sync flush so that the bands' compressed
+// data concatenate into a single zlib stream.
+static constexpr size_t kParallelBandSize = 256 * 1024;
+// Each band's deflate is primed with this much of the filtered data that precedes it.
+static constexpr size_t kDictionarySize = 32 * 1024;
+// Bound on how many bands (and so how much memory) may be in flight at once.
+static constexpr int kMaxPendingBands = 32;
+
+// Writes type followed by row filtered with predict(left, up, upperLeft) to dst, which holds
+// rowBytes + 1 bytes.  prior is the previous unfiltered row, or zeros for the first row.
+//
+// Returns libpng's heuristic cost of the filtered row: the sum of its bytes taken as signed
+// values.  Once that passes limit, the row is left unfinished.
+template <typename Predictor>
+static size_t filter_row(int type, int bpp, const uint8_t* row, const uint8_t* prior,
+                         size_t rowBytes, uint8_t* dst, size_t limit, Predictor predict) {
+    *dst++ = SkToU8(type);
+    size_t sum = 0;
+    auto filter = [&](size_t i, int prediction) {
+        uint8_t filtered = row[i] - SkToU8(prediction);
+        dst[i] = filtered;
+        sum += filtered < 128 ? filtered : 256 - filtered;
+    };
+
+    for (int i = 0; i < bpp; ++i) {
+        filter(i, predict(0, prior[i], 0));
+    }
+    for (size_t i = bpp; i < rowBytes && sum <= limit;) {
+        for (size_t end = std::min(rowBytes, i + 256); i < end; ++i) {
+            filter(i, predict(row[i - bpp], prior[i], prior[i - bpp]));
+        }
+    }
+    return sum;
+}
+
+static size_t filter_row(int type, int bpp, const uint8_t* row, const uint8_t* prior,
+                         size_t rowBytes, uint8_t* dst, size_t limit) {
+    switch (type) {
+        case PNG_FILTER_VALUE_NONE:
+            return filter_row(type, bpp, row, prior, rowBytes, dst, limit,
+                              [](int, int, int) { return 0; });
+        case PNG_FILTER_VALUE_SUB:
+            return filter_row(type, bpp, row, prior, rowBytes, dst, limit,
+                              [](int a, int, int) { return a; });
+        case PNG_FILTER_VALUE_UP:
+            return filter_row(type, bpp, row, prior, rowBytes, dst, limit,
+                              [](int, int b, int) { return b; });
+        case PNG_FILTER_VALUE_AVG:
+            return filter_row(type, bpp, row, prior, rowBytes, dst, limit,
+                              [](int a, int b, int) { return (a + b) >> 1; });
+        case PNG_FILTER_VALUE_PAETH:
+            return filter_row(type, bpp, row, prior, rowBytes, dst, limit,
+                              [](int a, int b, int c) {
+                                  int p = a + b - c;
+                                  int pa = std::abs(p - a),
+                                      pb = std::abs(p - b),
+                                      pc = std::abs(p - c);
+                                  return pa <= pb && pa <= pc ? a
+                                       : pb <= pc             ? b
+                                                              : c;
+                              });
+    }
+    SkASSERT(false);
+    return 0;
+}
+
+// Filters row with each filter allowed by filters (a mask of PNG_FILTER_* flags), writing the
+// cheapest to dst.  dst and scratch each hold rowBytes + 1 bytes.
+static void filter_row_best(int filters, int bpp, const uint8_t* row, const uint8_t* prior,
+                            size_t rowBytes, uint8_t* dst, uint8_t* scratch) {
+    // Indexed by filter type.
+    static constexpr int kFlags[] = { PNG_FILTER_NONE, PNG_FILTER_SUB, PNG_FILTER_UP,
+                                      PNG_FILTER_AVG,  PNG_FILTER_PAETH };
+    size_t bestCost = SIZE_MAX;
+    for (int type = 0; type < (int)SK_ARRAY_COUNT(kFlags); ++type) {
+        if (!(filters & kFlags[type])) {
+            continue;
+        }
+        if (bestCost == SIZE_MAX) {
+            bestCost = filter_row(type, bpp, row, prior, rowBytes, dst, SIZE_MAX);
+            continue;
+        }
+        size_t cost = filter_row(type, bpp, row, prior, rowBytes, scratch, bestCost);
+        if (cost < bestCost) {
+            bestCost = cost;
+            memcpy(dst, scratch, rowBytes + 1);
+        }
+    }
+}
+
+// The compressed data for rows [fTop, fBottom).
+struct PngBand {
+    int fTop = 0;
+    int fBottom = 0;
+    SkDynamicMemoryWStream fOutput;
+    size_t fInputSize = 0;
+    uLong fAdler = 0;
+};
+
+// Transforms, filters and raw deflates band's rows.  The rows just above the band are filtered
+// too, as the dictionary the band's deflate starts from, so bands need nothing from each other.
+static void encode_band(const SkPixmap& src, transform_scanline_proc proc, int bpp, int filters,
+                        int zlibLevel, bool last, PngBand* band) {
+    const size_t rowBytes = (size_t)src.width() * bpp,
+                 filteredRowBytes = rowBytes + 1;
+    const int dictionaryRows = std::min(band->fTop, SkToInt((kDictionarySize + filteredRowBytes - 1)
+                                                            / filteredRowBytes));
+    const int firstRow = band->fTop - dictionaryRows;
+
+    // Rows already in the png's format can be filtered straight from src.
+    const bool transform = proc != transform_scanline_memcpy;
+    SkAutoTMalloc<uint8_t> rows(transform ? 2 * rowBytes : 0),
+                           zeros(firstRow == 0 ? rowBytes : 0),
+                           filtered((band->fBottom - firstRow) * filteredRowBytes),
+                           scratch(filteredRowBytes);
+    auto get_row = [&](int y, uint8_t* storage) -> const uint8_t* {
+        const char* srcRow = (const char*)src.addr(0, y);
+        sk_msan_assert_initialized(srcRow, srcRow + (src.width() << src.shiftPerPixel()));
+        if (!transform) {
+            return (const uint8_t*)srcRow;
+        }
+        proc((char*)storage, srcRow, src.width(), src.info().bytesPerPixel());
+        return storage;
+    };
+
+    // Transformed rows alternate between two buffers, so the prior row is still around.
+    auto storage = [&](int y) { return transform ? rows.get() + (y & 1) * rowBytes : nullptr; };
+    const uint8_t* prior;
+    if (firstRow == 0) {
+        sk_bzero(zeros.get(), rowBytes);
+        prior = zeros.get();
+    } else {
+        prior = get_row(firstRow - 1, storage(firstRow - 1));
+    }
+    for (int y = firstRow; y < band->fBottom; ++y) {
+        const uint8_t* row = get_row(y, storage(y));
+        filter_row_best(filters, bpp, row, prior, rowBytes,
+                        filtered.get() + (y - firstRow) * filteredRowBytes, scratch.get());
+        prior = row;
+    }
+
+    z_stream zStream = {};
+    SkDEBUGCODE(int r =) deflateInit2(&zStream, zlibLevel, Z_DEFLATED, -MAX_WBITS, 8,
+                                      filters == PNG_FILTER_NONE ? Z_DEFAULT_STRATEGY
+                                                                 : Z_FILTERED);
+    SkASSERT(Z_OK == r);
+    if (dictionaryRows > 0) {
+        size_t dictionarySize = std::min(kDictionarySize, dictionaryRows * filteredRowBytes);
+        SkDEBUGCODE(r =) deflateSetDictionary(&zStream,
+                                              filtered.get() + dictionaryRows * filteredRowBytes
+                                                             - dictionarySize,
+                                              SkToUInt(dictionarySize));
+        SkASSERT(Z_OK == r);
+    }
+
+    uint8_t* input = filtered.get() + dictionaryRows * filteredRowBytes;
+    band->fInputSize = (band->fBottom - band->fTop) * filteredRowBytes;
+    zStream.next_in = input;
+    zStream.avail_in = SkToUInt(band->fInputSize);
+    uint8_t outBuffer[16384];
+    do {
+        zStream.next_out = outBuffer;
+        zStream.avail_out = sizeof(outBuffer);
+        SkDEBUGCODE(int returnValue =) deflate(&zStream, last ? Z_FINISH : Z_SYNC_FLUSH);
+        SkASSERT(returnValue != Z_STREAM_ERROR);
+        band->fOutput.write(outBuffer, sizeof(outBuffer) - zStream.avail_out);
+    } while (zStream.avail_in || !zStream.avail_out);
+    (void)deflateEnd(&zStream);
+
+    band->fAdler = adler32(adler32(0, nullptr, 0), input, SkToUInt(band->fInputSize));
+}
+
+bool SkPngEncoderMgr::writeChunk(const char* name, const void* data, size_t length) {
+    if (setjmp(png_jmpbuf(fPngPtr))) {
+        return false;
+    }
+
+    png_write_chunk(fPngPtr, (png_const_bytep)name, (png_const_bytep)data, length);
+    return true;
+}
+
+bool SkPngEncoderMgr::canEncodeParallel(const SkPixmap& src) const {
+    // 16-bit rows would filter the same way, but the F16 filler is only dropped by libpng.
+    return fExecutor && fProc && fBitDepth == 8 && !fHasFiller &&
+           (size_t)src.height() * src.width() * fPngBytesPerPixel >= 2 * kParallelBandSize;
+}
+
+bool SkPngEncoderMgr::encodeParallel(const SkPixmap& src) {
+    SkASSERT(this->canEncodeParallel(src));
+    const size_t filteredRowBytes = (size_t)src.width() * fPngBytesPerPixel + 1;
+    const int bandRows = SkToInt(std::max<size_t>(1, kParallelBandSize / filteredRowBytes)),
+              bandCount = (src.height() + bandRows - 1) / bandRows;
+
+    // deflate() would write this zlib header for a 32K window, and FLEVEL for fZLibLevel.
+    const uint8_t header[] = {
+        0x78, SkToU8(fZLibLevel <= 1 ? 0x01 : fZLibLevel <= 5 ? 0x5E : fZLibLevel == 6 ? 0x9C
+                                                                                       : 0xDA) };
+    uLong adler = adler32(0, nullptr, 0);
+    SkTaskGroup taskGroup(*fExecutor);
+    for (int firstBand = 0; firstBand < bandCount; firstBand += kMaxPendingBands) {
+        const int count = std::min(kMaxPendingBands, bandCount - firstBand);
+        std::unique_ptr<PngBand[]> bands(new PngBand[count]);
+        taskGroup.batch(count, [&](int i) {
+            int index = firstBand + i;
+            bands[i].fTop    = index * bandRows;
+            bands[i].fBottom = std::min(src.height(), bands[i].fTop + bandRows);
+            encode_band(src, fProc, fPngBytesPerPixel, fFilters, fZLibLevel,
+                        index == bandCount - 1, &bands[i]);
+        });
+        taskGroup.wait();
+
+        // Each band becomes its own IDAT chunk.
+        for (int i = 0; i < count; ++i) {
+            PngBand& band = bands[i];
+            SkDynamicMemoryWStream idat;
+            if (band.fTop == 0) {
+                idat.write(header, sizeof(header));
+            }
+            band.fOutput.writeToAndReset(&idat);
+            adler = adler32_combine(adler, band.fAdler, (z_off_t)band.fInputSize);
+            if (band.fBottom == src.height()) {
+                const uint8_t trailer[] = { (uint8_t)(adler >> 24), (uint8_t)(adler >> 16),
+                                            (uint8_t)(adler >>  8), (uint8_t)(adler >>  0) };
+                idat.write(trailer, sizeof(trailer));
+            }
+            sk_sp<SkData> data = idat.detachAsData();
+            if (!this->writeChunk("IDAT", data->data(), data->size())) {
+                return false;
+            }
+        }
+    }
+
+    // Nothing was added to the info after writeInfo(), so png_write_end() would only add IEND.
+    return this->writeChunk("IEND", nullptr, 0);
+}
+
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
                                               const Options& options) {
     if (!SkPixmapIsValid(src)) {
@@ -457,20 +716,29 @@ SkPngEncoder::SkPngEncoder(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const Sk
 SkPngEncoder::~SkPngEncoder() {}
 
 bool SkPngEncoder::onEncodeRows(int numRows) {
+    if (fCurrRow == 0 && numRows == fSrc.height() && fEncoderMgr->canEncodeParallel(fSrc)) {
+        fCurrRow = numRows;
+        return fEncoderMgr->encodeParallel(fSrc);
+    }
+
     if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
         return false;
     }
 
+    // Rows already in the png's format (e.g. unpremul RGBA_8888) are passed to libpng as is.
+    const bool transform = fEncoderMgr->proc() != transform_scanline_memcpy;
     const void* srcRow = fSrc.addr(0, fCurrRow);
     for (int y = 0; y < numRows; y++) {
         sk_msan_assert_initialized(srcRow,
                                    (const uint8_t*)srcRow + (fSrc.width() << fSrc.shiftPerPixel()));
-        fEncoderMgr->proc()((char*)fStorage.get(),
-                            (const char*)srcRow,
-                            fSrc.width(),
-                            SkColorTypeBytesPerPixel(fSrc.colorType()));
-
-        png_bytep rowPtr = (png_bytep) fStorage.get();
+        png_bytep rowPtr = (png_bytep)srcRow;
+        if (transform) {
+            fEncoderMgr->proc()((char*)fStorage.get(),
+                                (const char*)srcRow,
+                                fSrc.width(),
+                                SkColorTypeBytesPerPixel(fSrc.colorType()));
+            rowPtr = (png_bytep) fStorage.get();
+        }
         png_write_rows(fEncoderMgr->pngPtr(), &rowPtr, 1);
         srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
     }
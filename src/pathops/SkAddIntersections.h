@@ -12,4 +12,8 @@ class SkOpContour;
 
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence);
 
+// Sets how many segment pairs a contour pair needs before AddIntersectTs() sweeps their bounds
+// instead of comparing every pair, on the calling thread. Returns the previous value.
+int SetMinSweepSegmentPairsForTesting(int pairs);
+
 #endif
@@ -16,6 +16,8 @@
 #include "include/private/SkTDArray.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkTSort.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pathops/SkOpContour.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
 #include "src/pathops/SkOpSegment.h"
@@ -25,6 +27,7 @@
 #include "src/pathops/SkPathWriter.h"
 
 #include <cstdint>
+#include <vector>
 
 static bool one_contour(const SkPath& path) {
     SkSTArenaAlloc<256> allocator;
@@ -136,11 +139,101 @@ void SkOpBuilder::reset() {
     fOps.reset();
 }
 
+static int find_cluster(SkTDArray<int>* parents, int index) {
+    while ((*parents)[index] != index) {
+        (*parents)[index] = (*parents)[(*parents)[index]];
+        index = (*parents)[index];
+    }
+    return index;
+}
+
+// If every op is a union of a non-inverse path, groups the paths whose bounds touch, directly or
+// through other paths, and returns the number of groups; each path's group is written to clusters,
+// numbered in the order of their first path. Otherwise returns zero.
+int SkOpBuilder::findUnionClusters(SkTDArray<int>* clusters) const {
+    int count = fOps.size();
+    for (int index = 0; index < count; ++index) {
+        if (kUnion_SkPathOp != fOps[index] || fPathRefs[index].isInverseFillType()) {
+            return 0;
+        }
+    }
+    SkTDArray<int> order;
+    SkTDArray<int> parents;
+    for (int index = 0; index < count; ++index) {
+        *order.append() = index;
+        *parents.append() = index;
+    }
+    SkTQSort(order.begin(), order.end(), [this](int a, int b) {
+        return fPathRefs[a].getBounds().fLeft < fPathRefs[b].getBounds().fLeft;
+    });
+    // Sweep from left to right, joining each path to the paths still open that it touches.
+    SkTDArray<int> open;
+    for (int index : order) {
+        const SkRect& bounds = fPathRefs[index].getBounds();
+        for (int inner = 0; inner < open.size(); ) {
+            const SkRect& openBounds = fPathRefs[open[inner]].getBounds();
+            if (openBounds.fRight < bounds.fLeft) {
+                open.removeShuffle(inner);
+                continue;
+            }
+            if (openBounds.fTop <= bounds.fBottom && bounds.fTop <= openBounds.fBottom) {
+                parents[find_cluster(&parents, open[inner])] = find_cluster(&parents, index);
+            }
+            ++inner;
+        }
+        *open.append() = index;
+    }
+    SkTDArray<int> numbers;
+    for (int index = 0; index < count; ++index) {
+        *numbers.append() = -1;
+    }
+    clusters->reset();
+    int clusterCount = 0;
+    for (int index = 0; index < count; ++index) {
+        int root = find_cluster(&parents, index);
+        if (numbers[root] < 0) {
+            numbers[root] = clusterCount++;
+        }
+        *clusters->append() = numbers[root];
+    }
+    return clusterCount;
+}
+
 /* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
    paths with union ops could be locally resolved and still improve over doing the
    ops one at a time. */
-bool SkOpBuilder::resolve(SkPath* result) {
+bool SkOpBuilder::resolve(SkPath* result, SkExecutor* executor) {
     SkPath original = *result;
+    SkTDArray<int> clusters;
+    int clusterCount = executor ? this->findUnionClusters(&clusters) : 0;
+    if (clusterCount > 1) {
+        struct Cluster {
+            SkOpBuilder fBuilder;
+            SkPath fResult;
+            bool fSucceeded;
+        };
+        std::vector<Cluster> parts(clusterCount);
+        for (int index = 0; index < fOps.size(); ++index) {
+            parts[clusters[index]].fBuilder.add(fPathRefs[index], kUnion_SkPathOp);
+        }
+        reset();
+        SkTaskGroup group(*executor);
+        group.batch(clusterCount, [&](int index) {
+            parts[index].fSucceeded = parts[index].fBuilder.resolve(&parts[index].fResult);
+        });
+        group.wait();
+        SkPath sum;
+        for (const Cluster& part : parts) {
+            if (!part.fSucceeded) {
+                *result = original;
+                return false;
+            }
+            sum.addPath(part.fResult);
+        }
+        sum.setFillType(SkPathFillType::kEvenOdd);
+        *result = sum;
+        return true;
+    }
     int count = fOps.size();
     bool allUnion = true;
     SkPathFirstDirection firstDir = SkPathFirstDirection::kUnknown;
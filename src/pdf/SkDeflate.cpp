@@ -8,13 +8,16 @@
 #include "src/pdf/SkDeflate.h"
 
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/private/SkMalloc.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 
 #include "zlib.h"
 
 #include <algorithm>
+#include <deque>
 
 namespace {
 
@@ -56,28 +59,152 @@ static void do_deflate(int flush,
                  : returnValue == Z_OK);
 }
 
+// In parallel mode the input is cut into blocks of this size, each deflated on its own.
+static constexpr size_t kParallelBlockSize = 128 * 1024;
+// Each block is primed with this much of the input that precedes it (deflate's window size).
+static constexpr size_t kDictionarySize = 32 * 1024;
+// Bound on how many blocks (and so how much memory) may be in flight at once.
+static constexpr size_t kMaxPendingBlocks = 32;
+
+// One independently deflated piece of a parallel stream.
+struct DeflateBlock {
+    sk_sp<SkData> fInput;
+    size_t fInputSize = 0;
+    sk_sp<SkData> fDictionary;      // The previous block's input, or null for the first block.
+    size_t fDictionarySize = 0;     // Bytes at the end of fDictionary to prime with.
+    int fCompressionLevel = -1;
+    bool fLast = false;
+
+    SkDynamicMemoryWStream fOutput;
+    uLong fAdler = 0;
+
+    // Deflate fInput as raw deflate data.  Every block but the last ends in a sync flush, so
+    // it stops on a byte boundary with BFINAL unset and the next block can follow directly.
+    void compress() {
+        TRACE_EVENT0("skia", TRACE_FUNC);
+        z_stream zStream;
+        zStream.next_in = nullptr;
+        zStream.zalloc = &skia_alloc_func;
+        zStream.zfree = &skia_free_func;
+        zStream.opaque = nullptr;
+        SkDEBUGCODE(int r =) deflateInit2(&zStream, fCompressionLevel, Z_DEFLATED, -0x0F,
+                                          8, Z_DEFAULT_STRATEGY);
+        SkASSERT(Z_OK == r);
+        if (fDictionary) {
+            const unsigned char* dict = fDictionary->bytes() + fDictionary->size()
+                                                             - fDictionarySize;
+            SkDEBUGCODE(r =) deflateSetDictionary(&zStream, dict, SkToUInt(fDictionarySize));
+            SkASSERT(Z_OK == r);
+        }
+        // Later blocks share fInput as their dictionary, so it is read-only by now.
+        unsigned char* input = fInput ? (unsigned char*)fInput->data() : nullptr;
+        zStream.next_in = input;
+        zStream.avail_in = SkToUInt(fInputSize);
+        unsigned char outBuffer[SKDEFLATEWSTREAM_OUTPUT_BUFFER_SIZE];
+        do {
+            zStream.next_out = outBuffer;
+            zStream.avail_out = sizeof(outBuffer);
+            SkDEBUGCODE(int returnValue =) deflate(&zStream, fLast ? Z_FINISH : Z_SYNC_FLUSH);
+            SkASSERT(returnValue != Z_STREAM_ERROR && !zStream.msg);
+            fOutput.write(outBuffer, sizeof(outBuffer) - zStream.avail_out);
+        } while (zStream.avail_in || !zStream.avail_out);
+        (void)deflateEnd(&zStream);
+
+        fAdler = adler32(adler32(0, nullptr, 0), input, SkToUInt(fInputSize));
+        fDictionary = nullptr;
+    }
+};
+
 // Hide all zlib impl details.
 struct SkDeflateWStream::Impl {
     SkWStream* fOut;
     unsigned char fInBuffer[SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE];
     size_t fInBufferIndex;
     z_stream fZStream;
+
+    // Only used in parallel mode, when fExecutor is set.
+    SkExecutor* fExecutor = nullptr;
+    int fCompressionLevel = -1;
+    sk_sp<SkData> fBlockInput;
+    size_t fBlockInputIndex = 0;
+    sk_sp<SkData> fPreviousInput;
+    size_t fTotalIn = 0;
+    uLong fAdler = 1;
+    SkTaskGroup fTaskGroup;
+    std::deque<std::unique_ptr<DeflateBlock>> fPending;
+
+    explicit Impl(SkExecutor* executor)
+        : fExecutor(executor)
+        , fTaskGroup(executor ? *executor : SkExecutor::GetDefault()) {}
+
+    void submitBlock(bool last) {
+        auto block = std::make_unique<DeflateBlock>();
+        block->fInput = std::move(fBlockInput);
+        block->fInputSize = fBlockInputIndex;
+        if (fPreviousInput) {
+            block->fDictionarySize = std::min(kDictionarySize, fPreviousInput->size());
+            block->fDictionary = std::move(fPreviousInput);
+        }
+        block->fCompressionLevel = fCompressionLevel;
+        block->fLast = last;
+        fPreviousInput = block->fInput;
+        fBlockInputIndex = 0;
+
+        DeflateBlock* blockPtr = block.get();
+        fPending.push_back(std::move(block));
+        if (last && fPending.size() == 1) {
+            blockPtr->compress();  // Nothing to overlap with; don't bother with a task.
+        } else {
+            fTaskGroup.add([blockPtr] { blockPtr->compress(); });
+        }
+        if (fPending.size() >= kMaxPendingBlocks) {
+            fTaskGroup.wait();
+        }
+        if (fTaskGroup.done()) {
+            this->drainBlocks();
+        }
+    }
+
+    // Write out every queued block, in order.  All of them must be compressed already.
+    void drainBlocks() {
+        for (const std::unique_ptr<DeflateBlock>& block : fPending) {
+            block->fOutput.writeToAndReset(fOut);
+            fAdler = adler32_combine(fAdler, block->fAdler, (z_off_t)block->fInputSize);
+        }
+        fPending.clear();
+    }
 };
 
+// The zlib header's FLEVEL bits are informational only, but match what deflate() would write.
+static void write_zlib_header(SkWStream* out, int compressionLevel) {
+    uint8_t flg = compressionLevel == 0 || compressionLevel == 1 ? 0x01
+                : compressionLevel >= 2 && compressionLevel <= 5 ? 0x5E
+                : compressionLevel >= 7                          ? 0xDA
+                                                                 : 0x9C;
+    const uint8_t header[] = { 0x78, flg };
+    out->write(header, sizeof(header));
+}
+
 SkDeflateWStream::SkDeflateWStream(SkWStream* out,
                                    int compressionLevel,
-                                   bool gzip)
-    : fImpl(std::make_unique<SkDeflateWStream::Impl>()) {
+                                   bool gzip,
+                                   SkExecutor* executor)
+    : fImpl(std::make_unique<SkDeflateWStream::Impl>(gzip ? nullptr : executor)) {
     fImpl->fOut = out;
     fImpl->fInBufferIndex = 0;
     if (!fImpl->fOut) {
         return;
     }
+    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+    if (fImpl->fExecutor) {
+        fImpl->fCompressionLevel = compressionLevel;
+        write_zlib_header(fImpl->fOut, compressionLevel);
+        return;
+    }
     fImpl->fZStream.next_in = nullptr;
     fImpl->fZStream.zalloc = &skia_alloc_func;
     fImpl->fZStream.zfree = &skia_free_func;
     fImpl->fZStream.opaque = nullptr;
-    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
     SkDEBUGCODE(int r =) deflateInit2(&fImpl->fZStream, compressionLevel,
                                       Z_DEFLATED, gzip ? 0x1F : 0x0F,
                                       8, Z_DEFAULT_STRATEGY);
@@ -91,6 +218,18 @@ void SkDeflateWStream::finalize() {
     if (!fImpl->fOut) {
         return;
     }
+    if (fImpl->fExecutor) {
+        fImpl->submitBlock(true);
+        fImpl->fTaskGroup.wait();
+        fImpl->drainBlocks();
+        const uLong adler = fImpl->fAdler;
+        const uint8_t trailer[] = { (uint8_t)(adler >> 24), (uint8_t)(adler >> 16),
+                                    (uint8_t)(adler >>  8), (uint8_t)(adler >>  0) };
+        fImpl->fOut->write(trailer, sizeof(trailer));
+        fImpl->fPreviousInput = nullptr;
+        fImpl->fOut = nullptr;
+        return;
+    }
     do_deflate(Z_FINISH, &fImpl->fZStream, fImpl->fOut, fImpl->fInBuffer,
                fImpl->fInBufferIndex);
     (void)deflateEnd(&fImpl->fZStream);
@@ -103,6 +242,24 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
         return false;
     }
     const char* buffer = (const char*)void_buffer;
+    if (fImpl->fExecutor) {
+        fImpl->fTotalIn += len;
+        while (len > 0) {
+            if (!fImpl->fBlockInput) {
+                fImpl->fBlockInput = SkData::MakeUninitialized(kParallelBlockSize);
+            }
+            size_t tocopy = std::min(len, kParallelBlockSize - fImpl->fBlockInputIndex);
+            memcpy((char*)fImpl->fBlockInput->writable_data() + fImpl->fBlockInputIndex,
+                   buffer, tocopy);
+            len -= tocopy;
+            buffer += tocopy;
+            fImpl->fBlockInputIndex += tocopy;
+            if (kParallelBlockSize == fImpl->fBlockInputIndex) {
+                fImpl->submitBlock(false);
+            }
+        }
+        return true;
+    }
     while (len > 0) {
         size_t tocopy =
                 std::min(len, sizeof(fImpl->fInBuffer) - fImpl->fInBufferIndex);
@@ -123,5 +280,8 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 }
 
 size_t SkDeflateWStream::bytesWritten() const {
+    if (fImpl->fExecutor) {
+        return fImpl->fTotalIn;
+    }
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
@@ -11,6 +11,8 @@
 
 #include "include/core/SkStream.h"
 
+class SkExecutor;
+
 /**
   * Wrap a stream in this class to compress the information written to
   * this stream using the Deflate algorithm.
@@ -19,6 +21,9 @@
   */
 class SkDeflateWStream final : public SkWStream {
 public:
+    /** Inputs shorter than this gain little from being deflated on an executor. */
+    static constexpr size_t kParallelMinimumSize = 256 * 1024;
+
     /** Does not take ownership of the stream.
 
         @param compressionLevel - 0 is no compression; 1 is best
@@ -29,10 +34,17 @@ public:
         a wrapper, documented in RFC 1952, around a deflate stream."
         gzip adds a header with a magic number to the beginning of the
         stream, allowing a client to identify a gzip file.
+
+        @param executor iff non-null (and gzip is false), split the input
+        into 128 KB blocks and deflate them in parallel on this executor,
+        pigz-style.  Each block is primed with the last 32 KB of the block
+        before it, and the pieces are stitched into one valid zlib stream.
+        The output is usually a little larger than the serial output.
      */
     SkDeflateWStream(SkWStream*,
                      int compressionLevel = -1,
-                     bool gzip = false);
+                     bool gzip = false,
+                     SkExecutor* executor = nullptr);
 
     /** The destructor calls finalize(). */
     ~SkDeflateWStream() override;
@@ -100,9 +100,17 @@ static void emit_image_stream(SkPDFDocument* doc,
     doc->emitStream(pdfDict, std::move(writeStream), ref);
 }
 
+// Large images are deflated a block at a time on the document's executor, if it has one.
+static SkExecutor* deflate_executor(SkPDFDocument* doc, size_t size) {
+    return size >= SkDeflateWStream::kParallelMinimumSize ? doc->executor() : nullptr;
+}
+
 static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer,
+                                    (int)doc->metadata().fImageCompressionLevel,
+                                    false,
+                                    deflate_executor(doc, SkToSizeT(pm.width()) * pm.height()));
     if (kAlpha_8_SkColorType == pm.colorType()) {
         SkASSERT(pm.rowBytes() == (size_t)pm.width());
         buffer.write(pm.addr8(), pm.width() * pm.height());
@@ -139,13 +147,17 @@ static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndir
 static void do_deflated_image(const SkPixmap& pm,
                               SkPDFDocument* doc,
                               bool isOpaque,
-                              SkPDFIndirectReference ref) {
-    SkPDFIndirectReference sMask;
-    if (!isOpaque) {
-        sMask = doc->reserveRef();
+                              SkPDFIndirectReference ref,
+                              SkPDFIndirectReference sMask) {
+    if (isOpaque) {
+        sMask = SkPDFIndirectReference();
     }
+    SkASSERT(isOpaque || sMask);
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer,
+                                    (int)doc->metadata().fImageCompressionLevel,
+                                    false,
+                                    deflate_executor(doc, SkToSizeT(pm.width()) * pm.height() * 3));
     const char* colorSpace = "DeviceGray";
     switch (pm.colorType()) {
         case kAlpha_8_SkColorType:
@@ -248,16 +260,31 @@ static SkBitmap to_pixels(const SkImage* image) {
     return bm;
 }
 
+namespace {
+struct NullObject final : public SkPDFObject {
+    void emitObject(SkWStream* stream) const override { stream->writeText("null"); }
+};
+}  // namespace
+
 void serialize_image(const SkImage* img,
                      int encodingQuality,
                      SkPDFDocument* doc,
-                     SkPDFIndirectReference ref) {
+                     SkPDFIndirectReference ref,
+                     SkPDFIndirectReference sMask) {
     SkASSERT(img);
     SkASSERT(doc);
     SkASSERT(encodingQuality >= 0);
     SkISize dimensions = img->dimensions();
+    // A soft mask's reference, if the image might need one, was reserved up front.  Fill it even
+    // if it turns out not to be needed, since the document's cross-reference table must be whole.
+    auto fillUnusedSMask = [&] {
+        if (sMask) {
+            doc->emit(NullObject(), sMask);
+        }
+    };
     if (sk_sp<SkData> data = img->refEncodedData()) {
         if (do_jpeg(std::move(data), doc, dimensions, ref)) {
+            fillUnusedSMask();
             return;
         }
     }
@@ -267,11 +294,15 @@ void serialize_image(const SkImage* img,
     if (encodingQuality <= 100 && isOpaque) {
         if (sk_sp<SkData> data = img->encodeToData(SkEncodedImageFormat::kJPEG, encodingQuality)) {
             if (do_jpeg(std::move(data), doc, dimensions, ref)) {
+                fillUnusedSMask();
                 return;
             }
         }
     }
-    do_deflated_image(pm, doc, isOpaque, ref);
+    if (isOpaque) {
+        fillUnusedSMask();
+    }
+    do_deflated_image(pm, doc, isOpaque, ref, sMask);
 }
 
 SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
@@ -280,16 +311,19 @@ SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
     SkASSERT(img);
     SkASSERT(doc);
     SkPDFIndirectReference ref = doc->reserveRef();
-    if (SkExecutor* executor = doc->executor()) {
+    // Reserved here rather than in the job, which mustn't reserve references.
+    SkPDFIndirectReference sMask;
+    if (!img->isOpaque()) {
+        sMask = doc->reserveRef();
+    }
+    if (doc->executor()) {
         SkRef(img);
-        doc->incrementJobCount();
-        executor->add([img, encodingQuality, doc, ref]() {
-            serialize_image(img, encodingQuality, doc, ref);
+        doc->addJob([img, encodingQuality, doc, ref, sMask]() {
+            serialize_image(img, encodingQuality, doc, ref, sMask);
             SkSafeUnref(img);
-            doc->signalJobComplete();
         });
         return ref;
     }
-    serialize_image(img, encodingQuality, doc, ref);
+    serialize_image(img, encodingQuality, doc, ref, sMask);
     return ref;
 }
@@ -11,6 +11,7 @@
 #include "include/core/SkStream.h"
 #include "include/docs/SkPDFDocument.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pdf/SkPDFDevice.h"
 #include "src/pdf/SkPDFFont.h"
 #include "src/pdf/SkPDFGradientShader.h"
@@ -102,14 +103,6 @@ static void serializeHeader(SkPDFOffsetMap* offsetMap, SkWStream* wStream) {
 }
 #undef SKPDF_MAGIC
 
-static void begin_indirect_object(SkPDFOffsetMap* offsetMap,
-                                  SkPDFIndirectReference ref,
-                                  SkWStream* s) {
-    offsetMap->markStartOfObject(ref.fValue, s);
-    s->writeDecAsText(ref.fValue);
-    s->writeText(" 0 obj\n");  // Generation number is always 0.
-}
-
 static void end_indirect_object(SkWStream* s) { s->writeText("\nendobj\n"); }
 
 // Xref table and footer
@@ -135,55 +128,58 @@ static void serialize_footer(const SkPDFOffsetMap& offsetMap,
     wStream->writeText("\n%%EOF");
 }
 
+// PDF wants a tree describing all the pages in the document.  We arbitrary
+// choose 8 (kMaxNodeSize) as the number of allowed children.  The internal
+// nodes have type "Pages" with an array of children, a parent pointer, and
+// the number of leaves below the node as "Count."  The leaves have type "Page"
+// and need a parent pointer.  The tree is built bottom up, skipping internal
+// nodes that would have only one child.
+namespace {
+struct PageTreeNode {
+    std::unique_ptr<SkPDFDict> fNode;
+    SkPDFIndirectReference fReservedRef;
+    int fPageObjectDescendantCount;
+
+    static constexpr size_t kMaxNodeSize = 8;
+
+    static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
+        std::vector<PageTreeNode> result;
+        const size_t n = vec.size();
+        SkASSERT(n >= 1);
+        const size_t result_len = (n - 1) / kMaxNodeSize + 1;
+        SkASSERT(result_len >= 1);
+        SkASSERT(n == 1 || result_len < n);
+        result.reserve(result_len);
+        size_t index = 0;
+        for (size_t i = 0; i < result_len; ++i) {
+            if (n != 1 && index + 1 == n) {  // No need to create a new node.
+                result.push_back(std::move(vec[index++]));
+                continue;
+            }
+            SkPDFIndirectReference parent = doc->reserveRef();
+            auto kids_list = SkPDFMakeArray();
+            int descendantCount = 0;
+            for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
+                PageTreeNode& node = vec[index++];
+                node.fNode->insertRef("Parent", parent);
+                kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
+                descendantCount += node.fPageObjectDescendantCount;
+            }
+            auto next = SkPDFMakeDict("Pages");
+            next->insertInt("Count", descendantCount);
+            next->insertObject("Kids", std::move(kids_list));
+            result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
+        }
+        return result;
+    }
+};
+}  // namespace
+
 static SkPDFIndirectReference generate_page_tree(
         SkPDFDocument* doc,
         std::vector<std::unique_ptr<SkPDFDict>> pages,
         const std::vector<SkPDFIndirectReference>& pageRefs) {
-    // PDF wants a tree describing all the pages in the document.  We arbitrary
-    // choose 8 (kNodeSize) as the number of allowed children.  The internal
-    // nodes have type "Pages" with an array of children, a parent pointer, and
-    // the number of leaves below the node as "Count."  The leaves are passed
-    // into the method, have type "Page" and need a parent pointer. This method
-    // builds the tree bottom up, skipping internal nodes that would have only
-    // one child.
     SkASSERT(pages.size() > 0);
-    struct PageTreeNode {
-        std::unique_ptr<SkPDFDict> fNode;
-        SkPDFIndirectReference fReservedRef;
-        int fPageObjectDescendantCount;
-
-        static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
-            std::vector<PageTreeNode> result;
-            static constexpr size_t kMaxNodeSize = 8;
-            const size_t n = vec.size();
-            SkASSERT(n >= 1);
-            const size_t result_len = (n - 1) / kMaxNodeSize + 1;
-            SkASSERT(result_len >= 1);
-            SkASSERT(n == 1 || result_len < n);
-            result.reserve(result_len);
-            size_t index = 0;
-            for (size_t i = 0; i < result_len; ++i) {
-                if (n != 1 && index + 1 == n) {  // No need to create a new node.
-                    result.push_back(std::move(vec[index++]));
-                    continue;
-                }
-                SkPDFIndirectReference parent = doc->reserveRef();
-                auto kids_list = SkPDFMakeArray();
-                int descendantCount = 0;
-                for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
-                    PageTreeNode& node = vec[index++];
-                    node.fNode->insertRef("Parent", parent);
-                    kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
-                    descendantCount += node.fPageObjectDescendantCount;
-                }
-                auto next = SkPDFMakeDict("Pages");
-                next->insertInt("Count", descendantCount);
-                next->insertObject("Kids", std::move(kids_list));
-                result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
-            }
-            return result;
-        }
-    };
     std::vector<PageTreeNode> currentLayer;
     currentLayer.reserve(pages.size());
     SkASSERT(pages.size() == pageRefs.size());
@@ -199,6 +195,35 @@ static SkPDFIndirectReference generate_page_tree(
     return doc->emit(*root.fNode, root.fReservedRef);
 }
 
+// When pages are streamed, each has already been written as a kid of the node reserved for every
+// kMaxNodeSize pages, so the tree is built up from those nodes instead.
+static SkPDFIndirectReference generate_streamed_page_tree(
+        SkPDFDocument* doc,
+        const std::vector<SkPDFIndirectReference>& pageNodeRefs,
+        const std::vector<SkPDFIndirectReference>& pageRefs) {
+    SkASSERT(pageNodeRefs.size() == (pageRefs.size() - 1) / PageTreeNode::kMaxNodeSize + 1);
+    std::vector<PageTreeNode> currentLayer;
+    currentLayer.reserve(pageNodeRefs.size());
+    for (size_t i = 0; i < pageNodeRefs.size(); ++i) {
+        size_t first = i * PageTreeNode::kMaxNodeSize;
+        size_t count = std::min(PageTreeNode::kMaxNodeSize, pageRefs.size() - first);
+        auto kids_list = SkPDFMakeArray();
+        kids_list->reserve(count);
+        for (size_t j = first; j < first + count; ++j) {
+            kids_list->appendRef(pageRefs[j]);
+        }
+        auto node = SkPDFMakeDict("Pages");
+        node->insertInt("Count", SkToInt(count));
+        node->insertObject("Kids", std::move(kids_list));
+        currentLayer.push_back(PageTreeNode{std::move(node), pageNodeRefs[i], SkToInt(count)});
+    }
+    while (currentLayer.size() > 1) {
+        currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    }
+    const PageTreeNode& root = currentLayer[0];
+    return doc->emit(*root.fNode, root.fReservedRef);
+}
+
 template<typename T, typename... Args>
 static void reset_object(T* dst, Args&&... args) {
     dst->~T();
@@ -227,20 +252,72 @@ SkPDFDocument::~SkPDFDocument() {
     this->close();
 }
 
+struct SkPDFDocument::Output {
+    SkDynamicMemoryWStream fBytes;
+    // Reference numbers of the objects in fBytes, and where each starts.
+    std::vector<std::pair<int, size_t>> fObjectOffsets;
+    bool fIsJob = false;
+    bool fJobDone = false;
+};
+
+thread_local SkPDFDocument::Output* SkPDFDocument::gJobOutput = nullptr;
+
 SkPDFIndirectReference SkPDFDocument::emit(const SkPDFObject& object, SkPDFIndirectReference ref){
     SkAutoMutexExclusive lock(fMutex);
-    object.emitObject(this->beginObject(ref));
-    this->endObject();
+    SkWStream* stream = this->beginObject(ref);
+    object.emitObject(stream);
+    this->endObject(stream);
     return ref;
 }
 
+SkPDFDocument::Output* SkPDFDocument::currentOutput() SK_REQUIRES(fMutex) {
+    if (gJobOutput) {
+        return gJobOutput;
+    }
+    if (fOutputs.empty()) {
+        return nullptr;  // Nothing is waiting to be written, so write straight to the stream.
+    }
+    if (fOutputs.back()->fIsJob) {
+        fOutputs.push_back(std::make_unique<Output>());
+    }
+    return fOutputs.back().get();
+}
+
+void SkPDFDocument::flushOutputs() SK_REQUIRES(fMutex) {
+    SkWStream* stream = this->getStream();
+    while (!fOutputs.empty()) {
+        Output* output = fOutputs.front().get();
+        sk_sp<SkData> bytes = output->fBytes.detachAsData();
+        size_t written = 0;
+        for (auto [referenceNumber, offset] : output->fObjectOffsets) {
+            stream->write(bytes->bytes() + written, offset - written);
+            written = offset;
+            fOffsetMap.markStartOfObject(referenceNumber, stream);
+        }
+        stream->write(bytes->bytes() + written, bytes->size() - written);
+        output->fObjectOffsets.clear();
+        if (output->fIsJob && !output->fJobDone) {
+            break;  // Its job may still emit more.
+        }
+        fOutputs.pop_front();
+    }
+}
+
 SkWStream* SkPDFDocument::beginObject(SkPDFIndirectReference ref) SK_REQUIRES(fMutex) {
-    begin_indirect_object(&fOffsetMap, ref, this->getStream());
-    return this->getStream();
+    SkWStream* stream = this->getStream();
+    if (Output* output = this->currentOutput()) {
+        output->fObjectOffsets.emplace_back(ref.fValue, output->fBytes.bytesWritten());
+        stream = &output->fBytes;
+    } else {
+        fOffsetMap.markStartOfObject(ref.fValue, stream);
+    }
+    stream->writeDecAsText(ref.fValue);
+    stream->writeText(" 0 obj\n");  // Generation number is always 0.
+    return stream;
 };
 
-void SkPDFDocument::endObject() SK_REQUIRES(fMutex) {
-    end_indirect_object(this->getStream());
+void SkPDFDocument::endObject(SkWStream* stream) SK_REQUIRES(fMutex) {
+    end_indirect_object(stream);
 };
 
 static SkSize operator*(SkISize u, SkScalar s) { return SkSize{u.width() * s, u.height() * s}; }
@@ -248,7 +325,7 @@ static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.h
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         // if this is the first page if the document.
         {
             SkAutoMutexExclusive autoMutexAcquire(fMutex);
@@ -280,6 +357,9 @@ SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     fPageDevice = sk_make_sp<SkPDFDevice>(pageSize, this, initialTransform);
     reset_object(&fCanvas, fPageDevice);
     fCanvas.scale(fRasterScale, fRasterScale);
+    if (fMetadata.fStreamPages && fPageRefs.size() % PageTreeNode::kMaxNodeSize == 0) {
+        fPageNodeRefs.push_back(this->reserveRef());
+    }
     fPageRefs.push_back(this->reserveRef());
     return &fCanvas;
 }
@@ -359,10 +439,12 @@ void SkPDFDocument::onEndPage() {
     auto page = SkPDFMakeDict("Page");
 
     SkSize mediaSize = fPageDevice->imageInfo().dimensions() * fInverseRasterScale;
-    std::unique_ptr<SkStreamAsset> pageContent = fPageDevice->content();
     auto resourceDict = fPageDevice->makeResourceDict();
     SkASSERT(fPageRefs.size() > 0);
-    fPageDevice = nullptr;
+    // With an executor, the page's content stream is finished (and deflated) there, alongside
+    // the pages drawn after it.
+    auto pageContent = [device = std::move(fPageDevice)]() { return device->content(); };
+    SkASSERT(!fPageDevice);
 
     page->insertObject("Resources", std::move(resourceDict));
     page->insertObject("MediaBox", SkPDFUtils::RectToArray(SkRect::MakeSize(mediaSize)));
@@ -376,6 +458,11 @@ void SkPDFDocument::onEndPage() {
     // The StructParents unique identifier for each page is just its
     // 0-based page index.
     page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
+    if (fMetadata.fStreamPages) {
+        page->insertRef("Parent", fPageNodeRefs.back());
+        this->emit(*page, fPageRefs.back());
+        return;
+    }
     fPages.emplace_back(std::move(page));
 }
 
@@ -566,7 +653,7 @@ SkString SkPDFDocument::nextFontSubsetTag() {
 
 void SkPDFDocument::onClose(SkWStream* stream) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         this->waitForJobs();
         return;
     }
@@ -579,7 +666,10 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    docCatalog->insertRef("Pages",
+                          fMetadata.fStreamPages
+                                  ? generate_streamed_page_tree(this, fPageNodeRefs, fPageRefs)
+                                  : generate_page_tree(this, std::move(fPages), fPageRefs));
 
     if (!fNamedDestinations.empty()) {
         docCatalog->insertRef("Dests", append_destinations(this, fNamedDestinations));
@@ -597,20 +687,61 @@ void SkPDFDocument::onClose(SkWStream* stream) {
 
     auto docCatalogRef = this->emit(*docCatalog);
 
-    for (const SkPDFFont* f : get_fonts(*this)) {
-        f->emitSubset(this);
+    std::vector<const SkPDFFont*> fonts = get_fonts(*this);
+    if (fExecutor) {
+        // Subsetting is most of the work of emitting fonts, so do it for all of them at once
+        // before emitting them in order.
+        std::vector<sk_sp<SkData>> subsetFontData(fonts.size());
+        SkTaskGroup subsetting(*fExecutor);
+        for (size_t i = 0; i < fonts.size(); ++i) {
+            subsetting.add([&, i]() { subsetFontData[i] = fonts[i]->makeSubsetFontData(this); });
+        }
+        subsetting.wait();
+        for (size_t i = 0; i < fonts.size(); ++i) {
+            fonts[i]->emitSubset(this, std::move(subsetFontData[i]));
+        }
+    } else {
+        for (const SkPDFFont* f : fonts) {
+            f->emitSubset(this);
+        }
     }
 
     this->waitForJobs();
     {
         SkAutoMutexExclusive autoMutexAcquire(fMutex);
+        SkASSERT(fOutputs.empty());
         serialize_footer(fOffsetMap, this->getStream(), fInfoDict, docCatalogRef, fUUID);
     }
 }
 
-void SkPDFDocument::incrementJobCount() { fJobCount++; }
-
-void SkPDFDocument::signalJobComplete() { fSemaphore.signal(); }
+void SkPDFDocument::addJob(std::function<void()> job) {
+    SkASSERT(fExecutor);
+    if (gJobOutput) {
+        // Already in a job, whose output this can just join.
+        job();
+        return;
+    }
+    Output* output;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        fOutputs.push_back(std::make_unique<Output>());
+        output = fOutputs.back().get();
+        output->fIsJob = true;
+    }
+    fJobCount++;
+    fExecutor->add([this, output, job = std::move(job)]() {
+        // This thread may have been lent to us while waiting on another job.
+        Output* waitingJobOutput = std::exchange(gJobOutput, output);
+        job();
+        gJobOutput = waitingJobOutput;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            output->fJobDone = true;
+            this->flushOutputs();
+        }
+        fSemaphore.signal();
+    });
+}
 
 void SkPDFDocument::waitForJobs() {
      // fJobCount can increase while we wait.
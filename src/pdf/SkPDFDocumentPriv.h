@@ -16,6 +16,8 @@
 #include "src/pdf/SkPDFTag.h"
 
 #include <atomic>
+#include <deque>
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -107,7 +109,7 @@ public:
         stream->writeText(" stream\n");
         writeStream(stream);
         stream->writeText("\nendstream");
-        this->endObject();
+        this->endObject(stream);
     }
 
     const SkPDF::Metadata& metadata() const { return fMetadata; }
@@ -133,9 +135,14 @@ public:
     SkString nextFontSubsetTag();
 
     SkExecutor* executor() const { return fExecutor; }
-    void incrementJobCount();
-    void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
+    // Runs job on the executor.  The objects it emits are written where they would have been had
+    // it run here instead, so the document's bytes don't depend on how jobs are scheduled.  To
+    // keep object numbering just as deterministic, jobs must not reserve references themselves.
+    void addJob(std::function<void()> job);
+    size_t currentPageIndex() {
+        SkASSERT(!fPageRefs.empty());
+        return fPageRefs.size() - 1;
+    }
     size_t pageCount() { return fPageRefs.size(); }
 
     const SkMatrix& currentPageTransform() const;
@@ -163,6 +170,9 @@ private:
     SkCanvas fCanvas;
     std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    // With fMetadata.fStreamPages, the page tree node that is the parent of each run of up to
+    // eight pages, which are written as they end rather than kept in fPages.
+    std::vector<SkPDFIndirectReference> fPageNodeRefs;
 
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
@@ -182,9 +192,18 @@ private:
     SkMutex fMutex;
     SkSemaphore fSemaphore;
 
+    // While jobs are running, emitted objects are buffered here in document order, and written
+    // to the stream as soon as everything before them has been.
+    struct Output;
+    std::deque<std::unique_ptr<Output>> fOutputs SK_GUARDED_BY(fMutex);
+    // The output of the job running on this thread, if any.
+    static thread_local Output* gJobOutput;
+
     void waitForJobs();
-    SkWStream* beginObject(SkPDFIndirectReference);
-    void endObject();
+    Output* currentOutput() SK_REQUIRES(fMutex);
+    void flushOutputs() SK_REQUIRES(fMutex);
+    SkWStream* beginObject(SkPDFIndirectReference) SK_REQUIRES(fMutex);
+    void endObject(SkWStream*) SK_REQUIRES(fMutex);
 };
 
 #endif  // SkPDFDocumentPriv_DEFINED
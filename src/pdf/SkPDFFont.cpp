@@ -294,7 +294,8 @@ static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
     return SkData::MakeFromStream(stream.get(), size);
 }
 
-static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
+static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc,
+                              sk_sp<SkData> subsetFontData) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(font.typeface(), doc);
     SkASSERT(metricsPtr);
@@ -319,29 +320,17 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     } else {
         switch (type) {
             case SkAdvancedTypefaceMetrics::kTrueType_Font: {
-                if (!SkToBool(metrics.fFlags &
-                              SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
-                    SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
-                            stream_to_data(std::move(fontAsset)), font.glyphUsage(),
-                            doc->metadata().fSubsetter,
-                            metrics.fFontName.c_str(), ttcIndex);
-                    if (subsetFontData) {
-                        std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-                        tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
-                        descriptor->insertRef(
-                                "FontFile2",
-                                SkPDFStreamOut(std::move(tmp),
-                                               SkMemoryStream::Make(std::move(subsetFontData)),
-                                               doc, true));
-                        break;
-                    }
-                    // If subsetting fails, fall back to original font data.
-                    fontAsset = face->openStream(&ttcIndex);
-                    SkASSERT(fontAsset);
-                    SkASSERT(fontAsset->getLength() == fontSize);
-                    if (!fontAsset || fontAsset->getLength() == 0) { break; }
+                if (subsetFontData) {
+                    std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
+                    tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
+                    descriptor->insertRef(
+                            "FontFile2",
+                            SkPDFStreamOut(std::move(tmp),
+                                           SkMemoryStream::Make(std::move(subsetFontData)),
+                                           doc, true));
+                    break;
                 }
+                // If the font can't be subset, embed the original font data.
                 std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                 tmp->insertInt("Length1", fontSize);
                 descriptor->insertRef("FontFile2",
@@ -681,11 +670,30 @@ static void emit_subset_type3(const SkPDFFont& pdfFont, SkPDFDocument* doc) {
     doc->emit(font, pdfFont.indirectReference());
 }
 
-void SkPDFFont::emitSubset(SkPDFDocument* doc) const {
+sk_sp<SkData> SkPDFFont::makeSubsetFontData(SkPDFDocument* doc) const {
+    if (fFontType != SkAdvancedTypefaceMetrics::kTrueType_Font) {
+        return nullptr;
+    }
+    const SkAdvancedTypefaceMetrics* metrics = SkPDFFont::GetMetrics(this->typeface(), doc);
+    if (!metrics ||
+        SkToBool(metrics->fFlags & SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
+        return nullptr;
+    }
+    int ttcIndex;
+    std::unique_ptr<SkStreamAsset> fontAsset = this->typeface()->openStream(&ttcIndex);
+    if (!fontAsset || fontAsset->getLength() == 0) {
+        return nullptr;
+    }
+    SkASSERT(this->firstGlyphID() == 1);
+    return SkPDFSubsetFont(stream_to_data(std::move(fontAsset)), this->glyphUsage(),
+                           doc->metadata().fSubsetter, metrics->fFontName.c_str(), ttcIndex);
+}
+
+void SkPDFFont::emitSubset(SkPDFDocument* doc, sk_sp<SkData> subsetFontData) const {
     switch (fFontType) {
         case SkAdvancedTypefaceMetrics::kType1CID_Font:
         case SkAdvancedTypefaceMetrics::kTrueType_Font:
-            return emit_subset_type0(*this, doc);
+            return emit_subset_type0(*this, doc, std::move(subsetFontData));
 #ifndef SK_PDF_DO_NOT_SUPPORT_TYPE_1_FONTS
         case SkAdvancedTypefaceMetrics::kType1_Font:
             return SkPDFEmitType1Font(*this, doc);
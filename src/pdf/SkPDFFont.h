@@ -106,7 +106,17 @@ public:
                                              uint16_t emSize,
                                              int16_t defaultWidth);
 
-    void emitSubset(SkPDFDocument*) const;
+    /** Returns the subset of the font's data that emitSubset() embeds, or nullptr if it embeds
+        something else.  Subsetting is slow, and safe to do for several fonts at once.
+     */
+    sk_sp<SkData> makeSubsetFontData(SkPDFDocument*) const;
+
+    /** Emits the font, embedding subsetFontData, which makeSubsetFontData() made.
+     */
+    void emitSubset(SkPDFDocument*, sk_sp<SkData> subsetFontData) const;
+    void emitSubset(SkPDFDocument* doc) const {
+        this->emitSubset(doc, this->makeSubsetFontData(doc));
+    }
 
     /**
      *  Return false iff the typeface has its NotEmbeddable flag set.
@@ -663,10 +663,11 @@ static bool split_perspective(const SkMatrix in, SkMatrix* affine,
     return true;
 }
 
-static SkPDFIndirectReference make_ps_function(std::unique_ptr<SkStreamAsset> psCode,
-                                               std::unique_ptr<SkPDFArray> domain,
-                                               std::unique_ptr<SkPDFObject> range,
-                                               SkPDFDocument* doc) {
+static SkPDFIndirectReference make_ps_function(
+        std::function<std::unique_ptr<SkStreamAsset>()> psCode,
+        std::unique_ptr<SkPDFArray> domain,
+        std::unique_ptr<SkPDFObject> range,
+        SkPDFDocument* doc) {
     std::unique_ptr<SkPDFDict> dict = SkPDFMakeDict();
     dict->insertInt("FunctionType", 4);
     dict->insertObject("Domain", std::move(domain));
@@ -789,8 +790,6 @@ static SkPDFIndirectReference make_function_shader(SkPDFDocument* doc,
         if (!SkPDFUtils::InverseTransformBBox(finalMatrix, &bbox)) {
             return SkPDFIndirectReference();
         }
-        SkDynamicMemoryWStream functionCode;
-
         SkShaderBase::GradientInfo infoCopy = info;
 
         if (state.fType == SkShaderBase::GradientType::kConical) {
@@ -802,29 +801,42 @@ static SkPDFIndirectReference make_function_shader(SkPDFDocument* doc,
             infoCopy.fRadius[0] = inverseMapperMatrix.mapRadius(info.fRadius[0]);
             infoCopy.fRadius[1] = inverseMapperMatrix.mapRadius(info.fRadius[1]);
         }
-        switch (state.fType) {
-            case SkShaderBase::GradientType::kLinear:
-                linearCode(infoCopy, perspectiveInverseOnly, &functionCode);
-                break;
-            case SkShaderBase::GradientType::kRadial:
-                radialCode(infoCopy, perspectiveInverseOnly, &functionCode);
-                break;
-            case SkShaderBase::GradientType::kConical:
-                twoPointConicalCode(infoCopy, perspectiveInverseOnly, &functionCode);
-                break;
-            case SkShaderBase::GradientType::kSweep:
-                sweepCode(infoCopy, perspectiveInverseOnly, &functionCode);
-                break;
-            default:
-                SkASSERT(false);
-        }
+        // The PostScript is generated by the job writing it out, if the document has an
+        // executor, so it copies the colors and offsets the key would otherwise lend it.
+        auto functionCode = [type = state.fType, info = infoCopy, perspectiveInverseOnly,
+                             colors = std::vector<SkColor>(infoCopy.fColors,
+                                                           infoCopy.fColors + infoCopy.fColorCount),
+                             offsets = std::vector<SkScalar>(infoCopy.fColorOffsets,
+                                                             infoCopy.fColorOffsets +
+                                                             infoCopy.fColorCount)]() mutable {
+            info.fColors = colors.data();
+            info.fColorOffsets = offsets.data();
+            SkDynamicMemoryWStream functionCode;
+            switch (type) {
+                case SkShaderBase::GradientType::kLinear:
+                    linearCode(info, perspectiveInverseOnly, &functionCode);
+                    break;
+                case SkShaderBase::GradientType::kRadial:
+                    radialCode(info, perspectiveInverseOnly, &functionCode);
+                    break;
+                case SkShaderBase::GradientType::kConical:
+                    twoPointConicalCode(info, perspectiveInverseOnly, &functionCode);
+                    break;
+                case SkShaderBase::GradientType::kSweep:
+                    sweepCode(info, perspectiveInverseOnly, &functionCode);
+                    break;
+                default:
+                    SkASSERT(false);
+            }
+            return functionCode.detachAsStream();
+        };
         pdfShader->insertObject(
                 "Domain", SkPDFMakeArray(bbox.left(), bbox.right(), bbox.top(), bbox.bottom()));
 
         auto domain = SkPDFMakeArray(bbox.left(), bbox.right(), bbox.top(), bbox.bottom());
         std::unique_ptr<SkPDFArray> rangeObject = SkPDFMakeArray(0, 1, 0, 1, 0, 1);
         pdfShader->insertRef("Function",
-                             make_ps_function(functionCode.detachAsStream(), std::move(domain),
+                             make_ps_function(std::move(functionCode), std::move(domain),
                                               std::move(rangeObject), doc));
     }
 
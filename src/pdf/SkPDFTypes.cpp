@@ -545,7 +545,12 @@ static void serialize_stream(SkPDFDict* origDict,
     static const size_t kMinimumSavings = strlen("/Filter_/FlateDecode_");
     if (deflate && stream->getLength() > kMinimumSavings) {
         SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData);
+        SkExecutor* executor = stream->getLength() >= SkDeflateWStream::kParallelMinimumSize
+                             ? doc->executor() : nullptr;
+        SkDeflateWStream deflateWStream(&compressedData,
+                                        (int)doc->metadata().fCompressionLevel,
+                                        false,
+                                        executor);
         SkStreamCopy(&deflateWStream, stream);
         deflateWStream.finalize();
         #ifdef SK_PDF_BASE85_BINARY
@@ -580,20 +585,35 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
                                       SkPDFDocument* doc,
                                       bool deflate) {
     SkPDFIndirectReference ref = doc->reserveRef();
-    if (SkExecutor* executor = doc->executor()) {
+    if (doc->executor()) {
         SkPDFDict* dictPtr = dict.release();
         SkStreamAsset* contentPtr = content.release();
         // Pass ownership of both pointers into a std::function, which should
         // only be executed once.
-        doc->incrementJobCount();
-        executor->add([dictPtr, contentPtr, deflate, doc, ref]() {
+        doc->addJob([dictPtr, contentPtr, deflate, doc, ref]() {
             serialize_stream(dictPtr, contentPtr, deflate, doc, ref);
             delete dictPtr;
             delete contentPtr;
-            doc->signalJobComplete();
         });
         return ref;
     }
     serialize_stream(dict.get(), content.get(), deflate, doc, ref);
     return ref;
 }
+
+SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
+                                      std::function<std::unique_ptr<SkStreamAsset>()> makeStream,
+                                      SkPDFDocument* doc,
+                                      bool deflate) {
+    SkPDFIndirectReference ref = doc->reserveRef();
+    if (doc->executor()) {
+        SkPDFDict* dictPtr = dict.release();
+        doc->addJob([dictPtr, makeStream = std::move(makeStream), deflate, doc, ref]() {
+            serialize_stream(dictPtr, makeStream().get(), deflate, doc, ref);
+            delete dictPtr;
+        });
+        return ref;
+    }
+    serialize_stream(dict.get(), makeStream().get(), deflate, doc, ref);
+    return ref;
+}
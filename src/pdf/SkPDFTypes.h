@@ -14,6 +14,7 @@
 #include "include/private/SkTHash.h"
 #include "include/private/SkTo.h"
 
+#include <functional>
 #include <memory>
 #include <new>
 #include <type_traits>
@@ -209,4 +210,11 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
                                       std::unique_ptr<SkStreamAsset> stream,
                                       SkPDFDocument* doc,
                                       bool deflate = kSkPDFDefaultDoDeflate);
+
+// Like the above, but makeStream() produces the stream as part of the job that deflates and
+// writes it, when the document has an executor.
+SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
+                                      std::function<std::unique_ptr<SkStreamAsset>()> makeStream,
+                                      SkPDFDocument* doc,
+                                      bool deflate = kSkPDFDefaultDoDeflate);
 #endif
@@ -21,6 +21,7 @@
 #include "src/sksl/ir/SkSLVariable.h"
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -144,26 +145,51 @@ struct ModuleLoader::Impl {
 
     void makeRootSymbolTable();
 
-    // This mutex is taken when ModuleLoader::Get is called, and released when the returned
-    // ModuleLoader object falls out of scope.
-    SkMutex fMutex;
+    // Each built-in module is compiled at most once, under its own mutex. Modules which don't
+    // depend on each other (e.g. the GPU and public modules) can therefore be loaded on separate
+    // threads at the same time, and a module that is already loaded can be fetched without taking
+    // any lock at all. Since ModifiersPool isn't thread-safe, each module owns its own pool.
+    struct ModuleSlot {
+        template <typename Fn>
+        const Module* load(Fn&& compile) {
+            if (const Module* module = fModule.load(std::memory_order_acquire)) {
+                return module;
+            }
+            SkAutoMutexExclusive lock(fMutex);
+            if (!fOwnedModule) {
+                fOwnedModule = compile(fModifiers);
+                fModule.store(fOwnedModule.get(), std::memory_order_release);
+            }
+            return fOwnedModule.get();
+        }
+
+        void unload() {
+            fModule.store(nullptr, std::memory_order_relaxed);
+            fOwnedModule = nullptr;
+            fModifiers.clear();
+        }
+
+        SkMutex                       fMutex;
+        std::atomic<const Module*>    fModule{nullptr};
+        std::unique_ptr<const Module> fOwnedModule;
+        ModifiersPool                 fModifiers;
+    };
+
     const BuiltinTypes fBuiltinTypes;
     ModifiersPool fCoreModifiers;
 
     std::unique_ptr<const Module> fRootModule;
 
-    std::unique_ptr<const Module> fSharedModule;            // [Root] + Public intrinsics
-    std::unique_ptr<const Module> fGPUModule;               // [Shared] + Non-public intrinsics/
-                                                            //     helper functions
-    std::unique_ptr<const Module> fVertexModule;            // [GPU] + Vertex stage decls
-    std::unique_ptr<const Module> fFragmentModule;          // [GPU] + Fragment stage decls
-    std::unique_ptr<const Module> fComputeModule;           // [GPU] + Compute stage decls
-    std::unique_ptr<const Module> fGraphiteVertexModule;    // [Vert] + Graphite vertex helpers
-    std::unique_ptr<const Module> fGraphiteFragmentModule;  // [Frag] + Graphite fragment helpers
-
-    std::unique_ptr<const Module> fPublicModule;            // [Shared] minus Private types +
-                                                            //     Runtime effect intrinsics
-    std::unique_ptr<const Module> fRuntimeShaderModule;     // [Public] + Runtime shader decls
+    ModuleSlot fSharedModule;            // [Root] + Public intrinsics
+    ModuleSlot fGPUModule;               // [Shared] + Non-public intrinsics/helper functions
+    ModuleSlot fVertexModule;            // [GPU] + Vertex stage decls
+    ModuleSlot fFragmentModule;          // [GPU] + Fragment stage decls
+    ModuleSlot fComputeModule;           // [GPU] + Compute stage decls
+    ModuleSlot fGraphiteVertexModule;    // [Vert] + Graphite vertex helpers
+    ModuleSlot fGraphiteFragmentModule;  // [Frag] + Graphite fragment helpers
+
+    ModuleSlot fPublicModule;            // [Shared] minus Private types + Runtime effect intrinsics
+    ModuleSlot fRuntimeShaderModule;     // [Public] + Runtime shader decls
 };
 
 ModuleLoader ModuleLoader::Get() {
@@ -171,24 +197,18 @@ ModuleLoader ModuleLoader::Get() {
     return ModuleLoader(*sModuleLoaderImpl);
 }
 
-ModuleLoader::ModuleLoader(ModuleLoader::Impl& m) : fModuleLoader(m) {
-    fModuleLoader.fMutex.acquire();
-}
-
-ModuleLoader::~ModuleLoader() {
-    fModuleLoader.fMutex.release();
-}
+ModuleLoader::ModuleLoader(ModuleLoader::Impl& m) : fModuleLoader(m) {}
 
 void ModuleLoader::unloadModules() {
-    fModuleLoader.fSharedModule           = nullptr;
-    fModuleLoader.fGPUModule              = nullptr;
-    fModuleLoader.fVertexModule           = nullptr;
-    fModuleLoader.fFragmentModule         = nullptr;
-    fModuleLoader.fComputeModule          = nullptr;
-    fModuleLoader.fGraphiteVertexModule   = nullptr;
-    fModuleLoader.fGraphiteFragmentModule = nullptr;
-    fModuleLoader.fPublicModule           = nullptr;
-    fModuleLoader.fRuntimeShaderModule    = nullptr;
+    fModuleLoader.fSharedModule.unload();
+    fModuleLoader.fGPUModule.unload();
+    fModuleLoader.fVertexModule.unload();
+    fModuleLoader.fFragmentModule.unload();
+    fModuleLoader.fComputeModule.unload();
+    fModuleLoader.fGraphiteVertexModule.unload();
+    fModuleLoader.fGraphiteFragmentModule.unload();
+    fModuleLoader.fPublicModule.unload();
+    fModuleLoader.fRuntimeShaderModule.unload();
 }
 
 ModuleLoader::Impl::Impl() {
@@ -297,103 +317,96 @@ void ModuleLoader::addPublicTypeAliases(const SkSL::Module* module) {
 }
 
 const Module* ModuleLoader::loadPublicModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fPublicModule) {
+    return fModuleLoader.fPublicModule.load([&](ModifiersPool& modifiersPool) {
         const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fPublicModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kGeneric,
-                                                         MODULE_DATA(sksl_public),
-                                                         sharedModule,
-                                                         this->coreModifiers());
-        this->addPublicTypeAliases(fModuleLoader.fPublicModule.get());
-    }
-    return fModuleLoader.fPublicModule.get();
+        std::unique_ptr<Module> publicModule = compile_and_shrink(compiler,
+                                                                  ProgramKind::kGeneric,
+                                                                  MODULE_DATA(sksl_public),
+                                                                  sharedModule,
+                                                                  modifiersPool);
+        this->addPublicTypeAliases(publicModule.get());
+        return publicModule;
+    });
 }
 
 const Module* ModuleLoader::loadPrivateRTShaderModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fRuntimeShaderModule) {
+    return fModuleLoader.fRuntimeShaderModule.load([&](ModifiersPool& modifiersPool) {
         const Module* publicModule = this->loadPublicModule(compiler);
-        fModuleLoader.fRuntimeShaderModule = compile_and_shrink(compiler,
-                                                                ProgramKind::kFragment,
-                                                                MODULE_DATA(sksl_rt_shader),
-                                                                publicModule,
-                                                                this->coreModifiers());
-    }
-    return fModuleLoader.fRuntimeShaderModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_rt_shader),
+                                  publicModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadSharedModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fSharedModule) {
+    return fModuleLoader.fSharedModule.load([&](ModifiersPool& modifiersPool) {
         const Module* rootModule = this->rootModule();
-        fModuleLoader.fSharedModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kFragment,
-                                                         MODULE_DATA(sksl_shared),
-                                                         rootModule,
-                                                         this->coreModifiers());
-    }
-    return fModuleLoader.fSharedModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_shared),
+                                  rootModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadGPUModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fGPUModule) {
+    return fModuleLoader.fGPUModule.load([&](ModifiersPool& modifiersPool) {
         const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fGPUModule = compile_and_shrink(compiler,
-                                                      ProgramKind::kFragment,
-                                                      MODULE_DATA(sksl_gpu),
-                                                      sharedModule,
-                                                      this->coreModifiers());
-    }
-    return fModuleLoader.fGPUModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_gpu),
+                                  sharedModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadFragmentModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fFragmentModule) {
+    return fModuleLoader.fFragmentModule.load([&](ModifiersPool& modifiersPool) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fFragmentModule = compile_and_shrink(compiler,
-                                                           ProgramKind::kFragment,
-                                                           MODULE_DATA(sksl_frag),
-                                                           gpuModule,
-                                                           this->coreModifiers());
-    }
-    return fModuleLoader.fFragmentModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_frag),
+                                  gpuModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadVertexModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fVertexModule) {
+    return fModuleLoader.fVertexModule.load([&](ModifiersPool& modifiersPool) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fVertexModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kVertex,
-                                                         MODULE_DATA(sksl_vert),
-                                                         gpuModule,
-                                                         this->coreModifiers());
-    }
-    return fModuleLoader.fVertexModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kVertex,
+                                  MODULE_DATA(sksl_vert),
+                                  gpuModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadComputeModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fComputeModule) {
+    return fModuleLoader.fComputeModule.load([&](ModifiersPool& modifiersPool) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fComputeModule = compile_and_shrink(compiler,
-                                                          ProgramKind::kCompute,
-                                                          MODULE_DATA(sksl_compute),
-                                                          gpuModule,
-                                                          this->coreModifiers());
-        add_compute_type_aliases(fModuleLoader.fComputeModule->fSymbols.get(),
-                                 this->builtinTypes());
-    }
-    return fModuleLoader.fComputeModule.get();
+        std::unique_ptr<Module> computeModule = compile_and_shrink(compiler,
+                                                                   ProgramKind::kCompute,
+                                                                   MODULE_DATA(sksl_compute),
+                                                                   gpuModule,
+                                                                   modifiersPool);
+        add_compute_type_aliases(computeModule->fSymbols.get(), this->builtinTypes());
+        return computeModule;
+    });
 }
 
 const Module* ModuleLoader::loadGraphiteFragmentModule(SkSL::Compiler* compiler) {
 #if defined(SK_GRAPHITE_ENABLED)
-    if (!fModuleLoader.fGraphiteFragmentModule) {
+    return fModuleLoader.fGraphiteFragmentModule.load([&](ModifiersPool& modifiersPool) {
         const Module* fragmentModule = this->loadFragmentModule(compiler);
-        fModuleLoader.fGraphiteFragmentModule = compile_and_shrink(compiler,
-                                                                   ProgramKind::kGraphiteFragment,
-                                                                   MODULE_DATA(sksl_graphite_frag),
-                                                                   fragmentModule,
-                                                                   this->coreModifiers());
-    }
-    return fModuleLoader.fGraphiteFragmentModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kGraphiteFragment,
+                                  MODULE_DATA(sksl_graphite_frag),
+                                  fragmentModule,
+                                  modifiersPool);
+    });
 #else
     return this->loadFragmentModule(compiler);
 #endif
@@ -401,15 +414,14 @@ const Module* ModuleLoader::loadGraphiteFragmentModule(SkSL::Compiler* compiler)
 
 const Module* ModuleLoader::loadGraphiteVertexModule(SkSL::Compiler* compiler) {
 #if defined(SK_GRAPHITE_ENABLED)
-    if (!fModuleLoader.fGraphiteVertexModule) {
+    return fModuleLoader.fGraphiteVertexModule.load([&](ModifiersPool& modifiersPool) {
         const Module* vertexModule = this->loadVertexModule(compiler);
-        fModuleLoader.fGraphiteVertexModule = compile_and_shrink(compiler,
-                                                                 ProgramKind::kGraphiteVertex,
-                                                                 MODULE_DATA(sksl_graphite_vert),
-                                                                 vertexModule,
-                                                                 this->coreModifiers());
-    }
-    return fModuleLoader.fGraphiteVertexModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kGraphiteVertex,
+                                  MODULE_DATA(sksl_graphite_vert),
+                                  vertexModule,
+                                  modifiersPool);
+    });
 #else
     return this->loadVertexModule(compiler);
 #endif
@@ -27,10 +27,9 @@ private:
 
 public:
     ModuleLoader(ModuleLoader::Impl&);
-    ~ModuleLoader();
 
-    // Acquires a mutex-locked reference to the singleton ModuleLoader. When the ModuleLoader is
-    // allowed to fall out of scope, the mutex will be released.
+    // Returns a reference to the singleton ModuleLoader. The load functions below are thread-safe;
+    // modules which don't depend on each other can be loaded on separate threads concurrently.
     static ModuleLoader Get();
 
     // The built-in types and root module are universal, immutable, and shared by every Compiler.
@@ -38,11 +37,12 @@ public:
     const BuiltinTypes& builtinTypes();
     const Module* rootModule();
 
-    // This ModifiersPool is shared by every built-in module.
+    // This ModifiersPool holds the root module's modifiers. It is not thread-safe; it is meant for
+    // tools like sksl-minify which compile modules themselves.
     ModifiersPool& coreModifiers();
 
     // These modules are loaded on demand; once loaded, they are kept for the lifetime of the
-    // process.
+    // process. Each module has its own lock, so fetching a loaded module never blocks.
     const Module* loadSharedModule(SkSL::Compiler* compiler);
     const Module* loadGPUModule(SkSL::Compiler* compiler);
     const Module* loadVertexModule(SkSL::Compiler* compiler);
@@ -58,7 +58,8 @@ public:
     // `vec4` are added; SkSL private types like `sampler2D` are replaced with an invalid type.
     void addPublicTypeAliases(const SkSL::Module* module);
 
-    // This unloads every module. It's useful primarily for benchmarking purposes.
+    // This unloads every module. It's useful primarily for benchmarking purposes, and must not be
+    // called while any other thread might be using a module.
     void unloadModules();
 };
 
@@ -10,8 +10,10 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkSpan.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkFloatingPoint.h"
 #include "include/private/SkSLDefines.h"
@@ -25,6 +27,7 @@
 #include "include/private/SkTArray.h"
 #include "include/private/SkTHash.h"
 #include "include/private/SkTPin.h"
+#include "include/private/SkTo.h"
 #include "include/sksl/SkSLOperator.h"
 #include "include/sksl/SkSLPosition.h"
 #include "src/sksl/SkSLBuiltinTypes.h"
@@ -2169,6 +2172,408 @@ skvm::Color ProgramToSkVM(const Program& program,
                        {builder, result[3]}};
 }
 
+// SkVMTemplate placeholders are uniforms loaded from one of these (stride-0) arguments.
+enum TemplateArg {
+    kUniforms_TemplateArg,  // one 32-bit slot per uniform slot
+    kInputs_TemplateArg,    // device, local, inputColor, destColor
+    kResults_TemplateArg,   // one color per callback
+};
+static constexpr int kTemplateInputSlots = 12;
+static constexpr int kTemplateSlotBytes = 4;
+static constexpr uint32_t kTemplateMagic = SkSetFourByteTag('s', 'k', 'v', 't');
+
+std::unique_ptr<SkVMTemplate> SkVMTemplate::Make(const Program& program,
+                                                 const FunctionDefinition& function,
+                                                 size_t uniformSlots,
+                                                 skvm::Features features) {
+    std::unique_ptr<SkVMTemplate> t(new SkVMTemplate(features, uniformSlots));
+
+    skvm::Builder b(features);
+    skvm::UPtr uniformsArg = b.uniform(),
+               inputsArg   = b.uniform(),
+               resultsArg  = b.uniform();
+    SkASSERT(uniformsArg.ix == kUniforms_TemplateArg &&
+             inputsArg.ix   == kInputs_TemplateArg   &&
+             resultsArg.ix  == kResults_TemplateArg);
+
+    std::vector<skvm::Val> uniforms;
+    uniforms.reserve(uniformSlots);
+    for (size_t i = 0; i < uniformSlots; ++i) {
+        uniforms.push_back(b.uniform32(uniformsArg, SkToInt(i) * kTemplateSlotBytes).id);
+    }
+
+    int inputSlot = 0;
+    auto input = [&]() { return b.uniformF(inputsArg, inputSlot++ * kTemplateSlotBytes); };
+    skvm::Coord device = {input(), input()};
+    skvm::Coord local  = {input(), input()};
+    skvm::Color inputColor = {input(), input(), input(), input()};
+    skvm::Color destColor  = {input(), input(), input(), input()};
+    SkASSERT(inputSlot == kTemplateInputSlots);
+
+    class Recorder : public SkVMCallbacks {
+    public:
+        Recorder(skvm::Builder* builder, skvm::UPtr results, std::vector<Call>* calls)
+                : fBuilder(builder), fResults(results), fCalls(calls) {}
+
+        skvm::Color sampleShader(int ix, skvm::Coord coord) override {
+            return this->record(Call::Kind::kShader, ix, {coord.x.id, coord.y.id});
+        }
+        skvm::Color sampleColorFilter(int ix, skvm::Color c) override {
+            return this->record(Call::Kind::kColorFilter, ix, {c.r.id, c.g.id, c.b.id, c.a.id});
+        }
+        skvm::Color sampleBlender(int ix, skvm::Color src, skvm::Color dst) override {
+            return this->record(Call::Kind::kBlender, ix, {src.r.id, src.g.id, src.b.id, src.a.id,
+                                                           dst.r.id, dst.g.id, dst.b.id, dst.a.id});
+        }
+        skvm::Color toLinearSrgb(skvm::Color c) override {
+            return this->record(Call::Kind::kToLinearSrgb, -1, {c.r.id, c.g.id, c.b.id, c.a.id});
+        }
+        skvm::Color fromLinearSrgb(skvm::Color c) override {
+            return this->record(Call::Kind::kFromLinearSrgb, -1, {c.r.id, c.g.id, c.b.id, c.a.id});
+        }
+
+    private:
+        skvm::Color record(Call::Kind kind, int child, std::vector<skvm::Val> args) {
+            int slot = 4 * SkToInt(fCalls->size());
+            fCalls->push_back({kind, child, std::move(args)});
+            auto result = [&]() { return fBuilder->uniformF(fResults, slot++ * kTemplateSlotBytes); };
+            return {result(), result(), result(), result()};
+        }
+
+        skvm::Builder*     fBuilder;
+        skvm::UPtr         fResults;
+        std::vector<Call>* fCalls;
+    };
+    Recorder recorder(&b, resultsArg, &t->fCalls);
+
+    skvm::Color result = ProgramToSkVM(program, function, &b, /*debugTrace=*/nullptr,
+                                       SkSpan(uniforms), device, local, inputColor, destColor,
+                                       &recorder);
+    if (!result) {
+        return nullptr;
+    }
+    t->fInstructions = b.program();
+    t->fResult[0] = result.r.id;
+    t->fResult[1] = result.g.id;
+    t->fResult[2] = result.b.id;
+    t->fResult[3] = result.a.id;
+    return t;
+}
+
+skvm::Color SkVMTemplate::replay(skvm::Builder* builder,
+                                 SkSpan<skvm::Val> uniforms,
+                                 skvm::Coord device,
+                                 skvm::Coord local,
+                                 skvm::Color inputColor,
+                                 skvm::Color destColor,
+                                 SkVMCallbacks* callbacks) const {
+    SkASSERT(uniforms.size() == fUniformSlots);
+    SkASSERT(builder->features().fma  == fFeatures.fma &&
+             builder->features().fp16 == fFeatures.fp16);
+
+    const skvm::Val inputs[kTemplateInputSlots] = {
+        device.x.id, device.y.id,
+        local.x.id,  local.y.id,
+        inputColor.r.id, inputColor.g.id, inputColor.b.id, inputColor.a.id,
+        destColor.r.id,  destColor.g.id,  destColor.b.id,  destColor.a.id,
+    };
+    std::vector<skvm::Val> results(4 * fCalls.size());
+    std::vector<skvm::Val> ids(fInstructions.size());
+    size_t nextCall = 0;
+
+    auto call = [&](const Call& c) -> skvm::Color {
+        auto arg = [&](int i) { return skvm::F32{builder, ids[c.fArgs[i]]}; };
+        switch (c.fKind) {
+            case Call::Kind::kShader:
+                return callbacks->sampleShader(c.fChild, {arg(0), arg(1)});
+            case Call::Kind::kColorFilter:
+                return callbacks->sampleColorFilter(c.fChild, {arg(0), arg(1), arg(2), arg(3)});
+            case Call::Kind::kBlender:
+                return callbacks->sampleBlender(c.fChild, {arg(0), arg(1), arg(2), arg(3)},
+                                                          {arg(4), arg(5), arg(6), arg(7)});
+            case Call::Kind::kToLinearSrgb:
+                return callbacks->toLinearSrgb({arg(0), arg(1), arg(2), arg(3)});
+            case Call::Kind::kFromLinearSrgb:
+                return callbacks->fromLinearSrgb({arg(0), arg(1), arg(2), arg(3)});
+        }
+        SkUNREACHABLE;
+    };
+
+    for (size_t i = 0; i < fInstructions.size(); ++i) {
+        skvm::Instruction inst = fInstructions[i];
+        if (inst.op == skvm::Op::uniform32) {
+            int slot = inst.immB / kTemplateSlotBytes;
+            if (inst.immA == kUniforms_TemplateArg) {
+                ids[i] = uniforms[slot];
+                continue;
+            }
+            if (inst.immA == kInputs_TemplateArg) {
+                ids[i] = inputs[slot];
+                continue;
+            }
+            if (inst.immA == kResults_TemplateArg) {
+                // Calls were recorded in order, each immediately followed by its results.
+                if (slot / 4 == SkToInt(nextCall)) {
+                    skvm::Color color = call(fCalls[nextCall]);
+                    if (!color) {
+                        return {};
+                    }
+                    results[4 * nextCall + 0] = color.r.id;
+                    results[4 * nextCall + 1] = color.g.id;
+                    results[4 * nextCall + 2] = color.b.id;
+                    results[4 * nextCall + 3] = color.a.id;
+                    ++nextCall;
+                }
+                ids[i] = results[slot];
+                continue;
+            }
+        }
+        for (skvm::Val* operand : {&inst.x, &inst.y, &inst.z, &inst.w}) {
+            if (*operand != skvm::NA) {
+                *operand = ids[*operand];
+            }
+        }
+        ids[i] = builder->push(inst);
+    }
+
+    return skvm::Color{{builder, ids[fResult[0]]},
+                       {builder, ids[fResult[1]]},
+                       {builder, ids[fResult[2]]},
+                       {builder, ids[fResult[3]]}};
+}
+
+sk_sp<SkData> SkVMTemplate::serialize() const {
+    SkDynamicMemoryWStream stream;
+    stream.write32(kTemplateMagic);
+    stream.write32(kVersion);
+    stream.writeBool(fFeatures.fma);
+    stream.writeBool(fFeatures.fp16);
+    stream.write32(SkToU32(fUniformSlots));
+
+    stream.write32(SkToU32(fInstructions.size()));
+    for (const skvm::Instruction& inst : fInstructions) {
+        stream.write32((int)inst.op);
+        stream.write32(inst.x);
+        stream.write32(inst.y);
+        stream.write32(inst.z);
+        stream.write32(inst.w);
+        stream.write32(inst.immA);
+        stream.write32(inst.immB);
+        stream.write32(inst.immC);
+    }
+
+    stream.write32(SkToU32(fCalls.size()));
+    for (const Call& call : fCalls) {
+        stream.write32((int)call.fKind);
+        stream.write32(call.fChild);
+        for (skvm::Val arg : call.fArgs) {
+            stream.write32(arg);
+        }
+    }
+
+    for (skvm::Val id : fResult) {
+        stream.write32(id);
+    }
+    return stream.detachAsData();
+}
+
+std::unique_ptr<SkVMTemplate> SkVMTemplate::Deserialize(const SkData& data,
+                                                        size_t uniformSlots,
+                                                        int childCount,
+                                                        skvm::Features features) {
+    SkMemoryStream stream(data.data(), data.size());
+    uint32_t magic, version, slots, count;
+    bool fma, fp16;
+    if (!stream.readU32(&magic)   || magic   != kTemplateMagic ||
+        !stream.readU32(&version) || version != kVersion       ||
+        !stream.readBool(&fma)    || fma  != features.fma      ||
+        !stream.readBool(&fp16)   || fp16 != features.fp16     ||
+        !stream.readU32(&slots)   || slots != uniformSlots) {
+        return nullptr;
+    }
+    std::unique_ptr<SkVMTemplate> t(new SkVMTemplate(features, uniformSlots));
+
+    // Each instruction takes 32 bytes, so a count larger than that can't be genuine.
+    if (!stream.readU32(&count) || count > data.size() / 32) {
+        return nullptr;
+    }
+    t->fInstructions.resize(count);
+    for (skvm::Instruction& inst : t->fInstructions) {
+        int32_t op;
+        if (!stream.readS32(&op) || op < 0 || op > (int)skvm::Op::duplicate ||
+            !stream.readS32(&inst.x)    || !stream.readS32(&inst.y) ||
+            !stream.readS32(&inst.z)    || !stream.readS32(&inst.w) ||
+            !stream.readS32(&inst.immA) || !stream.readS32(&inst.immB) ||
+            !stream.readS32(&inst.immC)) {
+            return nullptr;
+        }
+        inst.op = (skvm::Op)op;
+    }
+
+    // Calls take at least 16 bytes each.
+    if (!stream.readU32(&count) || count > data.size() / 16) {
+        return nullptr;
+    }
+    t->fCalls.resize(count);
+    for (Call& call : t->fCalls) {
+        int32_t kind;
+        if (!stream.readS32(&kind) || kind < 0 || kind > (int)Call::Kind::kLast ||
+            !stream.readS32(&call.fChild)) {
+            return nullptr;
+        }
+        call.fKind = (Call::Kind)kind;
+        call.fArgs.resize(call.fKind == Call::Kind::kShader  ? 2 :
+                          call.fKind == Call::Kind::kBlender ? 8 : 4);
+        for (skvm::Val& arg : call.fArgs) {
+            if (!stream.readS32(&arg)) {
+                return nullptr;
+            }
+        }
+    }
+
+    for (skvm::Val& id : t->fResult) {
+        if (!stream.readS32(&id)) {
+            return nullptr;
+        }
+    }
+    if (!stream.isAtEnd() || !t->validate(childCount)) {
+        return nullptr;
+    }
+    return t;
+}
+
+bool SkVMTemplate::validate(int childCount) const {
+    const int count = SkToInt(fInstructions.size());
+    auto valid_id = [](skvm::Val id, int limit) { return 0 <= id && id < limit; };
+
+    for (const Call& call : fCalls) {
+        bool usesChild = call.fKind == Call::Kind::kShader      ||
+                         call.fKind == Call::Kind::kColorFilter ||
+                         call.fKind == Call::Kind::kBlender;
+        if (usesChild && !(0 <= call.fChild && call.fChild < childCount)) {
+            return false;
+        }
+    }
+
+    size_t nextCall = 0;
+    for (int i = 0; i < count; ++i) {
+        const skvm::Instruction& inst = fInstructions[i];
+        if (inst.op == skvm::Op::uniform32) {
+            if (inst.x != skvm::NA || inst.y != skvm::NA || inst.z != skvm::NA ||
+                inst.w != skvm::NA || inst.immC != 0 ||
+                inst.immB < 0 || inst.immB % kTemplateSlotBytes) {
+                return false;
+            }
+            size_t slot = inst.immB / kTemplateSlotBytes;
+            switch (inst.immA) {
+                case kUniforms_TemplateArg:
+                    if (slot >= fUniformSlots) {
+                        return false;
+                    }
+                    break;
+                case kInputs_TemplateArg:
+                    if (slot >= kTemplateInputSlots) {
+                        return false;
+                    }
+                    break;
+                case kResults_TemplateArg:
+                    if (slot / 4 == nextCall && nextCall < fCalls.size()) {
+                        // replay() makes the call here, so its arguments must be ready.
+                        for (skvm::Val arg : fCalls[nextCall].fArgs) {
+                            if (!valid_id(arg, i)) {
+                                return false;
+                            }
+                        }
+                        ++nextCall;
+                    } else if (slot / 4 >= nextCall) {
+                        return false;
+                    }
+                    break;
+                default:
+                    return false;
+            }
+            continue;
+        }
+
+        // Code generation only produces pure arithmetic; it never touches memory on its own.
+        // Replay hands each instruction straight to the builder, and neither the interpreter nor
+        // the JIT checks operands, so each op must read exactly the arguments it expects.
+        int arity;
+        bool usesImmA = false;
+        switch (inst.op) {
+            case skvm::Op::splat:
+                arity = 0;
+                usesImmA = true;
+                break;
+
+            case skvm::Op::shl_i32:
+            case skvm::Op::shr_i32:
+            case skvm::Op::sra_i32:
+                arity = 1;
+                usesImmA = true;
+                break;
+
+            case skvm::Op::sqrt_f32:
+            case skvm::Op::ceil:
+            case skvm::Op::floor:
+            case skvm::Op::trunc:
+            case skvm::Op::round:
+            case skvm::Op::to_fp16:
+            case skvm::Op::from_fp16:
+            case skvm::Op::to_f32:
+                arity = 1;
+                break;
+
+            case skvm::Op::add_f32: case skvm::Op::add_i32:
+            case skvm::Op::sub_f32: case skvm::Op::sub_i32:
+            case skvm::Op::mul_f32: case skvm::Op::mul_i32:
+            case skvm::Op::div_f32:
+            case skvm::Op::min_f32: case skvm::Op::max_f32:
+            case skvm::Op::neq_f32: case skvm::Op::eq_f32: case skvm::Op::eq_i32:
+            case skvm::Op::gte_f32: case skvm::Op::gt_f32: case skvm::Op::gt_i32:
+            case skvm::Op::bit_and: case skvm::Op::bit_or:
+            case skvm::Op::bit_xor: case skvm::Op::bit_clear:
+                arity = 2;
+                break;
+
+            case skvm::Op::fma_f32:
+            case skvm::Op::fms_f32:
+            case skvm::Op::fnma_f32:
+                // The builder only fuses when it has fma, and the JIT assumes it's there.
+                if (!fFeatures.fma) {
+                    return false;
+                }
+                arity = 3;
+                break;
+
+            case skvm::Op::select:
+                arity = 3;
+                break;
+
+            default:
+                return false;
+        }
+        const skvm::Val operands[] = {inst.x, inst.y, inst.z, inst.w};
+        for (int j = 0; j < 4; ++j) {
+            if (j < arity ? !valid_id(operands[j], i) : operands[j] != skvm::NA) {
+                return false;
+            }
+        }
+        if ((!usesImmA && inst.immA != 0) || inst.immB != 0 || inst.immC != 0) {
+            return false;
+        }
+    }
+    if (nextCall != fCalls.size()) {
+        return false;
+    }
+    for (skvm::Val id : fResult) {
+        if (!valid_id(id, count)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ProgramToSkVM(const Program& program,
                    const FunctionDefinition& function,
                    skvm::Builder* b,
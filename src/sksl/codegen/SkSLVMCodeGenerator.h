@@ -8,6 +8,7 @@
 #ifndef SKSL_VMGENERATOR
 #define SKSL_VMGENERATOR
 
+#include "include/core/SkRefCnt.h"
 #include "src/core/SkVM.h"
 #include "src/sksl/ir/SkSLType.h"
 
@@ -16,6 +17,7 @@
 #include <string>
 #include <vector>
 
+class SkData;
 template <typename T> class SkSpan;
 
 namespace SkSL {
@@ -48,6 +50,72 @@ skvm::Color ProgramToSkVM(const Program& program,
                           skvm::Color destColor,
                           SkVMCallbacks* callbacks);
 
+/*
+ * The output of ProgramToSkVM() for 'function', recorded once with placeholders standing in for its
+ * uniforms, coords, colors, and the results of its callbacks. Replaying it into a builder emits the
+ * same instructions that ProgramToSkVM() would, without converting the program again. It can also
+ * be serialized, so that it can outlive the process that recorded it.
+ */
+class SkVMTemplate {
+public:
+    // Bump this whenever a change to code generation could make previously recorded templates
+    // differ from what ProgramToSkVM() would emit now.
+    static constexpr uint32_t kVersion = 1;
+
+    static std::unique_ptr<SkVMTemplate> Make(const Program& program,
+                                              const FunctionDefinition& function,
+                                              size_t uniformSlots,
+                                              skvm::Features features);
+
+    // Returns nullptr if 'data' isn't a valid template for a program with this many uniform slots
+    // and children, recorded with these features.
+    static std::unique_ptr<SkVMTemplate> Deserialize(const SkData& data,
+                                                     size_t uniformSlots,
+                                                     int childCount,
+                                                     skvm::Features features);
+
+    sk_sp<SkData> serialize() const;
+
+    // The features 'builder' must have for replay() to match ProgramToSkVM().
+    skvm::Features features() const { return fFeatures; }
+
+    // Equivalent to ProgramToSkVM() with no debug trace.
+    skvm::Color replay(skvm::Builder* builder,
+                       SkSpan<skvm::Val> uniforms,
+                       skvm::Coord device,
+                       skvm::Coord local,
+                       skvm::Color inputColor,
+                       skvm::Color destColor,
+                       SkVMCallbacks* callbacks) const;
+
+private:
+    struct Call {
+        enum class Kind {
+            kShader,          // args: coord
+            kColorFilter,     // args: color
+            kBlender,         // args: src, dst
+            kToLinearSrgb,    // args: color
+            kFromLinearSrgb,  // args: color
+            kLast = kFromLinearSrgb,
+        };
+
+        Kind fKind;
+        int  fChild;
+        std::vector<skvm::Val> fArgs;
+    };
+
+    SkVMTemplate(skvm::Features features, size_t uniformSlots)
+            : fFeatures(features), fUniformSlots(uniformSlots) {}
+
+    bool validate(int childCount) const;
+
+    skvm::Features                 fFeatures;
+    size_t                         fUniformSlots;
+    std::vector<skvm::Instruction> fInstructions;
+    std::vector<Call>              fCalls;
+    skvm::Val                      fResult[4];
+};
+
 struct SkVMSignature {
     size_t fParameterSlots = 0;
     size_t fReturnSlots    = 0;
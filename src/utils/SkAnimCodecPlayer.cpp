@@ -13,6 +13,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -21,7 +22,9 @@
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
+#include "include/private/SkTo.h"
 #include "src/codec/SkCodecImageGenerator.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
 #include <cstddef>
@@ -30,9 +33,38 @@
 #include <vector>
 
 SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
+    this->init();
+}
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(sk_sp<SkData> data, const DecodeOptions& options)
+        : fCodec(SkCodec::MakeFromData(data))
+        , fOptions(options) {
+    this->init();
+
+    const int frameCount = SkToInt(fFrameInfos.size());
+    fOptions.fLookahead = std::min(fOptions.fLookahead, frameCount - 1);
+    if (fOptions.fMaxCachedFrames > 0) {
+        // Leave room for the current frame, so decoding ahead never drops it.
+        fOptions.fLookahead = std::min(fOptions.fLookahead, fOptions.fMaxCachedFrames - 1);
+    }
+    if (fOptions.fExecutor && fOptions.fLookahead > 0) {
+        fData = std::move(data);
+        fTaskGroup = std::make_unique<SkTaskGroup>(*fOptions.fExecutor);
+    }
+}
+
+void SkAnimCodecPlayer::init() {
+    SkAutoMutexExclusive lock(fMutex);
+    if (!fCodec) {
+        fTotalDuration = 0;
+        fImages.push_back(nullptr);
+        return;
+    }
+
     fImageInfo = fCodec->getInfo();
     fFrameInfos = fCodec->getFrameInfo();
     fImages.resize(fFrameInfos.size());
+    fInFlight.resize(fFrameInfos.size());
 
     // change the interpretation of fDuration to a end-time for that frame
     size_t dur = 0;
@@ -51,10 +83,15 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
     }
 }
 
-SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
+SkAnimCodecPlayer::~SkAnimCodecPlayer() {
+    if (fTaskGroup) {
+        fTaskGroup->wait();
+    }
+}
 
 SkISize SkAnimCodecPlayer::dimensions() const {
     if (!fCodec) {
+        SkAutoMutexExclusive lock(fMutex);
         auto image = fImages.front();
         return image ? image->dimensions() : SkISize::MakeEmpty();
     }
@@ -64,13 +101,8 @@ SkISize SkAnimCodecPlayer::dimensions() const {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
-sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
-    SkASSERT((unsigned)index < fFrameInfos.size());
-
-    if (fImages[index]) {
-        return fImages[index];
-    }
-
+sk_sp<SkImage> SkAnimCodecPlayer::decodeFrame(SkCodec* codec, int index,
+                                              sk_sp<SkImage> requiredImage) const {
     size_t rb = fImageInfo.minRowBytes();
     size_t size = fImageInfo.computeByteSize(rb);
     auto data = SkData::MakeUninitialized(size);
@@ -78,7 +110,7 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     SkCodec::Options opts;
     opts.fFrameIndex = index;
 
-    const auto origin = fCodec->getOrigin();
+    const auto origin = codec->getOrigin();
     const auto orientedDims = this->dimensions();
     const auto originMatrix = SkEncodedOriginToMatrix(origin, orientedDims.width(),
                                                               orientedDims.height());
@@ -90,9 +122,7 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     if (fFrameInfos[index].fAlphaType != kOpaque_SkAlphaType && imageInfo.isOpaque()) {
         imageInfo = imageInfo.makeAlphaType(kPremul_SkAlphaType);
     }
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame && fImages[requiredFrame]) {
-        auto requiredImage = fImages[requiredFrame];
+    if (requiredImage) {
         auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
         if (origin != kDefault_SkEncodedOrigin) {
             // The required frame is stored after applying the origin. Undo that,
@@ -107,10 +137,10 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
             canvas->concat(inverse);
         }
         canvas->drawImage(requiredImage, 0, 0, SkSamplingOptions(), &paint);
-        opts.fPriorFrame = requiredFrame;
+        opts.fPriorFrame = fFrameInfos[index].fRequiredFrame;
     }
 
-    if (SkCodec::kSuccess != fCodec->getPixels(imageInfo, data->writable_data(), rb, &opts)) {
+    if (SkCodec::kSuccess != codec->getPixels(imageInfo, data->writable_data(), rb, &opts)) {
         return nullptr;
     }
 
@@ -125,15 +155,155 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
         canvas->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
         image = SkImage::MakeRasterData(imageInfo, std::move(data), rb);
     }
-    return fImages[index] = image;
+    return image;
+}
+
+void SkAnimCodecPlayer::cacheFrame(int index, sk_sp<SkImage> image) {
+    fInFlight[index] = false;
+    if (!image) {
+        return;
+    }
+
+    if (!fImages[index]) {
+        fCachedCount += 1;
+    }
+    fImages[index] = std::move(image);
+
+    // Over budget, drop the frames that will be shown furthest in the future (but never the
+    // one just decoded). Playback loops, so those are the frames just behind the current one.
+    const int frameCount = SkToInt(fImages.size());
+    while (fOptions.fMaxCachedFrames > 0 && fCachedCount > fOptions.fMaxCachedFrames) {
+        int furthest = -1;
+        int furthestDistance = -1;
+        for (int i = 0; i < frameCount; ++i) {
+            const int distance = (i - fCurrIndex + frameCount) % frameCount;
+            if (fImages[i] && i != index && distance > furthestDistance) {
+                furthest = i;
+                furthestDistance = distance;
+            }
+        }
+        if (furthest < 0) {
+            break;
+        }
+        fImages[furthest] = nullptr;
+        fCachedCount -= 1;
+    }
+}
+
+sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
+    SkASSERT((unsigned)index < fFrameInfos.size());
+
+    bool inFlight;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (fImages[index]) {
+            return fImages[index];
+        }
+        inFlight = fInFlight[index];
+    }
+    if (inFlight) {
+        // Being decoded ahead of time; wait for it (helping out if we can) instead of
+        // decoding it twice.
+        fTaskGroup->wait();
+    }
+
+    sk_sp<SkImage> requiredImage;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (fImages[index]) {
+            return fImages[index];
+        }
+        const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+        if (requiredFrame != SkCodec::kNoFrame) {
+            requiredImage = fImages[requiredFrame];
+        }
+        // Keep decodeAhead()'s tasks from picking this frame up while we decode it.
+        fInFlight[index] = true;
+    }
+
+    auto image = this->decodeFrame(fCodec.get(), index, std::move(requiredImage));
+
+    SkAutoMutexExclusive lock(fMutex);
+    this->cacheFrame(index, image);
+    return image;
+}
+
+void SkAnimCodecPlayer::decodeAhead() {
+    SkASSERT(fTaskGroup);
+    const int frameCount = SkToInt(fFrameInfos.size());
+
+    struct Job {
+        int            fIndex;
+        int            fAhead;
+        sk_sp<SkImage> fRequiredImage;
+    };
+    std::vector<Job> jobs;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        for (int ahead = 1; ahead <= fOptions.fLookahead; ++ahead) {
+            const int index = (fCurrIndex + ahead) % frameCount;
+            if (fImages[index] || fInFlight[index]) {
+                continue;
+            }
+            // Frames that need an earlier frame wait until it is decoded.
+            const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+            if (requiredFrame != SkCodec::kNoFrame && !fImages[requiredFrame]) {
+                continue;
+            }
+            fInFlight[index] = true;
+            jobs.push_back({index, ahead, requiredFrame != SkCodec::kNoFrame
+                                                  ? fImages[requiredFrame] : nullptr});
+        }
+    }
+
+    // Tasks may run right away on this thread, so add them without holding fMutex.
+    for (Job& job : jobs) {
+        fTaskGroup->add([this, frameCount, job = std::move(job)]() mutable {
+            // SkCodec is not thread safe, so each task decodes with its own.
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            int index = job.fIndex;
+            int remaining = fOptions.fLookahead - job.fAhead;
+            sk_sp<SkImage> requiredImage = std::move(job.fRequiredImage);
+            while (true) {
+                sk_sp<SkImage> image = codec ? this->decodeFrame(codec.get(), index,
+                                                                 std::move(requiredImage))
+                                             : nullptr;
+
+                SkAutoMutexExclusive lock(fMutex);
+                this->cacheFrame(index, image);
+
+                // Carry on down a chain of frames that each need the one before, as long as
+                // they are within the lookahead.
+                const int next = (index + 1) % frameCount;
+                if (!image || remaining-- <= 0 || fImages[next] || fInFlight[next] ||
+                    fFrameInfos[next].fRequiredFrame != index) {
+                    return;
+                }
+                fInFlight[next] = true;
+                index = next;
+                requiredImage = std::move(image);
+            }
+        });
+    }
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
-    SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
+    if (!fTotalDuration) {
+        SkAutoMutexExclusive lock(fMutex);
+        SkASSERT(fImages.size() == 1);
+        return fImages.front();
+    }
 
-    return fTotalDuration > 0
-        ? this->getFrameAt(fCurrIndex)
-        : fImages.front();
+    int index;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        index = fCurrIndex;
+    }
+    auto image = this->getFrameAt(index);
+    if (fTaskGroup) {
+        this->decodeAhead();
+    }
+    return image;
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
@@ -147,6 +317,7 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
                                   [](const SkCodec::FrameInfo& info, uint32_t msec) {
                                       return (uint32_t)info.fDuration <= msec;
                                   });
+    SkAutoMutexExclusive lock(fMutex);
     int prevIndex = fCurrIndex;
     fCurrIndex = lower - fFrameInfos.begin();
     return fCurrIndex != prevIndex;
@@ -13,6 +13,7 @@
 #include "include/core/SkString.h"
 #include "include/private/SkMalloc.h"
 #include "include/private/SkTo.h"
+#include "include/private/SkVx.h"
 #include "include/utils/SkParse.h"
 #include "src/utils/SkUTF.h"
 
@@ -82,14 +83,12 @@ NumberValue::NumberValue(float f) {
 
 // Vector recs point to externally allocated slabs with the following layout:
 //
-//   [size_t n] [REC_0] ... [REC_n-1] [optional extra trailing storage]
+//   [size_t n] [REC_0] ... [REC_n-1]
 //
-// Long strings use extra_alloc_size == 1 to store the \0 terminator.
-//
-template <typename T, size_t extra_alloc_size = 0>
+template <typename T>
 static void* MakeVector(const void* src, size_t size, SkArenaAlloc& alloc) {
     // The Ts are already in memory, so their size should be safe.
-    const auto total_size = sizeof(size_t) + size * sizeof(T) + extra_alloc_size;
+    const auto total_size = sizeof(size_t) + size * sizeof(T);
     auto* size_ptr = reinterpret_cast<size_t*>(alloc.makeBytesAlignedTo(total_size, kRecAlign));
 
     *size_ptr = size;
@@ -113,9 +112,13 @@ ArrayValue::ArrayValue(const Value* src, size_t size, SkArenaAlloc& alloc) {
 //    Storing [max_len - actual_len] allows the 'len' field to double-up as a
 //    null terminator when size == max_len (this works 'cause kShortString == 0).
 //
-// -- long strings (len > 7) -> these are externally allocated vectors (VectorRec<char>).
+// -- long strings (len > 7) -> these point to an externally allocated LongString record:
+//
+//        [size_t n] [const char* chars] [optional chars] [optional \0]
 //
-// The string data plus a null-char terminator are copied over.
+//    The string data plus a null-char terminator are copied after the record, unless the
+//    string is parsed in place: then the chars stay in the input, and the closing quote is
+//    overwritten with the terminator.
 //
 namespace {
 
@@ -123,11 +126,12 @@ namespace {
 // (for the common case where the string is not at the end of the stream).
 class FastString final : public Value {
 public:
-    FastString(const char* src, size_t size, const char* eos, SkArenaAlloc& alloc) {
+    FastString(const char* src, size_t size, const char* eos, SkArenaAlloc& alloc,
+               bool in_place = false) {
         SkASSERT(src <= eos);
 
         if (size > kMaxInlineStringSize) {
-            this->initLongString(src, size, alloc);
+            this->initLongString(src, size, alloc, in_place);
             SkASSERT(this->getTag() == Tag::kString);
             return;
         }
@@ -146,13 +150,27 @@ private:
     // first byte reserved for tagging, \0 terminator => 6 usable chars
     inline static constexpr size_t kMaxInlineStringSize = sizeof(Value) - 2;
 
-    void initLongString(const char* src, size_t size, SkArenaAlloc& alloc) {
+    void initLongString(const char* src, size_t size, SkArenaAlloc& alloc, bool in_place) {
         SkASSERT(size > kMaxInlineStringSize);
 
-        this->init_tagged_pointer(Tag::kString, MakeVector<char, 1>(src, size, alloc));
+        const auto chars_size = in_place ? 0 : size + 1;
+        auto* rec = reinterpret_cast<LongString*>(
+                alloc.makeBytesAlignedTo(sizeof(LongString) + chars_size, kRecAlign));
+        rec->fSize = size;
+
+        if (in_place) {
+            // The input is writable (see DOM(sk_sp<SkData>)): terminate over the closing quote.
+            SkASSERT(src[size] == '"');
+            const_cast<char*>(src)[size] = '\0';
+            rec->fChars = src;
+        } else {
+            auto* chars = reinterpret_cast<char*>(rec + 1);
+            memcpy(chars, src, size);
+            chars[size] = '\0';
+            rec->fChars = chars;
+        }
 
-        auto* data = this->cast<VectorValue<char, Value::Type::kString>>()->begin();
-        const_cast<char*>(data)[size] = '\0';
+        this->init_tagged_pointer(Tag::kString, rec);
     }
 
     void initShortString(const char* src, size_t size) {
@@ -276,6 +294,29 @@ static inline const char* skip_ws(const char* p) {
     return p;
 }
 
+// Skips plain string chars up to the next is_eostring() char.
+static inline const char* skip_string_chars(const char* p, const char* p_stop) {
+    // Most strings (object keys in particular) are short: check the first few chars one by one.
+    for (int i = 0; i < 8; ++i, ++p) {
+        if (is_eostring(*p)) {
+            return p;
+        }
+    }
+
+    // Large documents tend to be dominated by long strings (e.g. embedded base64 images):
+    // scan 16 chars at a time for as long as the input allows it.
+    while (p_stop - p >= 16) {
+        const auto c = skvx::byte16::Load(p);
+        if (any((c < 0x20) | (c == '"') | (c == '\\') | (c == ']') | (c == '}'))) {
+            break;
+        }
+        p += 16;
+    }
+
+    while (!is_eostring(*p)) ++p;
+    return p;
+}
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -300,8 +341,10 @@ static inline float pow10(int32_t exp) {
 
 class DOMParser {
 public:
-    explicit DOMParser(SkArenaAlloc& alloc)
-        : fAlloc(alloc) {
+    // In-place parsers terminate long strings in the (writable) input, and reference them there.
+    DOMParser(SkArenaAlloc& alloc, bool in_place)
+        : fAlloc(alloc)
+        , fInPlace(in_place) {
         fValueStack.reserve(kValueStackReserve);
         fUnescapeBuffer.reserve(kUnescapeBufferReserve);
     }
@@ -346,8 +389,9 @@ public:
         p = skip_ws(p);
         if (*p != '"') return this->error(NullValue(), p, "expected object key");
 
-        p = this->matchString(p, p_stop, [this](const char* key, size_t size, const char* eos) {
-            this->pushObjectKey(key, size, eos);
+        p = this->matchString(p, p_stop, [this](const char* key, size_t size, const char* eos,
+                                                bool in_place) {
+            this->pushObjectKey(key, size, eos, in_place);
         });
         if (!p) return NullValue();
 
@@ -364,8 +408,9 @@ public:
         case '\0':
             return this->error(NullValue(), p, "unexpected input end");
         case '"':
-            p = this->matchString(p, p_stop, [this](const char* str, size_t size, const char* eos) {
-                this->pushString(str, size, eos);
+            p = this->matchString(p, p_stop, [this](const char* str, size_t size,
+                                                    const char* eos, bool in_place) {
+                this->pushString(str, size, eos, in_place);
             });
             break;
         case '[':
@@ -473,6 +518,7 @@ public:
 
 private:
     SkArenaAlloc&         fAlloc;
+    const bool            fInPlace;
 
     // Pending values stack.
     inline static constexpr size_t kValueStackReserve = 256;
@@ -575,11 +621,11 @@ private:
         )
     }
 
-    void pushObjectKey(const char* key, size_t size, const char* eos) {
+    void pushObjectKey(const char* key, size_t size, const char* eos, bool in_place) {
         SkASSERT(this->inObjectScope());
         SkASSERT(fValueStack.size() >= SkTo<size_t>(fScopeIndex));
         SkASSERT(!((fValueStack.size() - SkTo<size_t>(fScopeIndex)) & 1));
-        this->pushString(key, size, eos);
+        this->pushString(key, size, eos, in_place);
     }
 
     void pushTrue() {
@@ -594,8 +640,8 @@ private:
         fValueStack.push_back(NullValue());
     }
 
-    void pushString(const char* s, size_t size, const char* eos) {
-        fValueStack.push_back(FastString(s, size, eos, fAlloc));
+    void pushString(const char* s, size_t size, const char* eos, bool in_place) {
+        fValueStack.push_back(FastString(s, size, eos, fAlloc, in_place));
     }
 
     void pushInt32(int32_t i) {
@@ -703,12 +749,12 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            p = skip_string_chars(p + 1, p_stop);
 
             if (*p == '"') {
                 // Valid string found.
                 if (!requires_unescape) {
-                    func(s_begin, p - s_begin, p_stop);
+                    func(s_begin, p - s_begin, p_stop, fInPlace);
                 } else {
                     // Slow unescape.  We could avoid this extra copy with some effort,
                     // but in practice escaped strings should be rare.
@@ -718,7 +764,7 @@ private:
                     }
 
                     SkASSERT(!buf->empty());
-                    func(buf->data(), buf->size(), buf->data() + buf->size() - 1);
+                    func(buf->data(), buf->size(), buf->data() + buf->size() - 1, false);
                 }
                 return p + 1;
             }
@@ -920,11 +966,21 @@ static constexpr size_t kMinChunkSize = 4096;
 
 DOM::DOM(const char* data, size_t size)
     : fAlloc(kMinChunkSize) {
-    DOMParser parser(fAlloc);
+    DOMParser parser(fAlloc, false);
 
     fRoot = parser.parse(data, size);
 }
 
+DOM::DOM(sk_sp<SkData> data)
+    : fData(data && !data->unique() ? SkData::MakeWithCopy(data->data(), data->size())
+                                    : std::move(data))
+    , fAlloc(kMinChunkSize) {
+    DOMParser parser(fAlloc, true);
+
+    fRoot = fData ? parser.parse(static_cast<const char*>(fData->writable_data()), fData->size())
+                  : parser.parse(nullptr, 0);
+}
+
 void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
@@ -8,6 +8,8 @@
 #ifndef SkJSON_DEFINED
 #define SkJSON_DEFINED
 
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkNoncopyable.h"
 #include "src/core/SkArenaAlloc.h"
@@ -135,6 +137,13 @@ protected:
     };
     inline static constexpr uint8_t kTagMask = 0b00000111;
 
+    // kString payload: the chars (and a \0 terminator) follow the record in the DOM arena,
+    // or stay in the input buffer for DOMs parsed in place.
+    struct LongString {
+        size_t      fSize;
+        const char* fChars;
+    };
+
     void init_tagged(Tag);
     void init_tagged_pointer(Tag, void*);
 
@@ -298,7 +307,7 @@ public:
             // short_strlen.
             return strlen(this->cast<char>());
         case Tag::kString:
-            return this->cast<VectorValue<char, Value::Type::kString>>()->size();
+            return this->ptr<LongString>()->fSize;
         default:
             return 0;
         }
@@ -307,13 +316,13 @@ public:
     const char* begin() const {
         return this->getTag() == Tag::kShortString
             ? this->cast<char>()
-            : this->cast<VectorValue<char, Value::Type::kString>>()->begin();
+            : this->ptr<LongString>()->fChars;
     }
 
     const char* end() const {
         return this->getTag() == Tag::kShortString
             ? strchr(this->cast<char>(), '\0')
-            : this->cast<VectorValue<char, Value::Type::kString>>()->end();
+            : this->ptr<LongString>()->fChars + this->ptr<LongString>()->fSize;
     }
 
     std::string_view str() const {
@@ -341,13 +350,19 @@ class DOM final : public SkNoncopyable {
 public:
     DOM(const char*, size_t);
 
+    // Parses the data in place: long strings point into it instead of being copied, and the
+    // DOM keeps it alive.  The contents get clobbered, so the data must be writable (e.g. not
+    // a SkData::MakeFromFileName() mapping).  Shared data is copied first.
+    explicit DOM(sk_sp<SkData>);
+
     const Value& root() const { return fRoot; }
 
     void write(SkWStream*) const;
 
 private:
-    SkArenaAlloc fAlloc;
-    Value        fRoot;
+    sk_sp<SkData> fData;  // Input, when parsed in place.
+    SkArenaAlloc  fAlloc;
+    Value         fRoot;
 };
 
 inline Value::Type Value::getType() const {
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkTiledRasterizer.h"
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPicture.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkBitmapDevice.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkSurfacePriv.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+bool reads_outside_own_bounds(const SkPicture*);
+
+// Tiles are drawn concurrently into the same pixels, so an op that reads what other tiles may
+// be writing can't be split up.
+struct ReadsOutsideOwnBounds {
+    template <typename T>
+    bool operator()(const T&) { return false; }
+
+    bool operator()(const SkRecords::SaveLayer& op) {
+        return op.backdrop || (op.saveLayerFlags & SkCanvas::kInitWithPrevious_SaveLayerFlag);
+    }
+    bool operator()(const SkRecords::SaveBehind&) { return true; }
+    bool operator()(const SkRecords::DrawPicture& op) {
+        return reads_outside_own_bounds(op.picture.get());
+    }
+};
+
+bool reads_outside_own_bounds(const SkPicture* picture) {
+    const SkBigPicture* big = picture ? SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture)) : nullptr;
+    if (!big) {
+        return false;  // Mini-pictures hold a single draw, and never any of the above.
+    }
+    ReadsOutsideOwnBounds visitor;
+    const SkRecord& record = *big->record();
+    for (int i = 0; i < record.count(); i++) {
+        if (record.visit(i, visitor)) {
+            return true;
+        }
+    }
+    for (int i = 0; i < big->drawableCount(); i++) {
+        if (reads_outside_own_bounds(big->drawablePicts()[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+SkTiledRasterizer::SkTiledRasterizer(const SkPixmap& dst, SkExecutor& executor,
+                                     SkISize tileSize, const SkSurfaceProps* props)
+        : fDst(dst)
+        , fExecutor(executor)
+        , fTileSize(SkISize::Make(std::max(tileSize.width(), 1), std::max(tileSize.height(), 1)))
+        , fProps(SkSurfacePropsCopyOrDefault(props)) {}
+
+SkTiledRasterizer::~SkTiledRasterizer() = default;
+
+SkCanvas* SkTiledRasterizer::beginRecording() {
+    // The R-tree lets each tile skip the ops that can't touch it.
+    SkRTreeFactory factory;
+    return fRecorder.beginRecording(SkRect::Make(fDst.bounds()), &factory);
+}
+
+SkCanvas* SkTiledRasterizer::getRecordingCanvas() {
+    return fRecorder.getRecordingCanvas();
+}
+
+void SkTiledRasterizer::flush() {
+    if (!fRecorder.getRecordingCanvas()) {
+        return;
+    }
+    sk_sp<SkPicture> picture = fRecorder.finishRecordingAsPicture();
+    this->drawPicture(picture.get());
+}
+
+int SkTiledRasterizer::tileCount() const {
+    int cols = (fDst.width()  + fTileSize.width()  - 1) / fTileSize.width(),
+        rows = (fDst.height() + fTileSize.height() - 1) / fTileSize.height();
+    return cols * rows;
+}
+
+void SkTiledRasterizer::drawPicture(const SkPicture* picture) {
+    SkBitmap bitmap;
+    if (!picture || !bitmap.installPixels(fDst)) {
+        return;
+    }
+
+    if (reads_outside_own_bounds(picture)) {
+        SkCanvas canvas(bitmap, fProps);
+        picture->playback(&canvas);
+        return;
+    }
+
+    const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture));
+    const int cols = (fDst.width() + fTileSize.width() - 1) / fTileSize.width();
+
+    // Clipping to a tile would change how paths are rasterized (edges get chopped at the clip),
+    // and layers would lose whatever their image filters read from beyond the tile. So each tile
+    // keeps the whole destination in view and its device just drops the blits outside of the
+    // tile. A few blits that straddle that edge get split and may round differently, so tiles
+    // actually draw one extra pixel all around, into scratch pixels of their own, and only the
+    // tile itself is copied back out.
+    //
+    // Since nothing lands outside of those apron rows, scratch memory only holds them: it's
+    // addressed as if it were the whole destination, lined up so the apron's top row is the
+    // start of the allocation. Scratch memory is reused between tiles, so there are only ever
+    // as many as tiles drawing at once.
+    const SkImageInfo& info = fDst.info();
+    const size_t rowBytes     = info.minRowBytes(),
+                 scratchBytes = rowBytes * std::min(fTileSize.height() + 2, fDst.height());
+    SkMutex scratchLock;
+    std::vector<SkAutoFree> freeScratch;
+
+    SkTaskGroup tiles(fExecutor);
+    tiles.batch(this->tileCount(), [&](int i) {
+        SkIRect tile = SkIRect::MakeXYWH((i % cols) * fTileSize.width(),
+                                         (i / cols) * fTileSize.height(),
+                                         fTileSize.width(),
+                                         fTileSize.height());
+        SkAssertResult(tile.intersect(fDst.bounds()));
+        SkIRect apron = tile.makeOutset(1, 1);
+        SkAssertResult(apron.intersect(fDst.bounds()));
+
+        SkAutoFree storage;
+        {
+            SkAutoMutexExclusive lock(scratchLock);
+            if (!freeScratch.empty()) {
+                storage = std::move(freeScratch.back());
+                freeScratch.pop_back();
+            }
+        }
+        if (!storage) {
+            storage.reset(sk_malloc_canfail(scratchBytes));
+            if (!storage) {
+                return;
+            }
+        }
+
+        // This sort of trickery upsets UBSAN (pointer-overflow), so our ptr must be a uintptr_t.
+        SkBitmap scratch;
+        SkAssertResult(scratch.installPixels(
+                info, (void*)((uintptr_t)storage.get() - apron.top() * rowBytes), rowBytes));
+
+        SkPixmap src, dst;
+        SkAssertResult(fDst.extractSubset(&dst, tile));
+        SkAssertResult(scratch.writePixels(dst, tile.x(), tile.y()));
+
+        {
+            auto device = sk_make_sp<SkBitmapDevice>(scratch, fProps);
+            device->setBlitBounds(apron);
+            SkCanvas canvas(device);
+
+            if (big && big->bbh()) {
+                // This is SkRecordDraw(), except that it queries the tile rather than the clip.
+                // The outset matches the slop getLocalClipBounds() would have added.
+                std::vector<int> ops;
+                big->bbh()->search(SkRect::Make(apron.makeOutset(1, 1)), &ops);
+
+                SkRecords::Draw draw(&canvas, big->drawablePicts(), nullptr,
+                                     big->drawableCount());
+                for (int op : ops) {
+                    big->record()->visit(op, draw);
+                }
+            } else {
+                picture->playback(&canvas);
+            }
+        }
+
+        SkAssertResult(scratch.pixmap().extractSubset(&src, tile));
+        SkAssertResult(src.readPixels(dst));
+
+        SkAutoMutexExclusive lock(scratchLock);
+        freeScratch.push_back(std::move(storage));
+    });
+    tiles.wait();
+}
@@ -29,9 +29,11 @@
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/SkFloatBits.h"
 #include "include/private/SkTPin.h"
+#include "include/utils/SkRandom.h"
 #include "src/core/SkBlurMask.h"
 #include "src/core/SkGpuBlurUtils.h"
 #include "src/core/SkMask.h"
+#include "src/core/SkMaskBlurFilter.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMathPriv.h"
 #include "src/effects/SkEmbossMaskFilter.h"
@@ -585,3 +587,102 @@ DEF_TEST(zero_blur, reporter) {
     SkIPoint offset;
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
+
+// Rows are blurred several at a time in SIMD lanes, with any leftovers blurred one by one. Padding
+// a mask with an empty row and column changes which rows are grouped together, but should only
+// shift the blurred result.
+DEF_TEST(MaskBlurFilter_Translate, reporter) {
+    constexpr int kW = 301, kH = 263;
+
+    SkMask src;
+    src.fBounds   = SkIRect::MakeWH(kW, kH);
+    src.fFormat   = SkMask::kA8_Format;
+    src.fRowBytes = kW;
+    src.fImage    = SkMask::AllocImage(src.computeImageSize());
+    SkAutoMaskFreeImage srcFree(src.fImage);
+
+    SkMask padded = src;
+    padded.fBounds   = SkIRect::MakeWH(kW + 1, kH + 1);
+    padded.fRowBytes = kW + 1;
+    padded.fImage    = SkMask::AllocImage(padded.computeImageSize(), SkMask::kZeroInit_Alloc);
+    SkAutoMaskFreeImage paddedFree(padded.fImage);
+
+    SkRandom rand;
+    for (int y = 0; y < kH; ++y) {
+        for (int x = 0; x < kW; ++x) {
+            uint8_t alpha = rand.nextU() & 0xff;
+            *src.getAddr8(x, y) = alpha;
+            *padded.getAddr8(x + 1, y + 1) = alpha;
+        }
+    }
+
+    for (double sigma : {0.8, 2.5, 7.0, 30.0}) {
+        SkMaskBlurFilter filter(sigma, sigma);
+        SkMask dst, paddedDst;
+        SkIPoint border = filter.blur(src, &dst),
+                 paddedBorder = filter.blur(padded, &paddedDst);
+        SkAutoMaskFreeImage dstFree(dst.fImage), paddedDstFree(paddedDst.fImage);
+
+        REPORTER_ASSERT(reporter, border == paddedBorder);
+        REPORTER_ASSERT(reporter, dst.fBounds.width()  + 1 == paddedDst.fBounds.width());
+        REPORTER_ASSERT(reporter, dst.fBounds.height() + 1 == paddedDst.fBounds.height());
+
+        int mismatches = 0;
+        for (int y = 0; y < dst.fBounds.height(); ++y) {
+            for (int x = 0; x < dst.fBounds.width(); ++x) {
+                mismatches += dst.fImage[y * dst.fRowBytes + x] !=
+                              paddedDst.fImage[(y + 1) * paddedDst.fRowBytes + x + 1];
+            }
+        }
+        REPORTER_ASSERT(reporter, mismatches == 0, "sigma %g: %d mismatches", sigma, mismatches);
+    }
+}
+
+// Blurring rows in SIMD lanes, and in bands that may run in parallel, must match blurring every
+// row with the scalar scan in a single band, bit for bit.
+DEF_TEST(MaskBlurFilter_LanesMatchScalar, reporter) {
+    SkRandom rand;
+    for (SkISize size : {SkISize{1, 1}, SkISize{3, 5}, SkISize{17, 9}, SkISize{64, 64},
+                         SkISize{301, 263}, SkISize{1000, 70}}) {
+        SkMask src;
+        src.fBounds   = SkIRect::MakeSize(size);
+        src.fFormat   = SkMask::kA8_Format;
+        src.fRowBytes = size.width();
+        src.fImage    = SkMask::AllocImage(src.computeImageSize());
+        SkAutoMaskFreeImage srcFree(src.fImage);
+        for (size_t i = 0; i < src.computeImageSize(); ++i) {
+            src.fImage[i] = rand.nextU() & 0xff;
+        }
+
+        for (double sigma : {2.0, 2.5, 7.0, 30.0}) {
+            SkMaskBlurFilter filter(sigma, sigma);
+            SkMask expected;
+            // One band holds every row.
+            SkIPoint expectedBorder = filter.blurForTesting(src, &expected, 1 << 16, true);
+            SkAutoMaskFreeImage expectedFree(expected.fImage);
+
+            // 0 splits the bands as blur() does.
+            for (int bandRows : {0, 1, 3, 4, 5, 8, 13}) {
+                SkMask actual;
+                SkIPoint border = filter.blurForTesting(src, &actual, bandRows, false);
+                SkAutoMaskFreeImage actualFree(actual.fImage);
+
+                REPORTER_ASSERT(reporter, border == expectedBorder);
+                REPORTER_ASSERT(reporter, actual.fBounds == expected.fBounds);
+                if (actual.fBounds != expected.fBounds) {
+                    continue;
+                }
+                int mismatches = 0;
+                for (int y = 0; y < actual.fBounds.height(); ++y) {
+                    for (int x = 0; x < actual.fBounds.width(); ++x) {
+                        mismatches += actual.fImage[y * actual.fRowBytes + x] !=
+                                      expected.fImage[y * expected.fRowBytes + x];
+                    }
+                }
+                REPORTER_ASSERT(reporter, mismatches == 0,
+                                "%dx%d sigma %g bands of %d: %d mismatches",
+                                size.width(), size.height(), sigma, bandRows, mismatches);
+            }
+        }
+    }
+}
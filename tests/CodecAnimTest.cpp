@@ -13,6 +13,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -626,3 +627,50 @@ DEF_TEST(AnimCodecPlayer, r) {
                         "Mismatched size for frame at 500 ms of %s", test.fFile);
     }
 }
+
+DEF_TEST(AnimCodecPlayer_decodeAhead, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (const char* file : { "images/alphabetAnim.gif",
+                              "images/flightAnim.gif",
+                              "images/required.gif",
+                              "images/required.webp",
+                              "images/stoplight.webp" }) {
+        sk_sp<SkData> data = GetResourceAsData(file);
+        if (!data) {
+            continue;
+        }
+
+        std::vector<uint32_t> startTimes;
+        uint32_t time = 0;
+        for (const auto& info : SkCodec::MakeFromData(data)->getFrameInfo()) {
+            startTimes.push_back(time);
+            time += info.fDuration;
+        }
+
+        SkAnimCodecPlayer serial(SkCodec::MakeFromData(data));
+
+        SkAnimCodecPlayer::DecodeOptions options;
+        options.fExecutor = executor.get();
+        options.fLookahead = 4;
+        options.fMaxCachedFrames = 3;
+        SkAnimCodecPlayer parallel(data, options);
+        REPORTER_ASSERT(r, parallel.duration() == serial.duration());
+        REPORTER_ASSERT(r, parallel.dimensions() == serial.dimensions());
+
+        // Play through twice, so the second loop decodes frames the small cache dropped.
+        for (int loop = 0; loop < 2; ++loop) {
+            for (size_t i = 0; i < startTimes.size(); ++i) {
+                serial.seek(startTimes[i]);
+                parallel.seek(startTimes[i]);
+                auto expected = serial.getFrame();
+                auto actual = parallel.getFrame();
+                REPORTER_ASSERT(r, expected && actual);
+                if (expected && actual) {
+                    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected.get(), actual.get()),
+                                    "%s: frame %zu differs", file, i);
+                }
+            }
+        }
+    }
+}
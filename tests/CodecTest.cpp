@@ -1936,3 +1936,154 @@ DEF_TEST(Codec_noConversion, r) {
         REPORTER_ASSERT(r, bm.getColor(0, 0) == rec.color);
     }
 }
+
+DEF_TEST(Codec_decodeStrips, r) {
+    static constexpr struct {
+        const char* fPath;
+        bool        fOneBuffer;  // Whether every strip is decoded into the same buffer.
+    } kImages[] = {
+        { "images/mandrill_128.png",      true  },
+        { "images/plane_interlaced.png",  false },
+        { "images/mandrill_512_q075.jpg", true  },
+        { "images/color_wheel.webp",      false },
+        { "images/randPixels.bmp",        false },
+    };
+    for (const auto& image : kImages) {
+        const char* path = image.fPath;
+        auto data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+
+        std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(data));
+        if (!codec) {
+            ERRORF(r, "Could not create codec for %s", path);
+            continue;
+        }
+        SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType)
+                                           .makeAlphaType(kPremul_SkAlphaType);
+
+        SkBitmap expected;
+        expected.allocPixels(info);
+        if (codec->getPixels(expected.pixmap()) != SkCodec::kSuccess) {
+            ERRORF(r, "Failed to decode %s", path);
+            continue;
+        }
+
+        // Reassemble the strips; the last one is shorter unless 7 divides the height.
+        constexpr int kStripHeight = 7;
+        SkBitmap actual;
+        actual.allocPixels(info);
+        int nextTop = 0;
+        const void* firstStrip = nullptr;
+        auto result = codec->decodeStrips(info, kStripHeight,
+                                          [&](const SkPixmap& strip, int top) {
+            REPORTER_ASSERT(r, top == nextTop);
+            REPORTER_ASSERT(r, strip.width() == info.width());
+            REPORTER_ASSERT(r, strip.height() == std::min(kStripHeight, info.height() - top));
+            if (!firstStrip) {
+                firstStrip = strip.addr();
+            }
+            REPORTER_ASSERT(r, !image.fOneBuffer || strip.addr() == firstStrip,
+                            "%s: strip at %d has its own buffer", path, top);
+            for (int y = 0; y < strip.height(); ++y) {
+                memcpy(actual.getAddr(0, top + y), strip.addr(0, y), strip.info().minRowBytes());
+            }
+            nextTop = top + strip.height();
+            return true;
+        });
+        REPORTER_ASSERT(r, result == SkCodec::kSuccess, "%s: %s", path,
+                        SkCodec::ResultToString(result));
+        REPORTER_ASSERT(r, nextTop == info.height());
+        REPORTER_ASSERT(r, md5(expected) == md5(actual), "%s: strips differ", path);
+
+        // The proc can stop the decode early.
+        int strips = 0;
+        result = codec->decodeStrips(info, kStripHeight, [&](const SkPixmap&, int) {
+            return ++strips < 2;
+        });
+        REPORTER_ASSERT(r, result == SkCodec::kSuccess);
+        REPORTER_ASSERT(r, strips == 2);
+
+        result = codec->decodeStrips(info, 0, [](const SkPixmap&, int) { return true; });
+        REPORTER_ASSERT(r, result == SkCodec::kInvalidParameters);
+
+        // With the data cut off part way through, the strips and the result still match
+        // getPixels().
+        codec = SkCodec::MakeFromData(SkData::MakeSubset(data.get(), 0, data->size() / 2));
+        if (!codec) {
+            continue;
+        }
+        auto expectedResult = codec->getPixels(expected.pixmap());
+        nextTop = 0;
+        result = codec->decodeStrips(info, kStripHeight, [&](const SkPixmap& strip, int top) {
+            REPORTER_ASSERT(r, top == nextTop);
+            for (int y = 0; y < strip.height(); ++y) {
+                memcpy(actual.getAddr(0, top + y), strip.addr(0, y), strip.info().minRowBytes());
+            }
+            nextTop = top + strip.height();
+            return true;
+        });
+        REPORTER_ASSERT(r, result == expectedResult, "%s: %s != %s", path,
+                        SkCodec::ResultToString(result), SkCodec::ResultToString(expectedResult));
+        if (expectedResult == SkCodec::kIncompleteInput ||
+            expectedResult == SkCodec::kErrorInInput) {
+            REPORTER_ASSERT(r, nextTop == info.height());
+            REPORTER_ASSERT(r, md5(expected) == md5(actual), "%s: truncated strips differ", path);
+        }
+    }
+}
+
+// A tall non-interlaced PNG is decoded through a single strip-sized buffer, not a full-image
+// temporary, including when the data is cut off part way through a strip.
+DEF_TEST(Codec_decodeStrips_tallPng, r) {
+    constexpr int kWidth = 32, kHeight = 20000, kStripHeight = 16;
+    SkBitmap source;
+    source.allocPixels(SkImageInfo::MakeN32Premul(kWidth, kHeight));
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            *source.getAddr32(x, y) = SkPreMultiplyColor(
+                    SkColorSetRGB(y & 0xFF, (y >> 8) & 0xFF, x * 8));
+        }
+    }
+    SkDynamicMemoryWStream stream;
+    REPORTER_ASSERT(r, SkPngEncoder::Encode(&stream, source.pixmap(), SkPngEncoder::Options()));
+    auto data = stream.detachAsData();
+
+    for (size_t size : { data->size(), data->size() / 3 }) {
+        std::unique_ptr<SkCodec> codec(
+                SkCodec::MakeFromData(SkData::MakeSubset(data.get(), 0, size)));
+        REPORTER_ASSERT(r, codec);
+        if (!codec) {
+            return;
+        }
+
+        int nextTop = 0, mismatchedRows = 0;
+        const void* firstStrip = nullptr;
+        auto result = codec->decodeStrips(source.info(), kStripHeight,
+                                          [&](const SkPixmap& strip, int top) {
+            REPORTER_ASSERT(r, top == nextTop);
+            if (!firstStrip) {
+                firstStrip = strip.addr();
+            }
+            REPORTER_ASSERT(r, strip.addr() == firstStrip, "strip at %d has its own buffer", top);
+            for (int y = 0; y < strip.height(); ++y) {
+                // Rows past the end of the data are filled, so only the decoded ones match.
+                if (memcmp(strip.addr(0, y), source.getAddr(0, top + y), kWidth * 4)) {
+                    mismatchedRows++;
+                }
+            }
+            nextTop = top + strip.height();
+            return true;
+        });
+        REPORTER_ASSERT(r, nextTop == kHeight);
+        if (size == data->size()) {
+            REPORTER_ASSERT(r, result == SkCodec::kSuccess, "%s", SkCodec::ResultToString(result));
+            REPORTER_ASSERT(r, mismatchedRows == 0);
+        } else {
+            REPORTER_ASSERT(r, result == SkCodec::kIncompleteInput, "%s",
+                            SkCodec::ResultToString(result));
+            REPORTER_ASSERT(r, mismatchedRows > 0 && mismatchedRows < kHeight);
+        }
+    }
+}
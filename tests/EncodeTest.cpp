@@ -15,6 +15,7 @@
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageInfo.h"
@@ -343,6 +344,51 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+DEF_TEST(Encode_PngParallel, r) {
+    SkBitmap bitmap;
+    bool success = GetResourceAsBitmap("images/mandrill_512.png", &bitmap);
+    if (!success) {
+        return;
+    }
+
+    SkPixmap src;
+    success = bitmap.peekPixels(&src);
+    REPORTER_ASSERT(r, success);
+    if (!success) {
+        return;
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    for (SkPngEncoder::FilterFlag filters : { SkPngEncoder::FilterFlag::kAll,
+                                              SkPngEncoder::FilterFlag::kSub,
+                                              SkPngEncoder::FilterFlag::kNone }) {
+        SkPngEncoder::Options options;
+        options.fFilterFlags = filters;
+        SkDynamicMemoryWStream serial, parallel, rowByRow;
+        REPORTER_ASSERT(r, SkPngEncoder::Encode(&serial, src, options));
+
+        options.fExecutor = executor.get();
+        REPORTER_ASSERT(r, SkPngEncoder::Encode(&parallel, src, options));
+
+        // Encoding a few rows at a time never goes parallel.
+        auto encoder = SkPngEncoder::Make(&rowByRow, src, options);
+        for (int y = 0; y < src.height(); y += 7) {
+            REPORTER_ASSERT(r, encoder->encodeRows(7));
+        }
+
+        sk_sp<SkData> serialData   = serial.detachAsData(),
+                      parallelData = parallel.detachAsData(),
+                      rowByRowData = rowByRow.detachAsData();
+        REPORTER_ASSERT(r, !serialData->equals(parallelData.get()));
+        REPORTER_ASSERT(r, serialData->equals(rowByRowData.get()));
+
+        SkBitmap serialBitmap, parallelBitmap;
+        SkImage::MakeFromEncoded(serialData)->asLegacyBitmap(&serialBitmap);
+        SkImage::MakeFromEncoded(parallelData)->asLegacyBitmap(&parallelBitmap);
+        REPORTER_ASSERT(r, almost_equals(serialBitmap, parallelBitmap, 0));
+    }
+}
+
 #ifndef SK_BUILD_FOR_GOOGLE3
 DEF_TEST(Encode_WebpQuality, r) {
     SkBitmap bm;
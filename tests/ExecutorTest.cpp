@@ -0,0 +1,46 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "src/core/SkTaskGroup.h"
+#include "tests/Test.h"
+
+#include <atomic>
+
+DEF_TEST(SkExecutor_WorkStealing_RunsAllWork, r) {
+    for (bool pinThreads : {false, true}) {
+        auto executor = SkExecutor::MakeWorkStealingPool(4, /*allowBorrowing=*/true, pinThreads);
+
+        // Tasks added from outside the pool.
+        std::atomic<int> count{0};
+        SkTaskGroup group(*executor);
+        group.batch(1000, [&](int) { count++; });
+        group.wait();
+        REPORTER_ASSERT(r, count.load() == 1000);
+
+        // Tasks added from inside the pool, waited on by pool threads.
+        count = 0;
+        group.batch(100, [&](int) {
+            SkTaskGroup inner(*executor);
+            inner.batch(100, [&](int) { count++; });
+        });
+        group.wait();
+        REPORTER_ASSERT(r, count.load() == 100 * 100);
+    }
+}
+
+DEF_TEST(SkExecutor_WorkStealing_Shutdown, r) {
+    // Work still queued when the pool is destroyed must still run.
+    std::atomic<int> count{0};
+    {
+        auto executor = SkExecutor::MakeWorkStealingPool(3, /*allowBorrowing=*/false);
+        for (int i = 0; i < 500; i++) {
+            executor->add([&] { count++; });
+        }
+    }
+    REPORTER_ASSERT(r, count.load() == 500);
+}
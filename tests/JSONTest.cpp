@@ -15,6 +15,7 @@
 #include "tests/Test.h"
 
 #include <cstring>
+#include <string>
 #include <string_view>
 
 using namespace skjson;
@@ -136,21 +137,76 @@ DEF_TEST(JSON_Parse, reporter) {
     };
 
     for (const auto& tst : g_tests) {
-        DOM dom(tst.in, strlen(tst.in));
-        const auto success = !dom.root().is<NullValue>();
-        REPORTER_ASSERT(reporter, success == (tst.out != nullptr));
-        if (!success) continue;
+        const auto check = [&](const DOM& dom) {
+            const auto success = !dom.root().is<NullValue>();
+            REPORTER_ASSERT(reporter, success == (tst.out != nullptr), "%s", tst.in);
+            if (!success) return;
 
-        SkDynamicMemoryWStream str;
-        dom.write(&str);
-        str.write8('\0');
+            SkDynamicMemoryWStream str;
+            dom.write(&str);
+            str.write8('\0');
 
-        auto data = str.detachAsData();
-        REPORTER_ASSERT(reporter, !strcmp(tst.out, static_cast<const char*>(data->data())));
+            auto data = str.detachAsData();
+            REPORTER_ASSERT(reporter, !strcmp(tst.out, static_cast<const char*>(data->data())),
+                            "%s", tst.in);
+        };
+
+        check(DOM(tst.in, strlen(tst.in)));
+
+        // Parsing in place must not change the result.
+        check(DOM(SkData::MakeWithCopy(tst.in, strlen(tst.in))));
     }
 
 }
 
+DEF_TEST(JSON_ParseLongStrings, reporter) {
+    // Exercise the string scanner with special chars at all offsets around its chunk boundaries.
+    static constexpr struct {
+        const char* in;
+        const char* out;  // nullptr -> invalid
+    } g_specials[] = {
+        { "x"       , "x"        },
+        { "}"       , "}"        },
+        { "]"       , "]"        },
+        { "\\n"     , "\n"       },
+        { "\\\""    , "\""       },
+        { "\\u00e9" , "\xc3\xa9" },
+        { "\xc3\xa9", "\xc3\xa9" },
+        { "\x01"    , nullptr    },
+    };
+
+    for (const auto& special : g_specials) {
+        for (size_t len = 0; len < 48; ++len) {
+            for (size_t pos = 0; pos <= len; ++pos) {
+                const std::string prefix(pos, 'a'),
+                                  suffix(len - pos, 'b');
+                const auto in  = "[\"" + prefix + special.in + suffix + "\"]";
+
+                const auto check = [&](const DOM& dom) {
+                    const ArrayValue* arr = dom.root();
+                    if (!special.out) {
+                        REPORTER_ASSERT(reporter, !arr, "%s", in.c_str());
+                        return;
+                    }
+
+                    const auto out = prefix + special.out + suffix;
+                    REPORTER_ASSERT(reporter, arr && arr->size() == 1, "%s", in.c_str());
+                    if (arr && arr->size() == 1) {
+                        REPORTER_ASSERT(reporter, (*arr)[0].is<StringValue>());
+                        REPORTER_ASSERT(reporter, (*arr)[0].as<StringValue>().str() == out,
+                                        "%s", in.c_str());
+                        REPORTER_ASSERT(reporter, !strcmp((*arr)[0].as<StringValue>().begin(),
+                                                          out.c_str()), "%s", in.c_str());
+                    }
+                };
+
+                check(DOM(in.data(), in.size()));
+                check(DOM(SkData::MakeWithCopy(in.data(), in.size())));
+            }
+        }
+    }
+}
+
 template <typename T, typename VT>
 static void check_primitive(skiatest::Reporter* reporter, const Value& v, T pv,
                             bool is_type) {
@@ -189,6 +245,54 @@ static void check_string(skiatest::Reporter* reporter, const Value& v, const cha
     }
 }
 
+DEF_TEST(JSON_ParseInPlace, reporter) {
+    static constexpr char json[] = R"({ "short": "abc",
+                                        "a_long_key": "a long value",
+                                        "escaped": "a long \"escaped\" value" })";
+
+    const auto in_input = [](const SkData& data, const StringValue& str) {
+        const auto* begin = static_cast<const char*>(data.data());
+        return str.begin() >= begin && str.end() < begin + data.size();
+    };
+
+    // Unique data: unescaped long strings (keys too) reference it, and stay \0-terminated.
+    auto data = SkData::MakeWithCopy(json, strlen(json));
+    const auto* input = data.get();
+    {
+        const DOM dom(std::move(data));
+        const ObjectValue* jroot = dom.root();
+        REPORTER_ASSERT(reporter, jroot && jroot->size() == 3);
+        if (!jroot || jroot->size() != 3) return;
+
+        check_string(reporter, (*jroot)["short"], "abc");
+        check_string(reporter, (*jroot)["a_long_key"], "a long value");
+        check_string(reporter, (*jroot)["escaped"], "a long \"escaped\" value");
+
+        const Member* members = jroot->begin();
+        REPORTER_ASSERT(reporter, !in_input(*input, members[0].fKey));
+        REPORTER_ASSERT(reporter,  in_input(*input, members[1].fKey));
+        REPORTER_ASSERT(reporter,  in_input(*input, members[1].fValue.as<StringValue>()));
+        REPORTER_ASSERT(reporter, !in_input(*input, members[2].fValue.as<StringValue>()));
+    }
+
+    // Shared data: parsed from a copy, leaving the original alone.
+    const auto shared = SkData::MakeWithCopy(json, strlen(json));
+    {
+        const DOM dom(shared);
+        const ObjectValue* jroot = dom.root();
+        REPORTER_ASSERT(reporter, jroot && jroot->size() == 3);
+        if (!jroot || jroot->size() != 3) return;
+
+        check_string(reporter, (*jroot)["a_long_key"], "a long value");
+        REPORTER_ASSERT(reporter, !in_input(*shared, jroot->begin()[1].fValue.as<StringValue>()));
+    }
+    REPORTER_ASSERT(reporter, shared->unique());
+    REPORTER_ASSERT(reporter, !memcmp(shared->data(), json, strlen(json)));
+
+    REPORTER_ASSERT(reporter, DOM(nullptr).root().is<NullValue>());
+    REPORTER_ASSERT(reporter, DOM(SkData::MakeEmpty()).root().is<NullValue>());
+}
+
 DEF_TEST(JSON_DOM_visit, reporter) {
     static constexpr char json[] = "{     \n\
         \"k1\": null,                     \n\
@@ -71,3 +71,25 @@ DEF_TEST(LRUCacheRandom, r) {
     }
     REPORTER_ASSERT(r, 0 == instances);
 }
+
+DEF_TEST(LRUCacheRemoveLRU, r) {
+    int instances = 0;
+    {
+        SkLRUCache<int, std::unique_ptr<Value>> test(10);
+        for (int k = 0; k < 4; k++) {
+            test.insert(k, std::make_unique<Value>(k, &instances));
+        }
+        REPORTER_ASSERT(r, test.find(0));  // 0 is now the most recently used
+
+        std::unique_ptr<Value> removed = test.removeLRU();
+        REPORTER_ASSERT(r, 1 == removed->fValue);
+        REPORTER_ASSERT(r, 4 == instances);
+        removed = test.removeLRU();
+        REPORTER_ASSERT(r, 2 == removed->fValue);
+        REPORTER_ASSERT(r, 3 == instances);
+        REPORTER_ASSERT(r, 2 == test.count());
+        REPORTER_ASSERT(r, !test.find(1) && !test.find(2));
+        REPORTER_ASSERT(r, test.find(0) && test.find(3));
+    }
+    REPORTER_ASSERT(r, 0 == instances);
+}
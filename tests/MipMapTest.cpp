@@ -227,6 +227,81 @@ DEF_TEST(MipMap_F16, reporter) {
     sk_sp<SkMipmap> mipmap(SkMipmap::Build(bmp, nullptr));
 }
 
+// Every filter is a weighted average, so a solid image must stay solid at every level, whichever
+// mix of even and odd dimensions (and so which filters) each level is built with.
+DEF_TEST(MipMap_SolidColor, reporter) {
+    const SkISize sizes[] = { {37, 19}, {64, 63}, {33, 64}, {1, 40}, {257, 3} };
+    for (SkColorType ct : {kN32_SkColorType, kAlpha_8_SkColorType}) {
+        for (SkISize size : sizes) {
+            SkBitmap bmp;
+            bmp.allocPixels(SkImageInfo::Make(size, ct, kPremul_SkAlphaType));
+            bmp.eraseColor(SkColorSetARGB(0xC0, 0x30, 0x60, 0x90));
+
+            const size_t bpp = bmp.info().bytesPerPixel();
+            sk_sp<SkMipmap> mipmap(SkMipmap::Build(bmp, nullptr));
+            REPORTER_ASSERT(reporter, mipmap);
+            for (int i = 0; mipmap && i < mipmap->countLevels(); ++i) {
+                SkMipmap::Level level;
+                REPORTER_ASSERT(reporter, mipmap->getLevel(i, &level));
+                const SkPixmap& pm = level.fPixmap;
+                for (int y = 0; y < pm.height(); ++y) {
+                    for (int x = 0; x < pm.width(); ++x) {
+                        REPORTER_ASSERT(reporter, !memcmp(pm.addr(x, y), bmp.getAddr(0, 0), bpp),
+                                        "ct %d %dx%d level %d (%d, %d)",
+                                        ct, size.width(), size.height(), i, x, y);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// The wide filters must match the one-pixel-at-a-time ones bit for bit, including the pixels
+// left over at the end of each row and the odd rows and columns that take the 3-tap filters.
+DEF_TEST(MipMap_WideFilters, reporter) {
+    const SkISize sizes[] = { {37, 19}, {65, 63}, {33, 64}, {131, 3}, {3, 77}, {255, 9} };
+    SkRandom rand;
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType, kAlpha_8_SkColorType,
+                           kRGBA_1010102_SkColorType}) {
+        for (SkISize size : sizes) {
+            // Rows with some padding, so the filters must follow rowBytes.
+            const auto info = SkImageInfo::Make(size, ct, kPremul_SkAlphaType);
+            SkBitmap bmp;
+            bmp.allocPixels(info, info.minRowBytes() + 12);
+            for (int y = 0; y < size.height(); ++y) {
+                auto row = static_cast<uint8_t*>(bmp.getAddr(0, y));
+                for (size_t i = 0; i < info.minRowBytes(); ++i) {
+                    row[i] = rand.nextU() >> 24;
+                }
+            }
+
+            sk_sp<SkMipmap> wide(SkMipmap::Build(bmp, nullptr));
+            const bool wasWide = SkMipmap::SetWideFiltersForTesting(false);
+            sk_sp<SkMipmap> scalar(SkMipmap::Build(bmp, nullptr));
+            SkMipmap::SetWideFiltersForTesting(wasWide);
+
+            REPORTER_ASSERT(reporter, wide && scalar);
+            if (!wide || !scalar) {
+                continue;
+            }
+            REPORTER_ASSERT(reporter, wide->countLevels() == scalar->countLevels());
+            for (int i = 0; i < wide->countLevels(); ++i) {
+                SkMipmap::Level w, s;
+                REPORTER_ASSERT(reporter, wide->getLevel(i, &w) && scalar->getLevel(i, &s));
+                const SkPixmap& wpm = w.fPixmap;
+                const SkPixmap& spm = s.fPixmap;
+                REPORTER_ASSERT(reporter, wpm.dimensions() == spm.dimensions());
+                const size_t rowBytes = wpm.info().minRowBytes();
+                for (int y = 0; y < wpm.height(); ++y) {
+                    REPORTER_ASSERT(reporter, !memcmp(wpm.addr(0, y), spm.addr(0, y), rowBytes),
+                                    "ct %d %dx%d level %d row %d",
+                                    ct, size.width(), size.height(), i, y);
+                }
+            }
+        }
+    }
+}
+
 static void fill_in_mips(SkMipmapBuilder* builder, sk_sp<SkImage> img) {
     int count = builder->countLevels();
     for (int i = 0; i < count; ++i) {
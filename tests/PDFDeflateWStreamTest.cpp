@@ -8,6 +8,7 @@
 #include "include/core/SkTypes.h"
 
 #ifdef SK_SUPPORT_PDF
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/SkMalloc.h"
@@ -174,4 +175,40 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+DEF_TEST(SkPDF_DeflateWStream_parallel, r) {
+    // Sizes on and around the 128 KB block boundaries, so that the dictionary priming and
+    // stitching of blocks gets exercised along with the empty and single-block cases.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom random(654321);
+    for (uint32_t size : {0u, 1u, 5000u, 131071u, 131072u, 131073u, 262144u, 1000000u}) {
+        SkAutoTMalloc<uint8_t> buffer(size);
+        for (uint32_t j = 0; j < size; ++j) {
+            // Compressible, but not trivially so.
+            buffer[j] = random.nextULessThan(8) ? 'a' + random.nextULessThan(8)
+                                                : random.nextU() & 0xff;
+        }
+
+        SkDynamicMemoryWStream dynamicMemoryWStream;
+        {
+            SkDeflateWStream deflateWStream(&dynamicMemoryWStream, -1, false, executor.get());
+            uint32_t j = 0;
+            while (j < size) {
+                uint32_t writeSize = std::min(size - j, random.nextRangeU(1, 70000));
+                REPORTER_ASSERT(r, deflateWStream.write(&buffer[j], writeSize));
+                j += writeSize;
+            }
+            REPORTER_ASSERT(r, deflateWStream.bytesWritten() == size);
+        }
+        std::unique_ptr<SkStreamAsset> compressed(dynamicMemoryWStream.detachAsStream());
+        std::unique_ptr<SkStreamAsset> decompressed(stream_inflate(r, compressed.get()));
+        if (!decompressed || decompressed->getLength() != size) {
+            ERRORF(r, "Parallel decompression of %u bytes failed.", (unsigned)size);
+            continue;
+        }
+        SkAutoTMalloc<uint8_t> result(size);
+        REPORTER_ASSERT(r, decompressed->read(result.get(), size) == size);
+        REPORTER_ASSERT(r, size == 0 || 0 == memcmp(result.get(), buffer.get(), size));
+    }
+}
+
 #endif
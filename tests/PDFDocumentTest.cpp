@@ -17,6 +17,7 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/docs/SkPDFDocument.h"
+#include "include/effects/SkGradientShader.h"
 #include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
 
@@ -24,6 +25,7 @@
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <string>
 
 static void test_empty(skiatest::Reporter* reporter) {
     SkDynamicMemoryWStream stream;
@@ -264,3 +266,70 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+// Jobs run on an executor mustn't change the document: it should come out byte for byte as it
+// does without one.  (Streams big enough to be deflated in parallel would differ, so these pages
+// stay small.)
+static sk_sp<SkData> make_executor_test_pdf(SkExecutor* executor) {
+    SkDynamicMemoryWStream stream;
+    SkPDF::Metadata metadata;
+    metadata.fExecutor = executor;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    SkBitmap translucent;
+    translucent.allocN32Pixels(32, 32);
+    for (int page = 0; page < 20; ++page) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        const SkPoint pts[2] = {{0, 0}, {612, 0}};
+        const SkColor colors[] = {SK_ColorRED, SkColorSetRGB(0, 0, 10 * page)};
+        SkPaint gradient;
+        gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                        SkTileMode::kRepeat));
+        canvas->drawRect({36, 36, 576, 96}, gradient);
+        translucent.eraseColor(SkColorSetARGB(0x80, 0xFF, page, 0));
+        canvas->drawImage(translucent.asImage(), 36, 108);
+        canvas->drawString(SkStringPrintf("Page %d", page), 36, 200, SkFont(), SkPaint());
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+DEF_TEST(SkPDF_executor_deterministic, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_executor_deterministic, r);
+    sk_sp<SkData> serial = make_executor_test_pdf(nullptr);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (int i = 0; i < 3; ++i) {
+        sk_sp<SkData> parallel = make_executor_test_pdf(executor.get());
+        REPORTER_ASSERT(r, serial->equals(parallel.get()));
+    }
+}
+
+static int count_occurrences(const SkData& data, const char* needle) {
+    std::string haystack(static_cast<const char*>(data.data()), data.size());
+    int count = 0;
+    for (size_t i = haystack.find(needle); i != std::string::npos;
+         i = haystack.find(needle, i + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+DEF_TEST(SkPDF_stream_pages, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_stream_pages, r);
+    SkDynamicMemoryWStream stream;
+    SkPDF::Metadata metadata;
+    metadata.fStreamPages = true;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    for (int page = 0; page < 20; ++page) {
+        doc->beginPage(612, 792)->drawString(SkStringPrintf("Page %d", page), 36, 36, SkFont(),
+                                             SkPaint());
+    }
+    doc->close();
+    sk_sp<SkData> pdf = stream.detachAsData();
+
+    // Pages are written in runs of eight under their own nodes, themselves under the root.
+    REPORTER_ASSERT(r, count_occurrences(*pdf, "/Type /Page\n") == 20);
+    REPORTER_ASSERT(r, count_occurrences(*pdf, "/Type /Pages\n") == 4);
+    REPORTER_ASSERT(r, count_occurrences(*pdf, "/Count 8\n") == 2);
+    REPORTER_ASSERT(r, count_occurrences(*pdf, "/Count 4\n") == 1);
+    REPORTER_ASSERT(r, count_occurrences(*pdf, "/Count 20\n") == 1);
+}
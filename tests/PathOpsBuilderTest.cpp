@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkRect.h"
@@ -13,6 +14,8 @@
 #include "tests/PathOpsExtendedTest.h"
 #include "tests/Test.h"
 
+#include <memory>
+
 DEF_TEST(PathOpsBuilder, reporter) {
     SkOpBuilder builder;
     SkPath result;
@@ -364,3 +367,38 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+DEF_TEST(SkOpBuilderExecutor, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkOpBuilder serial, parallel;
+    // Four clusters of overlapping circles, one of which also holds a touching rect.
+    for (int cluster = 0; cluster < 4; ++cluster) {
+        SkScalar x = cluster * 50;
+        for (int index = 0; index < 3; ++index) {
+            SkPath circle;
+            circle.addCircle(x + 10 + index * 8, 20, 10);
+            serial.add(circle, kUnion_SkPathOp);
+            parallel.add(circle, kUnion_SkPathOp);
+        }
+    }
+    SkPath rect;
+    rect.addRect(36, 10, 46, 30);
+    serial.add(rect, kUnion_SkPathOp);
+    parallel.add(rect, kUnion_SkPathOp);
+    SkPath serialResult, parallelResult;
+    REPORTER_ASSERT(reporter, serial.resolve(&serialResult));
+    REPORTER_ASSERT(reporter, parallel.resolve(&parallelResult, executor.get()));
+    int pixelDiff = comparePaths(reporter, __FUNCTION__, serialResult, parallelResult);
+    REPORTER_ASSERT(reporter, pixelDiff == 0);
+
+    // Other ops can't be split into clusters, but still resolve.
+    SkPath hole;
+    hole.addRect(5, 15, 15, 25);
+    for (SkOpBuilder* builder : {&serial, &parallel}) {
+        builder->add(serialResult, kUnion_SkPathOp);
+        builder->add(hole, kDifference_SkPathOp);
+    }
+    REPORTER_ASSERT(reporter, serial.resolve(&serialResult));
+    REPORTER_ASSERT(reporter, parallel.resolve(&parallelResult, executor.get()));
+    REPORTER_ASSERT(reporter, serialResult == parallelResult);
+}
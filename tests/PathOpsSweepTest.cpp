@@ -0,0 +1,122 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkTypes.h"
+#include "include/pathops/SkPathOps.h"
+#include "include/utils/SkRandom.h"
+#include "src/pathops/SkAddIntersections.h"
+#include "tests/Test.h"
+
+#include <climits>
+
+// AddIntersectTs() sweeps segment bounds for contour pairs with many segments, and compares every
+// pair of segments otherwise. Both must find the same intersections in the same order, so these
+// ops and simplifies must produce identical paths either way.
+
+enum class Verb { kLine, kQuad, kCubic };
+
+// A closed, star-like contour of 'points' jittered points around (cx, cy). A step of more than
+// one point makes it cross itself.
+static void add_star(SkPath* path, SkRandom* rand, SkScalar cx, SkScalar cy, SkScalar radius,
+                     int points, int step, Verb verb) {
+    auto point = [&](int i) {
+        const SkScalar angle = SK_ScalarPI * 2 * ((i * step) % points) / points;
+        const SkScalar r = radius * (i & 1 ? 0.6f : 1) * rand->nextRangeF(0.9f, 1.1f);
+        return SkPoint::Make(cx + r * SkScalarCos(angle), cy + r * SkScalarSin(angle));
+    };
+    const SkPoint start = point(0);
+    path->moveTo(start);
+    SkPoint last = start;
+    for (int i = 1; i <= points; ++i) {
+        const SkPoint next = i == points ? start : point(i);
+        const SkPoint mid = (last + next) * 0.5f + SkPoint::Make(rand->nextRangeF(-3, 3),
+                                                                 rand->nextRangeF(-3, 3));
+        switch (verb) {
+            case Verb::kLine:
+                path->lineTo(next);
+                break;
+            case Verb::kQuad:
+                path->quadTo(mid, next);
+                break;
+            case Verb::kCubic:
+                path->cubicTo(last * 0.5f + mid * 0.5f, mid * 0.5f + next * 0.5f, next);
+                break;
+        }
+        last = next;
+    }
+    path->close();
+}
+
+static void check_op(skiatest::Reporter* r, const SkPath& one, const SkPath& two, SkPathOp op,
+                     const char* name) {
+    SkPath pairwise, swept;
+    const int oldPairs = SetMinSweepSegmentPairsForTesting(INT_MAX);
+    const bool pairwiseOK = Op(one, two, op, &pairwise);
+    SetMinSweepSegmentPairsForTesting(0);
+    const bool sweptOK = Op(one, two, op, &swept);
+    SetMinSweepSegmentPairsForTesting(oldPairs);
+
+    REPORTER_ASSERT(r, pairwiseOK == sweptOK, "%s op %d", name, op);
+    REPORTER_ASSERT(r, pairwise == swept, "%s op %d", name, op);
+}
+
+static void check_simplify(skiatest::Reporter* r, const SkPath& path, const char* name) {
+    SkPath pairwise, swept;
+    const int oldPairs = SetMinSweepSegmentPairsForTesting(INT_MAX);
+    const bool pairwiseOK = Simplify(path, &pairwise);
+    SetMinSweepSegmentPairsForTesting(0);
+    const bool sweptOK = Simplify(path, &swept);
+    SetMinSweepSegmentPairsForTesting(oldPairs);
+
+    REPORTER_ASSERT(r, pairwiseOK == sweptOK, "%s", name);
+    REPORTER_ASSERT(r, pairwise == swept, "%s", name);
+}
+
+DEF_TEST(PathOpsSweep, r) {
+    static constexpr struct {
+        const char* fName;
+        Verb fVerb;
+        int fPoints;
+        int fStep;
+    } kCases[] = {
+        { "lines",             Verb::kLine,  64, 1 },
+        { "quads",             Verb::kQuad,  40, 1 },
+        { "cubics",            Verb::kCubic, 32, 1 },
+        { "crossing lines",    Verb::kLine,  61, 3 },
+        { "crossing cubics",   Verb::kCubic, 33, 2 },
+    };
+
+    SkRandom rand;
+    for (const auto& c : kCases) {
+        // Both contours have far more than sqrt(256) segments, so their pairs cross the threshold
+        // where AddIntersectTs() would sweep by default too.
+        REPORTER_ASSERT(r, c.fPoints * c.fPoints >= 256);
+
+        SkPath one, two;
+        add_star(&one, &rand, 100, 100, 80, c.fPoints, c.fStep, c.fVerb);
+        add_star(&two, &rand, 120, 110, 70, c.fPoints, c.fStep, c.fVerb);
+        for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+            check_op(r, one, two, (SkPathOp) op, c.fName);
+        }
+        check_simplify(r, one, c.fName);
+
+        // Two overlapping contours in one path.
+        SkPath both = one;
+        both.addPath(two);
+        check_simplify(r, both, c.fName);
+
+        // Coincident edges, both whole contours and a shared side of two rectangles.
+        check_op(r, one, one, kUnion_SkPathOp, c.fName);
+        both.addRect(SkRect::MakeLTRB(20, 20, 180, 100));
+        check_op(r, both, SkPath::Rect(SkRect::MakeLTRB(20, 100, 180, 180)),
+                 kUnion_SkPathOp, c.fName);
+    }
+}
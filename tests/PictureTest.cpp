@@ -34,6 +34,7 @@
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRectPriv.h"
 #include "tests/Test.h"
+#include "tools/Resources.h"
 
 #include <cstddef>
 #include <memory>
@@ -814,6 +815,91 @@ DEF_TEST(Picture_empty_serial, reporter) {
     REPORTER_ASSERT(reporter, pic2);
 }
 
+DEF_TEST(Picture_MakeFromSharedData, r) {
+    sk_sp<SkImage> image = GetResourceAsImage("images/mandrill_128.png");
+    if (!image) {
+        return;
+    }
+
+    SkPictureRecorder nestedRec;
+    nestedRec.beginRecording(64, 64)->drawCircle(32, 32, 20, SkPaint(SkColors::kBlue));
+    sk_sp<SkPicture> nested = nestedRec.finishRecordingAsPicture();
+
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording(128, 128);
+    canvas->drawImage(image, 0, 0);
+    canvas->drawPath(SkPath::Circle(64, 64, 30), SkPaint(SkColors::kRed));
+    canvas->drawPicture(nested);
+    sk_sp<SkData> data = rec.finishRecordingAsPicture()->serialize();
+
+    auto draw = [](const SkPicture* pic) {
+        SkBitmap bm;
+        bm.allocN32Pixels(128, 128);
+        bm.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas(bm).drawPicture(pic);
+        return bm;
+    };
+
+    sk_sp<SkPicture> copied = SkPicture::MakeFromData(data.get());
+    sk_sp<SkPicture> shared = SkPicture::MakeFromSharedData(data);
+    REPORTER_ASSERT(r, copied && shared);
+    if (copied && shared) {
+        SkBitmap expected = draw(copied.get()),
+                 actual   = draw(shared.get());
+        REPORTER_ASSERT(r, !memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+    }
+
+    // Truncated data must still fail validation.
+    REPORTER_ASSERT(r, !SkPicture::MakeFromSharedData(
+                               SkData::MakeSubset(data.get(), 0, data->size() / 2)));
+    REPORTER_ASSERT(r, !SkPicture::MakeFromSharedData(nullptr));
+}
+
+// Nested pictures this large are loaded lazily by MakeFromSharedData().
+DEF_TEST(Picture_MakeFromSharedData_Nested, r) {
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording(256, 256);
+    for (int i = 0; i < 4; ++i) {
+        SkPictureRecorder nestedRec;
+        SkCanvas* nestedCanvas = nestedRec.beginRecording(128, 128);
+        for (int j = 0; j < 500; ++j) {
+            nestedCanvas->drawRect(SkRect::MakeXYWH(j % 120, (j * 7) % 120, 8, 8),
+                                   SkPaint(SkColor4f::FromColor(SkColorSetRGB(i * 60, j, 0))));
+        }
+        canvas->save();
+        canvas->translate(128 * (i % 2), 128 * (i / 2));
+        canvas->drawPicture(nestedRec.finishRecordingAsPicture());
+        canvas->restore();
+    }
+    sk_sp<SkData> data = rec.finishRecordingAsPicture()->serialize();
+
+    sk_sp<SkPicture> copied = SkPicture::MakeFromData(data.get());
+    sk_sp<SkPicture> shared = SkPicture::MakeFromSharedData(data);
+    REPORTER_ASSERT(r, copied && shared);
+    if (!copied || !shared) {
+        return;
+    }
+
+    // Draw one corner first, so the other nested pictures load later, then everything.
+    for (SkRect clip : {SkRect::MakeWH(100, 100), SkRect::MakeWH(256, 256)}) {
+        auto draw = [&](const SkPicture* pic) {
+            SkBitmap bm;
+            bm.allocN32Pixels(256, 256);
+            bm.eraseColor(SK_ColorTRANSPARENT);
+            SkCanvas c(bm);
+            c.clipRect(clip);
+            c.drawPicture(pic);
+            return bm;
+        };
+        SkBitmap expected = draw(copied.get()),
+                 actual   = draw(shared.get());
+        REPORTER_ASSERT(r, !memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+    }
+    REPORTER_ASSERT(r, shared->approximateOpCount(true) == copied->approximateOpCount(true));
+}
+
 
 DEF_TEST(Picture_drawsNothing, r) {
     // Tests that pic->cullRect().isEmpty() is a good way to test a picture
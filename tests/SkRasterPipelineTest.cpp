@@ -521,6 +521,53 @@ DEF_TEST(SkRasterPipeline_lowp, r) {
     }
 }
 
+DEF_TEST(SkRasterPipeline_lowp_tail, r) {
+    // Every run length up to two full strides, so each possible lowp tail gets exercised
+    // (32 pixels at a time on AVX-512). Pixels past the end of the run must be left alone.
+    uint32_t src[64];
+    uint8_t  a8[64];
+    for (int i = 0; i < 64; i++) {
+        src[i] = (4*i+0) << 0
+               | (4*i+1) << 8
+               | (4*i+2) << 16
+               | (4*i+3) << 24;
+        a8[i] = SkTo<uint8_t>(4*i+3);
+    }
+
+    for (int width = 1; width <= 64; width++) {
+        uint32_t dst[64];
+        uint8_t  dstA8[64];
+        memset(dst,   0xaa, sizeof(dst));
+        memset(dstA8, 0xaa, sizeof(dstA8));
+
+        SkRasterPipeline_MemoryCtx srcCtx   = { src,   0 },
+                                   dstCtx   = { dst,   0 },
+                                   a8Ctx    = { a8,    0 },
+                                   dstA8Ctx = { dstA8, 0 };
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_8888,  &srcCtx);
+        p.append(SkRasterPipeline::swap_rb);
+        p.append(SkRasterPipeline::store_8888, &dstCtx);
+        p.append(SkRasterPipeline::load_a8,    &a8Ctx);
+        p.append(SkRasterPipeline::store_a8,   &dstA8Ctx);
+        p.run(0,0,width,1);
+
+        for (int i = 0; i < 64; i++) {
+            uint32_t want = i < width ? (4*i+0) << 16
+                                      | (4*i+1) << 8
+                                      | (4*i+2) << 0
+                                      | (4*i+3) << 24
+                                      : 0xaaaaaaaa;
+            uint8_t wantA8 = i < width ? a8[i] : 0xaa;
+            if (dst[i] != want || dstA8[i] != wantA8) {
+                ERRORF(r, "width %d, pixel %d: got %08x/%02x, want %08x/%02x\n",
+                       width, i, dst[i], dstA8[i], want, wantA8);
+            }
+        }
+    }
+}
+
 DEF_TEST(SkRasterPipeline_swizzle, r) {
     // This takes the lowp code path
     {
@@ -7,11 +7,13 @@
 
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkBlendMode.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkCapabilities.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
@@ -31,14 +33,17 @@
 #include "include/effects/SkRuntimeEffect.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkSLSampleUsage.h"
 #include "include/private/SkSLString.h"
 #include "include/private/SkTArray.h"
 #include "include/sksl/SkSLDebugTrace.h"
 #include "include/sksl/SkSLVersion.h"
 #include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkOSFile.h"
 #include "src/core/SkRuntimeEffectPriv.h"
 #include "src/core/SkTLazy.h"
+#include "src/core/SkVM.h"
 #include "src/gpu/KeyBuilder.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrColor.h"
@@ -48,17 +53,22 @@
 #include "src/gpu/ganesh/GrPixmap.h"
 #include "src/gpu/ganesh/SurfaceFillContext.h"
 #include "src/gpu/ganesh/effects/GrSkSLFP.h"
+#include "src/utils/SkOSPath.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
+#include "tools/Resources.h"
 
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 class GrRecordingContext;
 struct GrContextOptions;
@@ -1578,3 +1588,319 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrSkSLFP_UniformArray,
         }
     }
 }
+
+DEF_TEST(SkRuntimeEffectPersistentCache, r) {
+    // The cache is used by every runtime effect, including those drawn by tests running on other
+    // threads while it's set. So it must be thread-safe, it must never go away, and we may only
+    // look at the entry for this test's effect.
+    class MemoryCache : public SkRuntimeEffect::PersistentCache {
+    public:
+        sk_sp<SkData> load(const SkData& key) override {
+            SkAutoMutexExclusive lock(fMutex);
+            auto iter = fEntries.find(std::string((const char*)key.data(), key.size()));
+            if (iter == fEntries.end()) {
+                return nullptr;
+            }
+            ++fHits[iter->first];
+            return iter->second;
+        }
+        void store(const SkData& key, const SkData& data) override {
+            SkAutoMutexExclusive lock(fMutex);
+            fEntries[std::string((const char*)key.data(), key.size())] =
+                    SkData::MakeWithCopy(data.data(), data.size());
+        }
+
+        // Each effect's key contains its source.
+        std::string findKey(const char source[]) {
+            SkAutoMutexExclusive lock(fMutex);
+            for (const auto& [key, data] : fEntries) {
+                if (key.find(source) != std::string::npos) {
+                    return key;
+                }
+            }
+            return {};
+        }
+        int hits(const std::string& key) {
+            SkAutoMutexExclusive lock(fMutex);
+            return fHits[key];
+        }
+        sk_sp<SkData> get(const std::string& key) {
+            SkAutoMutexExclusive lock(fMutex);
+            return fEntries[key];
+        }
+        void set(const std::string& key, sk_sp<SkData> data) {
+            SkAutoMutexExclusive lock(fMutex);
+            fEntries[key] = std::move(data);
+        }
+
+    private:
+        SkMutex fMutex;
+        std::map<std::string, sk_sp<SkData>> fEntries;
+        std::map<std::string, int> fHits;
+    };
+
+    // Exercises every kind of child call and color transform that cached code has to replay.
+    static constexpr char kSource[] = R"(
+        uniform shader child;
+        uniform colorFilter filter;
+        uniform blender blend;
+        uniform half4 color;
+        half4 main(float2 xy) {
+            half4 c = filter.eval(child.eval(xy.yx + 0.5) * color);
+            c = blend.eval(c, half4(toLinearSrgb(c.rgb), 1));
+            return half4(fromLinearSrgb(c.bgr), c.a);
+        }
+    )";
+
+    // Draws with a new effect each time, as a new process would.
+    auto draw = [&](SkBitmap* bitmap) {
+        auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(kSource));
+        REPORTER_ASSERT(r, effect, "%s", error.c_str());
+
+        const SkPoint pts[] = {{0, 0}, {8, 8}};
+        const SkColor colors[] = {SK_ColorRED, SK_ColorCYAN};
+        SkRuntimeShaderBuilder builder(effect);
+        builder.child("child") = SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                              SkTileMode::kClamp);
+        builder.child("filter") = SkColorFilters::Blend(SK_ColorBLUE, SkBlendMode::kScreen);
+        builder.child("blend") = SkBlender::Mode(SkBlendMode::kMultiply);
+        builder.uniform("color") = SkV4{1, 0.5f, 0.25f, 1};
+
+        // Color transforms are no-ops without a color space.
+        auto cs = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, SkNamedGamut::kDisplayP3);
+        bitmap->allocPixels(SkImageInfo::Make(8, 8, kRGBA_8888_SkColorType,
+                                              kPremul_SkAlphaType, std::move(cs)));
+        SkPaint paint;
+        paint.setShader(builder.makeShader());
+        SkCanvas(*bitmap).drawPaint(paint);
+    };
+    auto same = [](const SkBitmap& a, const SkBitmap& b) {
+        return 0 == memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+    };
+
+    SkBitmap expected, actual;
+    draw(&expected);
+
+    // Another thread may still be using the cache after we unset it, so it's never deleted.
+    static MemoryCache* cache = new MemoryCache;
+    SkRuntimeEffect::SetPersistentCache(cache);
+
+    // The first draw fills the cache, and later draws load from it.
+    draw(&actual);
+    REPORTER_ASSERT(r, same(expected, actual));
+    const std::string key = cache->findKey(kSource);
+    REPORTER_ASSERT(r, !key.empty());
+    const int hits = cache->hits(key);
+
+    draw(&actual);
+    REPORTER_ASSERT(r, same(expected, actual));
+    REPORTER_ASSERT(r, cache->hits(key) == hits + 1);
+
+    // Damaged entries are ignored (and replaced).
+    const sk_sp<SkData> good = cache->get(key);
+    cache->set(key, SkData::MakeSubset(good.get(), 0, good->size() / 2));
+    draw(&actual);
+    REPORTER_ASSERT(r, same(expected, actual));
+    REPORTER_ASSERT(r, cache->hits(key) == hits + 2);
+    REPORTER_ASSERT(r, cache->get(key)->equals(good.get()));
+
+    draw(&actual);
+    REPORTER_ASSERT(r, same(expected, actual));
+    REPORTER_ASSERT(r, cache->hits(key) == hits + 3);
+
+    // Entries come from disk, so anything could be in them. Whatever we change, the effect must
+    // either reject the entry or replay it without crashing. Instructions are eight ints each
+    // (op, x, y, z, w, immA, immB, immC), following a 14-byte header and their count.
+    static constexpr size_t kInstructions = 18;
+    uint32_t count;
+    memcpy(&count, good->bytes() + kInstructions - 4, 4);
+    REPORTER_ASSERT(r, kInstructions + 32 * count < good->size());
+
+    auto corrupt = [&](size_t offset, int32_t value) {
+        sk_sp<SkData> bad = SkData::MakeWithCopy(good->data(), good->size());
+        memcpy((char*)bad->writable_data() + offset, &value, 4);
+        cache->set(key, std::move(bad));
+        draw(&actual);
+    };
+    for (uint32_t i = 0; i < count; ++i) {
+        for (int field = 0; field < 8; ++field) {
+            // NA, a forward reference, and (for the op) whatever op has that number.
+            corrupt(kInstructions + 32 * i + 4 * field, -1);
+            corrupt(kInstructions + 32 * i + 4 * field, (int32_t)i);
+        }
+    }
+    for (size_t size : {kInstructions, kInstructions + 32 * count, good->size() - 4}) {
+        cache->set(key, SkData::MakeSubset(good.get(), 0, size));
+        draw(&actual);
+        REPORTER_ASSERT(r, same(expected, actual));
+    }
+
+    // A binary op missing an operand used to make it all the way to the builder.
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint8_t* inst = good->bytes() + kInstructions + 32 * i;
+        int32_t op;
+        memcpy(&op, inst, 4);
+        if (op == (int)skvm::Op::add_f32) {
+            corrupt(kInstructions + 32 * i + 8, skvm::NA);
+            REPORTER_ASSERT(r, same(expected, actual));
+            REPORTER_ASSERT(r, cache->get(key)->equals(good.get()));
+            break;
+        }
+    }
+
+    SkRuntimeEffect::SetPersistentCache(nullptr);
+
+    // A directory cache's entries outlive it.
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (!tmpDir.isEmpty()) {
+        SkString dir = SkOSPath::Join(tmpDir.c_str(), "SkRuntimeEffectPersistentCache");
+        sk_sp<SkData> key = SkData::MakeWithCString("key"),
+                      data = SkData::MakeWithCString("data");
+        SkRuntimeEffect::MakeDirectoryCache(dir.c_str())->store(*key, *data);
+
+        auto dirCache = SkRuntimeEffect::MakeDirectoryCache(dir.c_str());
+        sk_sp<SkData> loaded = dirCache->load(*key);
+        REPORTER_ASSERT(r, loaded && loaded->equals(data.get()));
+        REPORTER_ASSERT(r, !dirCache->load(*data));
+    }
+}
+
+DEF_TEST(SkRuntimeEffectVMTemplates, r) {
+    // The CPU backend replays an effect's SkVMTemplate instead of calling ProgramToSkVM(). Draw
+    // every runtime effect in our test files both ways, and require the same pixels.
+    const struct {
+        const char* fSuffix;
+        SkRuntimeEffect::Result (*fMake)(SkString, const SkRuntimeEffect::Options&);
+        SkRuntimeEffect::ChildType fType;
+    } kKinds[] = {
+        {".rts",  SkRuntimeEffect::MakeForShader,      SkRuntimeEffect::ChildType::kShader},
+        {".rtcf", SkRuntimeEffect::MakeForColorFilter, SkRuntimeEffect::ChildType::kColorFilter},
+        {".rtb",  SkRuntimeEffect::MakeForBlender,     SkRuntimeEffect::ChildType::kBlender},
+    };
+
+    // The same inputs as SkSLTest.
+    const struct {
+        const char*        fName;
+        std::vector<float> fValues;
+    } kTestInputs[] = {
+        {"colorBlack",    {0, 0, 0, 1}},
+        {"colorRed",      {1, 0, 0, 1}},
+        {"colorGreen",    {0, 1, 0, 1}},
+        {"colorBlue",     {0, 0, 1, 1}},
+        {"colorWhite",    {1, 1, 1, 1}},
+        {"testInputs",    {-1.25, 0, 0.75, 2.25}},
+        {"unknownInput",  {1}},
+        {"testMatrix2x2", {1, 2, 3, 4}},
+        {"testMatrix3x3", {1, 2, 3, 4, 5, 6, 7, 8, 9}},
+        {"testMatrix4x4", {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}},
+        {"testArray",     {1, 2, 3, 4, 5}},
+    };
+
+    // Not symmetric, so that swapped coordinates show.
+    const SkPoint pts[] = {{0, 0}, {16, 5}};
+    const SkColor colors[] = {0xFF2080F0, 0x80F04020};
+    const sk_sp<SkShader> gradient = SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                                  SkTileMode::kClamp);
+
+    // A wide-gamut destination, so that toLinearSrgb() and fromLinearSrgb() do something.
+    auto surface = SkSurface::MakeRaster(SkImageInfo::Make(
+            16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType,
+            SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, SkNamedGamut::kDisplayP3)));
+
+    int childEffects = 0;
+    const SkString dir = GetResourcePath("sksl/runtime");
+    for (const auto& kind : kKinds) {
+        int effects = 0;
+        SkOSFile::Iter iter(dir.c_str(), kind.fSuffix);
+        for (SkString name; iter.next(&name); ) {
+            sk_sp<SkData> source = GetResourceAsData(SkStringPrintf("sksl/runtime/%s",
+                                                                    name.c_str()).c_str());
+            REPORTER_ASSERT(r, source, "%s", name.c_str());
+            if (!source) {
+                continue;
+            }
+            auto [effect, error] = kind.fMake(SkString((const char*)source->data(),
+                                                       source->size()),
+                                              SkRuntimeEffectPriv::ES3Options());
+            if (!effect) {
+                continue;
+            }
+            ++effects;
+
+            // Distinct, modest values: small ints, since some effects loop over them. Then the
+            // inputs the SkSL tests expect, so that they take their passing (green) paths.
+            sk_sp<SkData> uniforms = SkData::MakeZeroInitialized(effect->uniformSize());
+            for (const auto& u : effect->uniforms()) {
+                const bool isInt = u.type >= SkRuntimeEffect::Uniform::Type::kInt;
+                auto slots = (char*)uniforms->writable_data() + u.offset;
+                for (size_t i = 0; i < u.sizeInBytes() / 4; ++i) {
+                    if (isInt) {
+                        const int32_t v = i % 3 + 1;
+                        memcpy(slots + 4 * i, &v, 4);
+                    } else {
+                        const float v = (i % 7 + 1) * 0.125f;
+                        memcpy(slots + 4 * i, &v, 4);
+                    }
+                }
+            }
+            for (const auto& input : kTestInputs) {
+                const SkRuntimeEffect::Uniform* u = effect->findUniform(input.fName);
+                if (u && u->sizeInBytes() == input.fValues.size() * sizeof(float)) {
+                    memcpy((char*)uniforms->writable_data() + u->offset, input.fValues.data(),
+                           u->sizeInBytes());
+                }
+            }
+
+            std::vector<SkRuntimeEffect::ChildPtr> children;
+            for (const auto& child : effect->children()) {
+                switch (child.type) {
+                    case SkRuntimeEffect::ChildType::kShader:
+                        children.emplace_back(gradient);
+                        break;
+                    case SkRuntimeEffect::ChildType::kColorFilter:
+                        children.emplace_back(SkColorFilters::Blend(0xFF40C080,
+                                                                    SkBlendMode::kScreen));
+                        break;
+                    case SkRuntimeEffect::ChildType::kBlender:
+                        children.emplace_back(SkBlender::Mode(SkBlendMode::kMultiply));
+                        break;
+                }
+            }
+            childEffects += !children.empty();
+
+            auto draw = [&](bool templates, SkBitmap* bitmap) {
+                const bool wasEnabled = SkRuntimeEffectPriv::SetVMTemplatesForTesting(templates);
+                SkCanvas* canvas = surface->getCanvas();
+                canvas->clear(0xFF806040);
+                SkPaint paint;
+                switch (kind.fType) {
+                    case SkRuntimeEffect::ChildType::kShader:
+                        paint.setShader(effect->makeShader(uniforms, SkSpan(children)));
+                        break;
+                    case SkRuntimeEffect::ChildType::kColorFilter:
+                        paint.setShader(gradient);
+                        paint.setColorFilter(effect->makeColorFilter(uniforms,
+                                                                     SkSpan(children)));
+                        break;
+                    case SkRuntimeEffect::ChildType::kBlender:
+                        paint.setShader(gradient);
+                        paint.setBlender(effect->makeBlender(uniforms, SkSpan(children)));
+                        break;
+                }
+                canvas->drawPaint(paint);
+                bitmap->allocPixels(surface->imageInfo());
+                surface->readPixels(*bitmap, 0, 0);
+                SkRuntimeEffectPriv::SetVMTemplatesForTesting(wasEnabled);
+            };
+
+            SkBitmap converted, replayed;
+            draw(false, &converted);
+            draw(true, &replayed);
+            REPORTER_ASSERT(r, !memcmp(converted.getPixels(), replayed.getPixels(),
+                                       converted.computeByteSize()),
+                            "%s", name.c_str());
+        }
+        REPORTER_ASSERT(r, effects > 0, "no %s effects", kind.fSuffix);
+    }
+    REPORTER_ASSERT(r, childEffects > 0);
+}
@@ -59,3 +59,67 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
 
 
 }
+
+DEF_TEST(SkStrikeCache_ManyStrikes, Reporter) {
+    SkStrikeCache cache;
+
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::create_portable_typeface("serif", SkFontStyle::Italic());
+
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setTypeface(typeface);
+
+    // Distinct sizes give distinct descriptors, which spread across the cache's shards.
+    constexpr int kStrikeCount = 64;
+    for (int i = 0; i < kStrikeCount; ++i) {
+        font.setSize(SkIntToScalar(8 + i));
+        SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        REPORTER_ASSERT(Reporter, strike != nullptr);
+    }
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == kStrikeCount);
+
+    size_t used = cache.getTotalMemoryUsed();
+    REPORTER_ASSERT(Reporter, used > 0);
+
+    // Shrinking the count budget brings the whole cache back under it.
+    cache.setCacheCountLimit(8);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() <= 8);
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() < used);
+
+    cache.purgeAll();
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+}
+
+DEF_TEST(SkStrikeCache_SmallCountLimit, Reporter) {
+    SkStrikeCache cache;
+    // Fewer strikes than the cache has shards.
+    cache.setCacheCountLimit(2);
+
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::create_portable_typeface("serif", SkFontStyle::Italic());
+
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setTypeface(typeface);
+
+    for (int i = 0; i < 32; ++i) {
+        font.setSize(SkIntToScalar(8 + i));
+        SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        REPORTER_ASSERT(Reporter, strike != nullptr);
+
+        // The strike just created stays cached, even though the budget is tight.
+        REPORTER_ASSERT(Reporter, cache.findStrike(strikeSpec.descriptor()) == strike);
+        REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() >= 1);
+    }
+
+    cache.setCacheCountLimit(0);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+}
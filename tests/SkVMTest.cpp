@@ -5,8 +5,11 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSpan.h"
@@ -14,8 +17,11 @@
 #include "include/core/SkTypes.h"
 #include "include/private/SkFloatingPoint.h"
 #include "include/private/SkSLProgramKind.h"
+#include "src/core/SkArenaAlloc.h"
 #include "src/core/SkMSAN.h"
+#include "src/core/SkMatrixProvider.h"
 #include "src/core/SkVM.h"
+#include "src/core/SkVMBlitter.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/SkSLUtil.h"
@@ -2902,3 +2908,36 @@ DEF_TEST(SkVM_Visualizer, r) {
                        "<tr class='source'><td class='mask'>&#8617;v9</td>"
                        "<td colspan=2>int main(int x, int y)</td></tr>"));
 }
+
+DEF_TEST(SkVM_BlitterProgramCache, r) {
+    uint32_t pixels[16] = {};
+    SkPixmap dst(SkImageInfo::Make(16, 1, kRGBA_8888_SkColorType, kPremul_SkAlphaType),
+                 pixels, sizeof(pixels));
+    SkPaint paint;
+    paint.setColor(0x80336699);
+    SkMatrixProvider matrices(SkMatrix::I());
+
+    // The counts are per-thread, so other tests blitting on other threads don't disturb them.
+    auto blit = [&] {
+        SkSTArenaAlloc<2048> alloc;
+        SkVMBlitter::ResetProgramCacheStats();
+        if (SkVMBlitter* blitter = SkVMBlitter::Make(dst, paint, matrices, &alloc, nullptr)) {
+            static_cast<SkBlitter*>(blitter)->blitH(0, 0, 16);
+        }
+        auto stats = SkVMBlitter::GetProgramCacheStats();
+        REPORTER_ASSERT(r, stats.hits + stats.misses == 1);
+        REPORTER_ASSERT(r, stats.withoutJIT <= stats.misses);
+        return stats;
+    };
+
+    blit();
+    auto stats = blit();
+#if defined(SKVM_JIT)
+    // The first blit's program is now sitting in this thread's cache.
+    REPORTER_ASSERT(r, stats.hits == 1);
+#else
+    // There's no cache without a JIT.
+    REPORTER_ASSERT(r, stats.misses == 1 && stats.withoutJIT == 1);
+#endif
+    REPORTER_ASSERT(r, pixels[0] != 0);
+}
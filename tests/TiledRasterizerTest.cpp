@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlurTypes.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMaskFilter.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/effects/SkImageFilters.h"
+#include "include/utils/SkRandom.h"
+#include "include/utils/SkTiledRasterizer.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+// Draws a little of everything, deliberately straddling tile boundaries.
+static void draw_scene(SkCanvas* canvas, int w, int h) {
+    SkRandom rand;
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 50; i++) {
+        SkPath path;
+        path.moveTo(rand.nextRangeF(0, w), rand.nextRangeF(0, h));
+        for (int j = 0; j < 3; j++) {
+            path.quadTo(rand.nextRangeF(0, w), rand.nextRangeF(0, h),
+                        rand.nextRangeF(0, w), rand.nextRangeF(0, h));
+        }
+        paint.setColor(rand.nextU() | 0x40000000);
+        paint.setStyle(i % 2 ? SkPaint::kFill_Style : SkPaint::kStroke_Style);
+        paint.setStrokeWidth(rand.nextRangeF(1, 6));
+        canvas->drawPath(path, paint);
+    }
+
+    SkPoint pts[] = {{0, 0}, {(float)w, (float)h}};
+    SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    paint.reset();
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+    paint.setDither(true);
+    canvas->save();
+        canvas->rotate(15);
+        canvas->drawRect(SkRect::MakeXYWH(w * 0.2f, h * 0.1f, w * 0.5f, h * 0.3f), paint);
+    canvas->restore();
+
+    paint.reset();
+    paint.setAntiAlias(true);
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 6));
+    canvas->drawCircle(w * 0.5f, h * 0.5f, w * 0.2f, paint);
+
+    paint.reset();
+    paint.setAlphaf(0.5f);
+    canvas->saveLayer(nullptr, &paint);
+        canvas->clipRect(SkRect::MakeXYWH(w * 0.3f, h * 0.3f, w * 0.4f, h * 0.4f), true);
+        SkPaint fill;
+        fill.setColor(SK_ColorGREEN);
+        canvas->drawOval(SkRect::MakeWH(w, h), fill);
+    canvas->restore();
+
+    paint.reset();
+    paint.setImageFilter(SkImageFilters::Blur(4, 4, nullptr));
+    canvas->saveLayer(nullptr, &paint);
+        fill.setColor(SK_ColorMAGENTA);
+        canvas->drawRect(SkRect::MakeXYWH(w * 0.6f, h * 0.6f, w * 0.3f, h * 0.3f), fill);
+    canvas->restore();
+}
+
+DEF_TEST(TiledRasterizer_MatchesSerial, r) {
+    const int w = 300, h = 200;
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(w, h);
+
+    SkBitmap expected;
+    expected.allocPixels(info);
+    SkCanvas canvas(expected);
+    draw_scene(&canvas, w, h);
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkISize tileSize : {SkISize{64, 64}, SkISize{37, 111}, SkISize{3, 1000},
+                             SkISize{1000, 1000}}) {
+        SkBitmap actual;
+        actual.allocPixels(info);
+        SkTiledRasterizer tiled(actual.pixmap(), *executor, tileSize);
+        draw_scene(tiled.beginRecording(), w, h);
+        REPORTER_ASSERT(r, tiled.getRecordingCanvas());
+        tiled.flush();
+        REPORTER_ASSERT(r, !tiled.getRecordingCanvas());
+
+        bool match = true;
+        for (int y = 0; y < h && match; y++) {
+            match = 0 == memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y), w * 4);
+        }
+        REPORTER_ASSERT(r, match, "tile size %dx%d", tileSize.width(), tileSize.height());
+    }
+}
+
+DEF_TEST(TiledRasterizer_Backdrop, r) {
+    // A backdrop filter reads pixels from neighboring tiles, so this has to fall back to drawing
+    // serially, but should still match.
+    auto draw = [](SkCanvas* canvas) {
+        draw_scene(canvas, 100, 100);
+        auto backdrop = SkImageFilters::Blur(3, 3, nullptr);
+        SkRect bounds = SkRect::MakeXYWH(20, 20, 60, 60);
+        canvas->saveLayer(SkCanvas::SaveLayerRec(&bounds, nullptr, backdrop.get(), 0));
+        canvas->restore();
+    };
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+    SkBitmap expected, actual;
+    expected.allocPixels(info);
+    actual.allocPixels(info);
+
+    SkCanvas canvas(expected);
+    draw(&canvas);
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkTiledRasterizer tiled(actual.pixmap(), *executor, {16, 16});
+    draw(tiled.beginRecording());
+    tiled.flush();
+
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+}
@@ -84,6 +84,36 @@
     int64_t sk_tools::getCurrResidentSetSizeBytes() { return -1; }
 #endif
 
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)  // N.B. /proc is Linux-only.
+    #include <stdio.h>
+    bool sk_tools::resetPeakResidentSetSize() {
+        // Writing 5 to clear_refs resets VmHWM to the current RSS (Linux 4.0+).
+        FILE* clearRefs = fopen("/proc/self/clear_refs", "w");
+        if (!clearRefs) {
+            return false;
+        }
+        const bool ok = fputs("5", clearRefs) >= 0;
+        return (fclose(clearRefs) == 0) && ok;
+    }
+
+    int64_t sk_tools::getPeakResidentSetSizeBytes() {
+        long long hwmKB = -1;
+        if (FILE* status = fopen("/proc/self/status", "r")) {
+            char line[256];
+            while (fgets(line, sizeof(line), status)) {
+                if (sscanf(line, "VmHWM: %lld kB", &hwmKB) == 1) {
+                    break;
+                }
+            }
+            fclose(status);
+        }
+        return hwmKB < 0 ? -1 : hwmKB * 1024;
+    }
+#else
+    bool sk_tools::resetPeakResidentSetSize() { return false; }
+    int64_t sk_tools::getPeakResidentSetSizeBytes() { return -1; }
+#endif
+
 int sk_tools::getMaxResidentSetSizeMB() {
     int64_t bytes = sk_tools::getMaxResidentSetSizeBytes();
     return bytes < 0 ? -1 : static_cast<int>(bytes / 1024 / 1024);
@@ -40,6 +40,20 @@ int getMaxResidentSetSizeMB();
  */
 int getCurrResidentSetSizeMB();
 
+/**
+ *  If implemented, resets the peak resident set size reported by
+ *  getPeakResidentSetSizeBytes() to the current resident set size, and returns true.
+ *  If not, returns false.
+ */
+bool resetPeakResidentSetSize();
+
+/**
+ *  If implemented, returns the peak resident set size in bytes since the last
+ *  resetPeakResidentSetSize() (or since the process started).
+ *  If not, returns -1.
+ */
+int64_t getPeakResidentSetSizeBytes();
+
 }  // namespace sk_tools
 
 #endif  // ProcStats_DEFINED
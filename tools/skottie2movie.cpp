@@ -6,6 +6,7 @@
  */
 
 #include "experimental/ffmpeg/SkVideoEncoder.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkStream.h"
@@ -13,6 +14,7 @@
 #include "include/core/SkTime.h"
 #include "include/private/SkTPin.h"
 #include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
 #include "modules/skresources/include/SkResources.h"
 #include "src/utils/SkOSPath.h"
 
@@ -21,6 +23,8 @@
 
 #include "include/gpu/GrContextOptions.h"
 
+#include <vector>
+
 static DEFINE_string2(input, i, "", "skottie animation to render");
 static DEFINE_string2(output, o, "", "mp4 file to create");
 static DEFINE_string2(assetPath, a, "", "path to assets needed for json file");
@@ -29,6 +33,7 @@ static DEFINE_bool2(verbose, v, false, "verbose mode");
 static DEFINE_bool2(loop, l, false, "loop mode for profiling");
 static DEFINE_int(set_dst_width, 0, "set destination width (height will be computed)");
 static DEFINE_bool2(gpu, g, false, "use GPU for rendering");
+static DEFINE_int(threads, 0, "Number of raster worker threads (0 -> cores count).");
 
 static void produce_frame(SkSurface* surf, skottie::Animation* anim, double frame) {
     anim->seekFrame(frame);
@@ -47,7 +52,7 @@ int main(int argc, char** argv) {
     CommandLineFlags::SetUsage("Converts skottie to a mp4");
     CommandLineFlags::Parse(argc, argv);
 
-    if (FLAGS_input.count() == 0) {
+    if (FLAGS_input.size() == 0) {
         SkDebugf("-i input_file.json argument required\n");
         return -1;
     }
@@ -57,20 +62,28 @@ int main(int argc, char** argv) {
     sk_gpu_test::GrContextFactory factory(grCtxOptions);
 
     SkString assetPath;
-    if (FLAGS_assetPath.count() > 0) {
+    if (FLAGS_assetPath.size() > 0) {
         assetPath.set(FLAGS_assetPath[0]);
     } else {
         assetPath = SkOSPath::Dirname(FLAGS_input[0]);
     }
     SkDebugf("assetPath %s\n", assetPath.c_str());
 
-    auto animation = skottie::Animation::Builder()
-        .setResourceProvider(skresources::FileResourceProvider::Make(assetPath))
-        .makeFromFile(FLAGS_input[0]);
-    if (!animation) {
+    // Raster frames are rendered in parallel batches, each worker with its own animation
+    // instance.  GPU rendering stays on the main thread.
+    //
+    // Frames are the unit of parallelism on purpose.  Revalidating the scene graph is a tiny
+    // fraction of frame time, and rasterizing layers into separate offscreens would change how
+    // they blend and matte with each other.
+    auto renderer = skottie_utils::ParallelFrameRenderer::Make(
+            SkData::MakeFromFileName(FLAGS_input[0]),
+            skresources::FileResourceProvider::Make(assetPath),
+            FLAGS_gpu ? 1 : FLAGS_threads);
+    if (!renderer) {
         SkDebugf("failed to load %s\n", FLAGS_input[0]);
         return -1;
     }
+    const auto& animation = renderer->animation();
 
     SkISize dim = animation->size().toRound();
     double duration = animation->duration();
@@ -98,6 +111,8 @@ int main(int argc, char** argv) {
     sk_sp<SkData> data;
 
     const auto info = SkImageInfo::MakeN32Premul(dim);
+    std::vector<SkBitmap> batch_bitmaps;
+    std::vector<SkPixmap> batch;
     do {
         double loop_start = SkTime::GetSecs();
 
@@ -124,9 +139,31 @@ int main(int argc, char** argv) {
                 surf = SkSurface::MakeRaster(info);
             }
             surf->getCanvas()->scale(scale, scale);
+
+            if (!grctx && renderer->workers() > 1) {
+                // A few frames per worker, to keep all workers busy until the batch ends.
+                batch_bitmaps.resize(renderer->workers() * 4);
+                for (auto& bm : batch_bitmaps) {
+                    bm.allocPixels(info);
+                    batch.push_back(bm.pixmap());
+                }
+                if (FLAGS_verbose) {
+                    SkDebugf("rendering with %d raster workers\n", renderer->workers());
+                }
+            }
+        }
+
+        for (int i = 0; !batch.empty() && i <= frames; i += (int)batch.size()) {
+            const auto pixmaps = SkSpan(batch).first(std::min(batch.size(),
+                                                              (size_t)(frames + 1 - i)));
+            renderer->renderFrames(i * fps_scale, fps_scale, pixmaps);
+
+            for (const auto& pm : pixmaps) {
+                encoder.addFrame(pm);
+            }
         }
 
-        for (int i = 0; i <= frames; ++i) {
+        for (int i = 0; batch.empty() && i <= frames; ++i) {
             const double frame = i * fps_scale;
             if (FLAGS_verbose) {
                 SkDebugf("rendering frame %g\n", frame);
@@ -168,7 +205,7 @@ int main(int argc, char** argv) {
         }
     } while (FLAGS_loop);
 
-    if (FLAGS_output.count() == 0) {
+    if (FLAGS_output.size() == 0) {
         SkDebugf("missing -o output_file.mp4 argument\n");
         return 0;
     }
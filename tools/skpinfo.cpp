@@ -5,12 +5,15 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkTime.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkPictureData.h"
 #include "src/core/SkPicturePriv.h"
+#include "tools/ProcStats.h"
 #include "tools/flags/CommandLineFlags.h"
 
 static DEFINE_string2(input, i, "", "skp on which to report");
@@ -19,6 +22,9 @@ static DEFINE_bool2(cullRect, c, true, "cullRect");
 static DEFINE_bool2(flags, f, true, "flags");
 static DEFINE_bool2(tags, t, true, "tags");
 static DEFINE_bool2(quiet, q, false, "quiet");
+static DEFINE_bool2(load, l, false,
+                    "Compare the time and memory taken to load the skp by reading it into memory "
+                    "and by referencing a mapping of it in place.");
 
 // This tool can print simple information about an SKP but its main use
 // is just to check if an SKP has been truncated during the recording
@@ -31,6 +37,29 @@ static const int kInvalidTag = 3;
 static const int kMissingInput = 4;
 static const int kIOError = 5;
 
+// Loads the picture both ways, keeping both alive so the second doesn't reuse the first's memory.
+static int report_load(const char* path) {
+    auto load = [](const char* label, auto&& make) -> sk_sp<SkPicture> {
+        int64_t rss = sk_tools::getCurrResidentSetSizeBytes();
+        double start = SkTime::GetMSecs();
+        sk_sp<SkPicture> pic = make();
+        double ms = SkTime::GetMSecs() - start;
+        rss = sk_tools::getCurrResidentSetSizeBytes() - rss;
+        SkDebugf("%-7s %s: %.2f ms, RSS +%.1f MB\n",
+                 label, pic ? "loaded" : "FAILED", ms, rss / (1024.0 * 1024.0));
+        return pic;
+    };
+
+    sk_sp<SkPicture> copied = load("copied", [&] {
+        SkFILEStream stream(path);
+        return SkPicture::MakeFromStream(&stream);
+    });
+    sk_sp<SkPicture> mapped = load("mapped", [&] {
+        return SkPicture::MakeFromSharedData(SkData::MakeFromFileName(path));
+    });
+    return copied && mapped ? kSuccess : kIOError;
+}
+
 int main(int argc, char** argv) {
     CommandLineFlags::SetUsage("Prints information about an skp file");
     CommandLineFlags::Parse(argc, argv);
@@ -42,6 +71,10 @@ int main(int argc, char** argv) {
         return kMissingInput;
     }
 
+    if (FLAGS_load) {
+        return report_load(FLAGS_input[0]);
+    }
+
     SkFILEStream stream(FLAGS_input[0]);
     if (!stream.isValid()) {
         if (!FLAGS_quiet) {